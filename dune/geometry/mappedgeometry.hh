@@ -315,26 +315,31 @@ public:
     return geometry.refElement();
   }
 
-protected:
-  // the internal stored reference element
-  ReferenceElement refElement () const
+  /// \brief Obtain the mapping of the global coordinates of the wrapped geometry.
+  const Mapping& mapping () const
   {
-    return referenceElement(geometry_);
+    return *mapping_;
   }
 
-private:
-  // internal reference to the stored mapping
-  const Mapping& mapping () const
+  /// \brief Obtain the derivative of the mapping.
+  const DerivativeMapping& derivativeMapping () const
   {
-    return *mapping_;
+    return *dMapping_;
   }
 
-  // internal reference to the stored localgeometry
+  /// \brief Obtain the wrapped geometry.
   const Geometry& geometry () const
   {
     return geometry_;
   }
 
+protected:
+  // the internal stored reference element
+  ReferenceElement refElement () const
+  {
+    return referenceElement(geometry_);
+  }
+
 private:
   /// Parametrization of the element
   CopyableOptional<Mapping> mapping_;
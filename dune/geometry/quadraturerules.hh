@@ -7,9 +7,20 @@
 #define DUNE_GEOMETRY_QUADRATURERULES_HH
 
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -17,10 +28,13 @@
 #include <dune/common/exceptions.hh>
 #include <dune/common/stdstreams.hh>
 #include <dune/common/stdthread.hh>
+#include <dune/common/timer.hh>
 #include <dune/common/visibility.hh>
 
 #include <dune/geometry/type.hh>
 #include <dune/geometry/typeindex.hh>
+#include <dune/geometry/quadraturerules/lazytable.hh>
+#include <dune/geometry/quadraturerules/quadraturerulefilecache.hh>
 
 /**
    \file
@@ -54,6 +68,57 @@ namespace Dune {
    */
   class QuadratureOrderOutOfRange : public NotImplemented {};
 
+  namespace Impl {
+
+    //! throw QuadratureOrderOutOfRange, usable from the constexpr initialization of the rules
+    [[noreturn]] inline void throwQuadratureOrderOutOfRange (int p)
+    {
+      DUNE_THROW(QuadratureOrderOutOfRange, "Quadrature rule " << p << " not supported!");
+    }
+
+    //! number of corners of the reference element of the given topology
+    inline unsigned int numQuadratureCorners (unsigned int topologyId, int dim)
+    {
+      if (dim == 0)
+        return 1;
+      const unsigned int baseCorners = numQuadratureCorners(baseTopologyId(topologyId, dim), dim-1);
+      return isPrism(topologyId, dim) ? 2*baseCorners : baseCorners+1;
+    }
+
+    //! whether x lies in the reference element of the given topology, further than tolerance from its boundary
+    template<class ct, int cdim>
+    bool isInteriorQuadraturePoint (unsigned int topologyId, int dim, const FieldVector<ct,cdim>& x, ct tolerance, ct factor = ct(1))
+    {
+      if (dim == 0)
+        return true;
+      const ct baseFactor = isPrism(topologyId, dim) ? factor : factor - x[dim-1];
+      return x[dim-1] > tolerance && factor - x[dim-1] > tolerance
+             && isInteriorQuadraturePoint<ct,cdim>(baseTopologyId(topologyId, dim), dim-1, x, tolerance, baseFactor);
+    }
+
+    //! whether x is a corner of the reference element of the given topology, up to the tolerance
+    template<class ct, int cdim>
+    bool isCornerQuadraturePoint (unsigned int topologyId, int dim, const FieldVector<ct,cdim>& x, ct tolerance)
+    {
+      using std::abs;
+      if (dim == 0)
+        return true;
+      const unsigned int baseId = baseTopologyId(topologyId, dim);
+      if (abs(x[dim-1] - ct(1)) <= tolerance)
+      {
+        if (isPrism(topologyId, dim))
+          return isCornerQuadraturePoint<ct,cdim>(baseId, dim-1, x, tolerance);
+        // the apex of a pyramid
+        for (int i = 0; i < dim-1; ++i)
+          if (abs(x[i]) > tolerance)
+            return false;
+        return true;
+      }
+      return abs(x[dim-1]) <= tolerance && isCornerQuadraturePoint<ct,cdim>(baseId, dim-1, x, tolerance);
+    }
+
+  } // end namespace Impl
+
   /** \brief Single evaluation point in a quadrature rule
       \details A quadrature point is a single `(position, weight)` pair used to
       evaluate a function at a position with a relative weight.
@@ -134,6 +199,7 @@ namespace Dune {
       *  -1D: Gauss-Jacobi rule with parameters \f$\alpha = \beta =0 \f$, i.e. for integrals with a constant weight function.
       *       The quadrature points do not include interval endpoints.
       *       Polynomials of order 2n - 1 can be integrated exactly.
+      *       Beyond order 61 the rules are computed at run time by HighOrderGaussQuadratureRule.
       *  -higher dimension: For the 2D/3D case efficient rules for certain geometries may be used if available.
       *                     Higher dimensional quadrature rules are constructed via \p TensorProductQuadratureRule.
       *                     In this case the 1D rules eventually need higher order to compensate occurring weight functions(i.e. simplices).
@@ -172,6 +238,7 @@ namespace Dune {
        * 1D: Gauss-Lobatto rules for a constant weight function.
        * These are optimal rules under the constraint that both interval endpoints are quadrature points.
        * Polynomials of order 2n - 3 can be integrated exactly.
+       * Beyond order 31 the rules are computed at run time by HighOrderGaussQuadratureRule.
        */
       GaussLobatto = 4,
 
@@ -180,6 +247,7 @@ namespace Dune {
        * 1D: Gauss-Radau rules for a constant weight function.
        * These are optimal rules under the constraint that the left endpoint of the integration interval is a quadrature point.
        * Polynomials of order 2n - 2 can be integrated exactly.
+       * Beyond order 30 the rules are computed at run time by HighOrderGaussQuadratureRule.
        */
       GaussRadauLeft = 5,
 
@@ -189,8 +257,70 @@ namespace Dune {
        * These are optimal rules under the constraint that the right endpoint of the integration interval is a quadrature point.
        * Polynomials of order 2n - 2 can be integrated exactly.
        * The right Gauss-Radau rules are the just the mirrored left Gauss-Radau rules.
+       * Beyond order 30 the rules are computed at run time by HighOrderGaussQuadratureRule.
        */
       GaussRadauRight = 6,
+
+      /** \brief Gauss-Kronrod rules
+       *
+       * 1D: Kronrod extension of the n-point Gauss-Legendre rule by n+1 points.
+       * Polynomials of order 3n + 1 (3n + 2 for odd n) can be integrated exactly.
+       * The Gauss-Legendre rule is embedded, which gives an error estimate without
+       * additional function evaluations, see EmbeddedQuadratureRule.
+       * The rules are computed at run time.
+       */
+      GaussKronrod = 7,
+
+      /** \brief Gauss-Patterson rules
+       *
+       * 1D: Nested rules with 1, 3, 7, 15 and 31 points, each one the Kronrod
+       * extension of the previous one, starting from the midpoint rule.
+       * The rule with 2n + 1 points integrates polynomials of order 3n + 2 exactly.
+       * The rules are computed at run time.
+       */
+      GaussPatterson = 8,
+
+      /** \brief Clenshaw-Curtis rules
+       *
+       * 1D: Nested rules with the 1 and 2^l + 1 points cos(j pi / 2^l), including
+       * both interval endpoints. The rule with n points integrates polynomials of
+       * order n exactly.
+       * The rules are computed at run time.
+       */
+      ClenshawCurtis = 9,
+
+      /** \brief Smolyak sparse grids of Clenshaw-Curtis rules
+       *
+       * Cubes of dimension 2 and higher: Combination of tensor products of the
+       * nested ClenshawCurtis rules, whose number of points grows only
+       * polynomially in the dimension, see SparseGridQuadratureRule.
+       * Some of the weights are negative.
+       * 1D and other geometry types: Same as ClenshawCurtis, resp. its
+       * conical products.
+       */
+      SmolyakClenshawCurtis = 10,
+
+      /** \brief Smolyak sparse grids of Gauss-Patterson rules
+       *
+       * Same as SmolyakClenshawCurtis with the nested GaussPatterson rules,
+       * which reach a higher order with fewer points, up to the rule with 31 points.
+       */
+      SmolyakGaussPatterson = 11,
+
+      /** \brief Fully symmetric rules on cubes and prisms
+       *
+       * Quadrilaterals and hexahedra: Rules invariant under all symmetries of the
+       * cube, which integrate polynomials of total degree p exactly with fewer
+       * points than the GaussLegendre tensor product rules, see CubeQuadratureRule.
+       * Unlike those, they do not integrate all polynomials of degree p in each
+       * variable exactly.
+       * Prisms: Symmetric rules of total degree p with fewer points than the
+       * GaussLegendre product of the triangle and the line rule, see
+       * PrismQuadratureRule. Unlike that product, they do not integrate all
+       * products of polynomials of degree p on the triangle and on the line.
+       * Other geometry types and orders without such a rule: Same as GaussLegendre.
+       */
+      FullySymmetric = 12,
       size
     };
   }
@@ -220,6 +350,12 @@ namespace Dune {
      */
     QuadratureRule() : delivered_order(-1) {}
 
+    // the virtual destructor would suppress the implicit move operations
+    QuadratureRule(const QuadratureRule&) = default;
+    QuadratureRule(QuadratureRule&&) = default;
+    QuadratureRule& operator=(const QuadratureRule&) = default;
+    QuadratureRule& operator=(QuadratureRule&&) = default;
+
   protected:
     /** \brief Constructor for a given geometry type.  Leaves the quadrature order invalid  */
     QuadratureRule(GeometryType t) : geometry_type(t), delivered_order(-1) {}
@@ -249,10 +385,222 @@ namespace Dune {
     int delivered_order;
   };
 
+  /** \brief Stable 64-bit identity of the rule QuadratureRules<ctype,dim> returns for the given arguments
+      \details The identity depends only on the geometry type, the requested
+      order, the quadrature type and the number type, given by its size and
+      the number of digits of its mantissa. It neither depends on the address of
+      the rule nor on the process, so it can key tables of data tabulated at the
+      quadrature points, e.g. in a RuleTabulationCache, and be shared between
+      processes. Rules of different number types have different identities.
+      The identity is never 0.
+
+      The bits 0-19 hold the order, 20-27 the quadrature type, 28-43 the
+      topology id, 44-47 the dimension and 48-63 the number type. The lowest
+      bit of the topology id is cleared, it does not distinguish geometry types,
+      e.g., a line may have the topology id 0 or 1.
+      \ingroup Quadrature
+   */
+  template<typename ctype>
+  constexpr std::uint64_t quadratureRuleId (const GeometryType& t, int order, QuadratureType::Enum qt)
+  {
+    std::uint64_t digits = 0;
+    if constexpr (std::numeric_limits<ctype>::is_specialized)
+      digits = std::numeric_limits<ctype>::digits;
+    const std::uint64_t ctypeTag = ((std::uint64_t(sizeof(ctype)) & 0xff) << 8) | (digits & 0xff);
+    return (std::uint64_t(order) & 0xfffff)
+           | ((std::uint64_t(qt) & 0xff) << 20)
+           | ((std::uint64_t(t.id() & ~1u) & 0xffff) << 28)
+           | ((std::uint64_t(t.dim()) & 0xf) << 44)
+           | (ctypeTag << 48);
+  }
+
+  /** \brief Structure-of-arrays side copy of a QuadratureRule
+      \details The coordinates of the quadrature points are stored direction by
+      direction, followed by the weights, each in its own contiguous array. The
+      copy exists in addition to the points of the rule, which vectorized loops
+      over the coordinates can read without gathering them from the points. Every
+      array starts at an address aligned to #alignment bytes and is padded to
+      paddedSize() entries. The padding entries repeat the last quadrature point
+      with weight zero, such that vectorized loops may run over the padded range.
+
+      \code{.cpp}
+      const auto& soa = Dune::QuadratureRules<double,2>::soa(type, order);
+      for (std::size_t q = 0; q < soa.paddedSize(); ++q)
+        integral += f(soa.positions(0)[q], soa.positions(1)[q]) * soa.weights()[q];
+      \endcode
+      \ingroup Quadrature
+      \tparam ct Number type used for both coordinates and the weights
+      \tparam dim Dimension of the integration domain
+   */
+  template<typename ct, int dim>
+  class QuadratureRuleSoA
+  {
+  public:
+    /** \brief Alignment of each array in bytes */
+    constexpr static std::size_t alignment = 64;
+
+    /** \brief Copy the points and weights of the given rule */
+    explicit QuadratureRuleSoA (const QuadratureRule<ct,dim>& rule)
+      : size_(rule.size())
+    {
+      // pad to full cache lines if the number type fits into them
+      const std::size_t block = (alignment % sizeof(ct) == 0) ? alignment / sizeof(ct) : 1;
+      paddedSize_ = std::max<std::size_t>(block, (size_ + block - 1) / block * block);
+
+      data_.resize((dim+1)*paddedSize_ + alignment / sizeof(ct) + 1);
+      void* aligned = data_.data();
+      std::size_t space = data_.size() * sizeof(ct);
+      std::align(alignment, sizeof(ct), aligned, space);
+      offset_ = static_cast<ct*>(aligned) - data_.data();
+
+      ct* start = data_.data() + offset_;
+      for (std::size_t q = 0; q < paddedSize_; ++q)
+      {
+        const std::size_t src = std::min(q, size_ > 0 ? size_-1 : 0);
+        for (int i = 0; i < dim; ++i)
+          start[i*paddedSize_ + q] = size_ > 0 ? rule[src].position()[i] : ct(0);
+        start[dim*paddedSize_ + q] = q < size_ ? rule[q].weight() : ct(0);
+      }
+    }
+
+    /** \brief Number of quadrature points */
+    std::size_t size () const { return size_; }
+
+    /** \brief Length of each array, a multiple of the number of entries per #alignment bytes */
+    std::size_t paddedSize () const { return paddedSize_; }
+
+    /** \brief Contiguous array of the i-th coordinate of all quadrature points */
+    const ct* positions (int i) const
+    {
+      assert(0 <= i && i < dim);
+      return data() + i*paddedSize_;
+    }
+
+    /** \brief Contiguous array of all quadrature weights */
+    const ct* weights () const
+    {
+      return data() + dim*paddedSize_;
+    }
+
+    /** \brief Number of bytes allocated for the arrays */
+    std::size_t memory () const
+    {
+      return data_.capacity() * sizeof(ct);
+    }
+
+  private:
+    const ct* data () const
+    {
+      return data_.data() + offset_;
+    }
+
+    std::size_t size_;
+    std::size_t paddedSize_;
+    // the arrays start at offset_ in data_, which is aligned
+    std::size_t offset_ = 0;
+    std::vector<ct> data_;
+  };
+
   // Forward declaration of the factory class,
   // needed internally by the QuadratureRules container class.
   template<typename ctype, int dim> class QuadratureRuleFactory;
 
+  // Forward declaration of the 1d factors of product rules, which the cache keeps with a rule
+  template<class ctype, int dim> class TensorProductQuadratureFactors;
+
+  /** \brief Summary of the rules built by QuadratureRules::preload()
+      \ingroup Quadrature
+   */
+  struct QuadraturePreloadStatistics
+  {
+    //! number of rules built, rules that have been cached before are not counted
+    std::size_t rules = 0;
+    //! total number of quadrature points of the built rules
+    std::size_t points = 0;
+    //! number of bytes allocated for the built rules
+    std::size_t memory = 0;
+    //! wall-clock time of the preload in seconds
+    double time = 0.0;
+  };
+
+  /** \brief Requirements on the rule selected by QuadratureRules::cheapest()
+      \ingroup Quadrature
+   */
+  struct QuadratureConstraints
+  {
+    //! all quadrature weights are positive
+    bool positiveWeights = false;
+    //! no quadrature point lies on the boundary of the reference element
+    bool interiorPoints = false;
+    //! all corners of the reference element are quadrature points
+    bool includeVertices = false;
+    /** \brief the rule only has to integrate polynomials of total degree p exactly
+     *
+     * Admits the FullySymmetric rules on cubes and prisms and the Smolyak sparse
+     * grids, some of whose weights are negative. Without it, the rules on cubes
+     * and prisms integrate all polynomials of degree p in each variable, resp. all
+     * products of such polynomials on the triangle and the line, like GaussLegendre.
+     */
+    bool totalDegree = false;
+
+    //! bit mask of the constraints, used as key of the decision table
+    unsigned int key () const
+    {
+      return (positiveWeights ? 1u : 0u) | (interiorPoints ? 2u : 0u) | (includeVertices ? 4u : 0u)
+             | (totalDegree ? 8u : 0u);
+    }
+  };
+
+  /** \brief Default executor of QuadratureRules::preload()
+      \details Runs the tasks on a set of std::threads, each thread fetching the
+      next task that has not been started yet. The first exception thrown by a
+      task is rethrown once all threads have finished.
+      \ingroup Quadrature
+   */
+  class QuadraturePreloadExecutor
+  {
+  public:
+    /** \brief Use the given number of threads, 0 means std::thread::hardware_concurrency() */
+    explicit QuadraturePreloadExecutor (unsigned int numThreads = 0)
+      : numThreads_(numThreads > 0 ? numThreads : std::max(1u, std::thread::hardware_concurrency()))
+    {}
+
+    /** \brief Call task(i) for i = 0,...,n-1 and return when all calls have finished */
+    void operator() (std::size_t n, const std::function<void(std::size_t)>& task) const
+    {
+      std::atomic<std::size_t> next(0);
+      std::exception_ptr error;
+      std::mutex errorMutex;
+      auto work = [&]{
+        for (std::size_t i = next++; i < n; i = next++)
+        {
+          try {
+            task(i);
+          }
+          catch (...) {
+            std::lock_guard<std::mutex> guard(errorMutex);
+            if (!error)
+              error = std::current_exception();
+          }
+        }
+      };
+
+      std::vector<std::thread> threads;
+      const std::size_t numThreads = std::min<std::size_t>(numThreads_, n);
+      for (std::size_t t = 1; t < numThreads; ++t)
+        threads.emplace_back(work);
+      work();
+      for (auto& thread : threads)
+        thread.join();
+
+      if (error)
+        std::rethrow_exception(error);
+    }
+
+  private:
+    unsigned int numThreads_;
+  };
+
   /** \brief A container for all quadrature rules of dimension <tt>dim</tt>
       \ingroup Quadrature
    */
@@ -262,14 +610,98 @@ namespace Dune {
     /** \brief Internal short-hand notation for the type of quadrature rules this container contains */
     using QuadratureRule = Dune::QuadratureRule<ctype, dim>;
 
-    // indexed by quadrature order
-    using QuadratureOrderVector = std::vector<std::pair<std::once_flag, QuadratureRule> >;
+    /** \brief Cached rule together with its identity, its structure-of-arrays side copy and its 1d factors
+     *
+     * The side copy and the factors are built on their first request only,
+     * so rules that are only iterated over do not pay for them.
+     */
+    struct CacheEntry : public QuadratureRule
+    {
+      CacheEntry (QuadratureRule&& rule, std::uint64_t id, int p, QuadratureType::Enum qt)
+        : QuadratureRule(std::move(rule)), id(id), requestedOrder_(p), quadratureType_(qt)
+      {}
+
+      ~CacheEntry ()
+      {
+        delete soa_.load(std::memory_order_relaxed);
+        delete factors_;
+      }
+
+      //! the side copy, built on first access
+      const QuadratureRuleSoA<ctype, dim>& soa () const
+      {
+        if (const QuadratureRuleSoA<ctype, dim>* copy = soa_.load(std::memory_order_acquire))
+          return *copy;
+        std::call_once(soaFlag_, [&]{
+          soa_.store(new QuadratureRuleSoA<ctype, dim>(*this), std::memory_order_release);
+        });
+        return *soa_.load(std::memory_order_acquire);
+      }
+
+      //! the 1d factors if the rule is their product, set up on first access, otherwise nullptr
+      const TensorProductQuadratureFactors<ctype, dim>* factors () const
+      {
+        using Factors = TensorProductQuadratureFactors<ctype, dim>;
+        std::call_once(factorsFlag_, [&]{
+          if constexpr (dim > 0)
+          {
+            try {
+              Factors candidate(this->type(), requestedOrder_, quadratureType_);
+              // the symmetric rules of simplices, e.g., are no products of 1d rules
+              bool product = (candidate.size() == this->size());
+              std::size_t q = 0;
+              for (auto it = candidate.begin(); product && it != candidate.end(); ++it, ++q)
+                product = (it->position() == (*this)[q].position() && it->weight() == (*this)[q].weight());
+              if (product)
+                factors_ = new Factors(std::move(candidate));
+            }
+            catch (const QuadratureOrderOutOfRange&) {}
+          }
+        });
+        return factors_;
+      }
+
+      //! number of bytes allocated for the rule and its side copy, if it has been built
+      std::size_t memory () const
+      {
+        std::size_t bytes = sizeof(CacheEntry) + this->capacity() * sizeof(QuadraturePoint<ctype, dim>);
+        if (const QuadratureRuleSoA<ctype, dim>* copy = soa_.load(std::memory_order_acquire))
+          bytes += sizeof(QuadratureRuleSoA<ctype, dim>) + copy->memory();
+        return bytes;
+      }
+
+      std::uint64_t id;
+
+    private:
+      int requestedOrder_;
+      QuadratureType::Enum quadratureType_;
+      mutable std::atomic<const QuadratureRuleSoA<ctype, dim>*> soa_ = nullptr;
+      mutable std::once_flag soaFlag_;
+      // written once under factorsFlag_, read after std::call_once only
+      mutable const TensorProductQuadratureFactors<ctype, dim>* factors_ = nullptr;
+      mutable std::once_flag factorsFlag_;
+    };
+
+    //! the rules of one quadrature type and geometry type, indexed by the order
+    using Row = typename Impl::LazyTable<const CacheEntry*>::Row;
 
-    // indexed by geometry type
-    using GeometryTypeVector = std::vector<std::pair<std::once_flag, QuadratureOrderVector> >;
+    //! the cheapest quadrature types of one set of constraints and geometry type, indexed by the order
+    using DecisionRow = typename Impl::LazyTable<QuadratureType::Enum>::Row;
 
-    // indexed by quadrature type enum
-    using QuadratureCacheVector = std::vector<std::pair<std::once_flag, GeometryTypeVector> >;
+    //! number of geometry types of dimension dim, including the "none" type
+    static constexpr std::size_t numGeometryTypes = LocalGeometryTypeIndex::size(dim);
+
+    //! number of (quadrature type, geometry type) rows of the rule table
+    static constexpr std::size_t numRows = std::size_t(QuadratureType::size) * numGeometryTypes;
+
+    //! number of (constraints, geometry type) rows of the table of the cheapest quadrature types
+    static constexpr std::size_t numDecisionRows = 16 * numGeometryTypes;
+
+    //! index of the (quadrature type, geometry type) row in the rule table
+    static constexpr std::size_t rowIndex(QuadratureType::Enum qt, std::size_t typeIndex)
+    {
+      return std::size_t(qt) * numGeometryTypes + typeIndex;
+    }
 
     //! real rule creator
     DUNE_EXPORT const QuadratureRule& _rule(const GeometryType& t, int p, QuadratureType::Enum qt=QuadratureType::GaussLegendre) const
@@ -278,30 +710,129 @@ namespace Dune {
 
       DUNE_ASSERT_CALL_ONCE();
 
-      static QuadratureCacheVector quadratureCache(QuadratureType::size);
+      return lookup(LocalGeometryTypeIndex::index(t), t, p, qt);
+    }
 
-      auto& [ onceFlagQuadratureType, geometryTypes ] = quadratureCache[qt];
-      // initialize geometry types for this quadrature type once
-      std::call_once(onceFlagQuadratureType, [&types = geometryTypes]{
-        types = GeometryTypeVector(LocalGeometryTypeIndex::size(dim));
-      });
+    //! structure-of-arrays side copy of the rule created by _rule
+    DUNE_EXPORT const QuadratureRuleSoA<ctype, dim>& _soa(const GeometryType& t, int p, QuadratureType::Enum qt) const
+    {
+      assert(t.dim()==dim);
+      return lookup(LocalGeometryTypeIndex::index(t), t, p, qt).soa();
+    }
 
-      auto& [ onceFlagGeometryType, quadratureOrders ] = geometryTypes[LocalGeometryTypeIndex::index(t)];
-      // initialize quadrature orders for this geometry type and quadrature type once
-      std::call_once(onceFlagGeometryType, [&, &orders = quadratureOrders]{
-        // we only need one quadrature rule for points, not maxint
-        const auto numRules = dim == 0 ? 1 : QuadratureRuleFactory<ctype,dim>::maxOrder(t, qt)+1;
-        orders = QuadratureOrderVector(numRules);
+    /** \brief Return the rule from the table, creating it on first access
+     *
+     * The hit path consists of the acquire loads of the row and the rule
+     * pointer. Rows and rules are created on a miss only, guarded by a
+     * once_flag per row and per table entry.
+     */
+    const CacheEntry& lookup(std::size_t typeIndex, const GeometryType& t, int p, QuadratureType::Enum qt) const
+    {
+      const Row& row = ruleRow(typeIndex, t, qt);
+      const std::size_t order = entryIndex(row, t, p, qt);
+      if (const CacheEntry* rule = row.entries[order].load(std::memory_order_acquire))
+        return *rule;
+
+      create(row, order, t, p, qt);
+      return *row.entries[order].load(std::memory_order_acquire);
+    }
+
+    //! row of the rules of a quadrature type and geometry type, allocated on first access
+    const Row& ruleRow(std::size_t typeIndex, const GeometryType& t, QuadratureType::Enum qt) const
+    {
+      if (std::size_t(qt) >= std::size_t(QuadratureType::size))
+        outOfRange(t, 0, qt);
+      return rules_.row(rowIndex(qt, typeIndex), [&]{
+        std::size_t numRules = 0;
+        if (!t.isNone())
+          numRules = dim == 0 ? 1 : maxOrder(t, qt)+1;
+        return numRules;
       });
+    }
 
+    //! position of the rule in its row, throws if the rule is not available
+    static std::size_t entryIndex(const Row& row, const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
       // we only have one quadrature rule for points
-      auto& [ onceFlagQuadratureOrder, quadratureRule ] = quadratureOrders[dim == 0 ? 0 : p];
-      // initialize quadrature rule once
-      std::call_once(onceFlagQuadratureOrder, [&, &rule = quadratureRule]{
-        rule = QuadratureRuleFactory<ctype,dim>::rule(t, p, qt);
+      const std::size_t order = dim == 0 ? 0 : static_cast<std::size_t>(p);
+      if (p < 0 || order >= row.size)
+        outOfRange(t, p, qt);
+      return order;
+    }
+
+    //! initialize the rule of a table entry once, returns the rule if it has been created by this call
+    const CacheEntry* create(const Row& row, std::size_t order, const GeometryType& t, int p, QuadratureType::Enum qt) const
+    {
+      const CacheEntry* created = nullptr;
+      rules_.entry(row, order, [&]{
+        QuadratureRule rule = createRule(t, p, qt);
+        created = new CacheEntry(std::move(rule), quadratureRuleId<ctype>(t, dim == 0 ? 0 : p, qt), p, qt);
+        return created;
       });
+      return created;
+    }
+
+    //! create a rule by the factory, or take it from the file cache if one is enabled
+    static QuadratureRule createRule(const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      if constexpr (dim > 0 && std::numeric_limits<ctype>::is_specialized && std::is_trivially_copyable_v<ctype>)
+      {
+        if (const auto fileCache = QuadratureRuleFileCache::global())
+          return fileCachedRule(*fileCache, t, p, qt);
+      }
+      return QuadratureRuleFactory<ctype,dim>::rule(t, p, qt);
+    }
 
-      return quadratureRule;
+    //! load a rule from the file cache, the rule is created and appended to the file if it is missing
+    static QuadratureRule fileCachedRule(QuadratureRuleFileCache& fileCache, const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      const QuadratureRuleFileCache::Key key = {
+        sizeof(ctype), std::numeric_limits<ctype>::digits, dim, t.id() & ~1u, p, static_cast<std::int32_t>(qt)
+      };
+      constexpr std::size_t pointBytes = (dim+1) * sizeof(ctype);
+
+      std::vector<unsigned char> data;
+      int order = -1;
+      if (fileCache.load(key, order, data))
+      {
+        struct StoredRule : public QuadratureRule
+        {
+          StoredRule (const GeometryType& t, int order) : QuadratureRule(t, order) {}
+        };
+
+        StoredRule rule(t, order);
+        rule.reserve(data.size() / pointBytes);
+        for (std::size_t offset = 0; offset + pointBytes <= data.size(); offset += pointBytes)
+        {
+          typename QuadraturePoint<ctype,dim>::Vector position;
+          ctype weight;
+          for (int i = 0; i < dim; ++i)
+            std::memcpy(&position[i], data.data() + offset + i*sizeof(ctype), sizeof(ctype));
+          std::memcpy(&weight, data.data() + offset + dim*sizeof(ctype), sizeof(ctype));
+          rule.emplace_back(position, weight);
+        }
+        return rule;
+      }
+
+      QuadratureRule rule = QuadratureRuleFactory<ctype,dim>::rule(t, p, qt);
+      data.resize(rule.size() * pointBytes);
+      for (std::size_t q = 0; q < rule.size(); ++q)
+      {
+        for (int i = 0; i < dim; ++i)
+          std::memcpy(data.data() + q*pointBytes + i*sizeof(ctype), &rule[q].position()[i], sizeof(ctype));
+        std::memcpy(data.data() + q*pointBytes + dim*sizeof(ctype), &rule[q].weight(), sizeof(ctype));
+      }
+      fileCache.store(key, rule.order(), data);
+      return rule;
+    }
+
+    [[noreturn]] static void outOfRange(const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      if (t.isNone())
+        DUNE_THROW(Exception, "Unknown GeometryType");
+      DUNE_THROW(QuadratureOrderOutOfRange,
+                 "QuadratureRule for order " << p << ", GeometryType " << t
+                                             << " and QuadratureType " << qt << " not available");
     }
 
     //! singleton provider
@@ -311,9 +842,151 @@ namespace Dune {
       return instance;
     }
 
-    //! private constructor
-    QuadratureRules () = default;
+    /** \brief quadrature type of the cheapest rule, the decision is made on the first call only
+     *
+     * The decisions are kept in a table like the rules, such that later calls
+     * take two acquire loads.
+     */
+    QuadratureType::Enum cheapestType(const GeometryType& t, int p, const QuadratureConstraints& constraints) const
+    {
+      const std::size_t r = constraints.key() * numGeometryTypes + LocalGeometryTypeIndex::index(t);
+      const DecisionRow& row = cheapest_.row(r, [&]{
+        if (dim == 0)
+          return std::size_t(1);
+        std::size_t numOrders = 0;
+        for (const QuadratureType::Enum qt : cheapestCandidates)
+          if (admits(constraints, qt))
+            numOrders = std::max<std::size_t>(numOrders, maxOrder(t, qt)+1);
+        return numOrders;
+      });
+
+      const std::size_t order = dim == 0 ? 0 : static_cast<std::size_t>(p);
+      if (p < 0 || order >= row.size)
+        DUNE_THROW(QuadratureOrderOutOfRange,
+                   "No QuadratureRule for order " << p << " and GeometryType " << t << " meets the constraints");
+      return cheapest_.entry(row, order, [&]{
+        return decideCheapest(t, p, constraints);
+      });
+    }
+
+    // the Gauss-Jacobi rules with fixed exponent integrate against a weight function,
+    // the last three types are only admitted by QuadratureConstraints::totalDegree
+    static constexpr QuadratureType::Enum cheapestCandidates[] = {
+      QuadratureType::GaussLegendre, QuadratureType::GaussJacobi_n_0, QuadratureType::GaussLobatto,
+      QuadratureType::GaussRadauLeft, QuadratureType::GaussRadauRight, QuadratureType::GaussKronrod,
+      QuadratureType::GaussPatterson, QuadratureType::ClenshawCurtis,
+      QuadratureType::SmolyakClenshawCurtis, QuadratureType::SmolyakGaussPatterson,
+      QuadratureType::FullySymmetric
+    };
+
+    //! whether rules of the quadrature type are compared at all for the constraints
+    static bool admits(const QuadratureConstraints& constraints, QuadratureType::Enum qt)
+    {
+      return constraints.totalDegree
+             || (qt != QuadratureType::FullySymmetric && qt != QuadratureType::SmolyakClenshawCurtis
+                 && qt != QuadratureType::SmolyakGaussPatterson);
+    }
+
+    /** \brief Select the cheapest quadrature type meeting the constraints
+     *
+     * The candidates are ordered by their number of points, which is computed
+     * without creating the rules. Only if there are constraints, the rules are
+     * checked in this order until one meets them. Rules that are not cached yet
+     * are created for this check only and not stored.
+     */
+    QuadratureType::Enum decideCheapest(const GeometryType& t, int p, const QuadratureConstraints& constraints) const
+    {
+      const std::size_t typeIndex = LocalGeometryTypeIndex::index(t);
+      std::vector<std::pair<std::size_t, QuadratureType::Enum>> sizes;
+      for (const QuadratureType::Enum qt : cheapestCandidates)
+      {
+        if (!admits(constraints, qt) || (dim > 0 && static_cast<unsigned>(p) > maxOrder(t, qt)))
+          continue;
+        try {
+          sizes.emplace_back(size(t, p, qt), qt);
+        }
+        catch (const NotImplemented&) {
+          // e.g. GaussJacobi_n_0 rules of high order without LAPACK
+        }
+      }
+      // on ties the type listed first wins
+      std::stable_sort(sizes.begin(), sizes.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+      });
+
+      for (const auto& candidate : sizes)
+      {
+        const QuadratureType::Enum qt = candidate.second;
+        if (!constraints.positiveWeights && !constraints.interiorPoints && !constraints.includeVertices)
+          return qt;
+        try {
+          if (const CacheEntry* rule = find(typeIndex, t, p, qt))
+          {
+            if (satisfies(*rule, constraints))
+              return qt;
+          }
+          else if (satisfies(QuadratureRuleFactory<ctype,dim>::rule(t, p, qt), constraints))
+            return qt;
+        }
+        catch (const NotImplemented&) {}
+      }
+
+      DUNE_THROW(QuadratureOrderOutOfRange,
+                 "No QuadratureRule for order " << p << " and GeometryType " << t << " meets the constraints");
+    }
+
+    //! the rule if it is in the table already, otherwise nullptr
+    const CacheEntry* find(std::size_t typeIndex, const GeometryType& t, int p, QuadratureType::Enum qt) const
+    {
+      const Row& row = ruleRow(typeIndex, t, qt);
+      return row.entries[entryIndex(row, t, p, qt)].load(std::memory_order_acquire);
+    }
+
+    //! whether the rule meets the constraints
+    static bool satisfies(const QuadratureRule& quad, const QuadratureConstraints& constraints)
+    {
+      const unsigned int topologyId = quad.type().id();
+      const ctype tolerance = 16 * std::numeric_limits<ctype>::epsilon();
+      unsigned int numCorners = 0;
+      for (const auto& qp : quad)
+      {
+        if (constraints.positiveWeights && !(qp.weight() > 0))
+          return false;
+        if (constraints.interiorPoints && !Impl::isInteriorQuadraturePoint(topologyId, dim, qp.position(), tolerance))
+          return false;
+        if (constraints.includeVertices && Impl::isCornerQuadraturePoint(topologyId, dim, qp.position(), tolerance))
+          ++numCorners;
+      }
+      return !constraints.includeVertices || numCorners >= Impl::numQuadratureCorners(topologyId, dim);
+    }
+
+    //! private constructor, the rows of the tables are allocated on first access
+    QuadratureRules ()
+      : rules_(numRows, nullptr)
+      , cheapest_(numDecisionRows, QuadratureType::size)
+    {}
+
+    ~QuadratureRules ()
+    {
+      for (std::size_t r = 0; r < numRows; ++r)
+        if (const Row* row = rules_.find(r))
+          for (std::size_t i = 0; i < row->size; ++i)
+            if (const CacheEntry* rule = row->entries[i].load(std::memory_order_relaxed))
+              delete rule;
+    }
+
+    // indexed by (quadrature type, geometry type index), each row by the quadrature order;
+    // in high dimensions there are many geometry types, and rows for all of them
+    // and all orders would be large before any rule exists
+    Impl::LazyTable<const CacheEntry*> rules_;
+
+    // quadrature type of the cheapest rule, indexed by (constraints, geometry type index), each row by the order
+    Impl::LazyTable<QuadratureType::Enum> cheapest_;
+
   public:
+    QuadratureRules (const QuadratureRules&) = delete;
+    QuadratureRules& operator= (const QuadratureRules&) = delete;
+
     //! maximum quadrature order for given geometry type and quadrature type
     static unsigned
     maxOrder(const GeometryType& t,
@@ -322,6 +995,20 @@ namespace Dune {
       return QuadratureRuleFactory<ctype,dim>::maxOrder(t,qt);
     }
 
+    /** \brief number of points of the QuadratureRule for GeometryType t and order p
+     *
+     * The number is computed from the order, the tables and the factors of the
+     * product rules without creating any rule if the rule is not cached yet.
+     * \throws QuadratureOrderOutOfRange if the order is not available
+     */
+    static std::size_t size(const GeometryType& t, int p, QuadratureType::Enum qt=QuadratureType::GaussLegendre)
+    {
+      assert(t.dim()==dim);
+      if (const CacheEntry* rule = instance().find(LocalGeometryTypeIndex::index(t), t, p, qt))
+        return rule->size();
+      return QuadratureRuleFactory<ctype,dim>::size(t, p, qt);
+    }
+
     //! select the appropriate QuadratureRule for GeometryType t and order p
     static const QuadratureRule& rule(const GeometryType& t, int p, QuadratureType::Enum qt=QuadratureType::GaussLegendre)
     {
@@ -334,6 +1021,191 @@ namespace Dune {
       GeometryType gt(t,dim);
       return instance()._rule(gt,p,qt);
     }
+
+    /** \brief select the appropriate QuadratureRule for a GeometryType known at compile time
+     *
+     * The geometry type index is computed at compile time, such that the
+     * lookup reduces to a bounds check and a single load from the rule table.
+     * \code{.cpp}
+     * const auto& quad = QuadratureRules<double,2>::rule<GeometryTypes::triangle>(order);
+     * \endcode
+     */
+    template<GeometryType::Id geometryId>
+    static const QuadratureRule& rule(int p, QuadratureType::Enum qt=QuadratureType::GaussLegendre)
+    {
+      constexpr GeometryType t = geometryId;
+      static_assert(t.dim() == dim, "GeometryType does not match the dimension of the QuadratureRules");
+      constexpr std::size_t typeIndex = LocalGeometryTypeIndex::index(t);
+      return instance().lookup(typeIndex, t, p, qt);
+    }
+
+    /** \brief the QuadratureRule of order p with the fewest points among all quadrature types
+     *
+     * Only the quadrature types for a constant weight function are taken into
+     * account, i.e., all but GaussJacobi_1_0 and GaussJacobi_2_0. The FullySymmetric
+     * and Smolyak types, which are only exact for polynomials of total degree p on
+     * cubes and prisms and may have negative weights, are only taken into account
+     * if QuadratureConstraints::totalDegree is set. On ties the
+     * type listed first in QuadratureType::Enum wins. Which type is the
+     * cheapest is decided once for every geometry type, order and set of
+     * constraints; later calls only look up the decision.
+     * \code{.cpp}
+     * QuadratureConstraints constraints;
+     * constraints.positiveWeights = true;
+     * const auto& quad = QuadratureRules<double,3>::cheapest(GeometryTypes::hexahedron, 5, constraints);
+     * \endcode
+     *
+     * \throws QuadratureOrderOutOfRange if no rule of order p meets the constraints
+     */
+    static const QuadratureRule& cheapest(const GeometryType& t, int p, const QuadratureConstraints& constraints = {})
+    {
+      assert(t.dim()==dim);
+      return rule(t, p, instance().cheapestType(t, p, constraints));
+    }
+
+    /** \brief structure-of-arrays side copy of the QuadratureRule for GeometryType t and order p
+     *
+     * The copy is built once, on the first request for it, and lives as long
+     * as the rule. It takes memory in addition to the rule.
+     */
+    static const QuadratureRuleSoA<ctype, dim>& soa(const GeometryType& t, int p, QuadratureType::Enum qt=QuadratureType::GaussLegendre)
+    {
+      return instance()._soa(t,p,qt);
+    }
+
+    //! @copydoc soa
+    template<GeometryType::Id geometryId>
+    static const QuadratureRuleSoA<ctype, dim>& soa(int p, QuadratureType::Enum qt=QuadratureType::GaussLegendre)
+    {
+      constexpr GeometryType t = geometryId;
+      static_assert(t.dim() == dim, "GeometryType does not match the dimension of the QuadratureRules");
+      constexpr std::size_t typeIndex = LocalGeometryTypeIndex::index(t);
+      return instance().lookup(typeIndex, t, p, qt).soa();
+    }
+
+    /** \brief Build the rules for all combinations of geometry types, orders and quadrature types
+     *
+     * Rules are otherwise created on their first use, which can be expensive for
+     * large tensor-product rules or the GaussJacobi_n_0 rules computed by LAPACK.
+     * Calling preload() during the startup of an application builds them
+     * concurrently beforehand. Orders beyond maxOrder() are skipped and rules that
+     * are cached already are not built again.
+     * \code{.cpp}
+     * auto stats = QuadratureRules<double,3>::preload({GeometryTypes::tetrahedron, GeometryTypes::hexahedron}, {0, 20});
+     * std::cout << stats.rules << " rules using " << stats.memory << " bytes built in " << stats.time << "s" << std::endl;
+     * \endcode
+     *
+     * \param types           geometry types of dimension dim
+     * \param orderRange      first and last order (inclusive) to build
+     * \param quadratureTypes quadrature types to build
+     * \param executor        executor(n, task) has to call task(i) for i = 0,...,n-1, possibly
+     *                        concurrently, and return when all calls have finished
+     */
+    template<class Executor = QuadraturePreloadExecutor>
+    static QuadraturePreloadStatistics
+    preload(const std::vector<GeometryType>& types,
+            std::pair<int, int> orderRange,
+            const std::vector<QuadratureType::Enum>& quadratureTypes = {QuadratureType::GaussLegendre},
+            Executor&& executor = Executor())
+    {
+      Timer timer;
+      const QuadratureRules& rules = instance();
+
+      std::vector<std::tuple<const Row*, std::size_t, GeometryType, int, QuadratureType::Enum>> tasks;
+      for (const QuadratureType::Enum qt : quadratureTypes)
+        for (const GeometryType& t : types)
+        {
+          assert(t.dim()==dim);
+          // there is only one rule for points
+          const int firstOrder = std::max(orderRange.first, 0);
+          const int lastOrder = std::min(orderRange.second, dim == 0 ? firstOrder : int(maxOrder(t, qt)));
+          if (firstOrder > lastOrder)
+            continue;
+          const Row& row = rules.ruleRow(LocalGeometryTypeIndex::index(t), t, qt);
+          for (int p = firstOrder; p <= lastOrder; ++p)
+          {
+            const std::size_t order = entryIndex(row, t, p, qt);
+            if (!row.entries[order].load(std::memory_order_acquire))
+              tasks.emplace_back(&row, order, t, p, qt);
+          }
+        }
+
+      // start with the high orders, they usually take longest
+      std::stable_sort(tasks.begin(), tasks.end(), [](const auto& a, const auto& b) {
+        return std::get<3>(a) > std::get<3>(b);
+      });
+
+      std::atomic<std::size_t> numRules(0), numPoints(0), memory(0);
+      executor(tasks.size(), [&](std::size_t i) {
+        const auto& [row, order, t, p, qt] = tasks[i];
+        if (const CacheEntry* rule = rules.create(*row, order, t, p, qt))
+        {
+          ++numRules;
+          numPoints += rule->size();
+          memory += rule->memory();
+        }
+      });
+
+      QuadraturePreloadStatistics statistics;
+      statistics.rules = numRules;
+      statistics.points = numPoints;
+      statistics.memory = memory;
+      statistics.time = timer.elapsed();
+      return statistics;
+    }
+
+    /** \brief stable identity of a rule handed out by rule()
+     *
+     * The identity equals quadratureRuleId<ctype>(t, p, qt) for the arguments
+     * the rule has been requested with, where p is 0 for the rule on a point.
+     * \returns 0 if the rule has not been obtained from this container
+     */
+    static std::uint64_t id(const QuadratureRule& rule)
+    {
+      const CacheEntry* entry = dynamic_cast<const CacheEntry*>(&rule);
+      return entry ? entry->id : 0;
+    }
+
+    /** \brief 1d factors of the QuadratureRule for GeometryType t and order p
+     *
+     * Where the cached rule is a tensor or conical product of 1d rules in all
+     * directions, e.g., for the Gauss-Lobatto and Gauss-Radau types and for
+     * cubes, its TensorProductQuadratureFactors are set up on the first
+     * request and kept with the rule. They generate the points of the rule in
+     * the same order, which sum factorization can exploit.
+     * \code{.cpp}
+     * if (const auto* factors = QuadratureRules<double,3>::factors(GeometryTypes::hexahedron, 7))
+     *   for (int e = 0; e < 3; ++e)
+     *     lineRules[e] = &factors->lineRule(e);
+     * \endcode
+     *
+     * \returns nullptr if the cached rule is not such a product
+     */
+    static const TensorProductQuadratureFactors<ctype, dim>* factors(const GeometryType& t, int p, QuadratureType::Enum qt=QuadratureType::GaussLegendre)
+    {
+      assert(t.dim()==dim);
+      return instance().lookup(LocalGeometryTypeIndex::index(t), t, p, qt).factors();
+    }
+
+    /** \brief 1d factors of a rule handed out by rule(), see factors(t, p, qt)
+     *
+     * \returns nullptr if the rule has not been obtained from this container or is no product of 1d rules
+     */
+    static const TensorProductQuadratureFactors<ctype, dim>* factors(const QuadratureRule& rule)
+    {
+      const CacheEntry* entry = dynamic_cast<const CacheEntry*>(&rule);
+      return entry ? entry->factors() : nullptr;
+    }
+
+    /** \brief structure-of-arrays side copy of a rule handed out by rule(), built on first access
+     *
+     * \returns nullptr if the rule has not been obtained from this container
+     */
+    static const QuadratureRuleSoA<ctype, dim>* soa(const QuadratureRule& rule)
+    {
+      const CacheEntry* entry = dynamic_cast<const CacheEntry*>(&rule);
+      return entry ? &entry->soa() : nullptr;
+    }
   };
 
 } // end namespace Dune
@@ -347,13 +1219,19 @@ namespace Dune {
 #include "quadraturerules/gaussquadrature.hh"
 #include "quadraturerules/gaussradauleftquadrature.hh"
 #include "quadraturerules/gaussradaurightquadrature.hh"
+#include "quadraturerules/highordergaussquadrature.hh"
 #include "quadraturerules/jacobi1quadrature.hh"
 #include "quadraturerules/jacobi2quadrature.hh"
 #include "quadraturerules/jacobiNquadrature.hh"
+#include "quadraturerules/nestedquadrature.hh"
+// 2d and 3d rules
+#include "quadraturerules/cubequadrature.hh"
 // 3d rules
 #include "quadraturerules/prismquadrature.hh"
+#include "quadraturerules/pyramidquadrature.hh"
 // general rules
 #include "quadraturerules/simplexquadrature.hh"
+#include "quadraturerules/sparsegridquadrature.hh"
 #include "quadraturerules/tensorproductquadrature.hh"
 
 #undef DUNE_INCLUDING_IMPLEMENTATION
@@ -372,12 +1250,22 @@ namespace Dune {
     friend class QuadratureRules<ctype, dim>;
     static unsigned maxOrder(const GeometryType &t, QuadratureType::Enum qt)
     {
+      if (t.isCube() && Impl::isSmolyakQuadratureType(qt))
+        return SparseGridQuadratureRule<ctype,dim>::maxOrder(qt);
       return TensorProductQuadratureRule<ctype,dim>::maxOrder(t.id(), qt);
     }
     static QuadratureRule<ctype, dim> rule(const GeometryType& t, int p, QuadratureType::Enum qt)
     {
+      if (t.isCube() && Impl::isSmolyakQuadratureType(qt))
+        return SparseGridQuadratureRule<ctype,dim>(p, qt);
       return TensorProductQuadratureRule<ctype,dim>(t.id(), p, qt);
     }
+    static std::size_t size(const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      if (t.isCube() && Impl::isSmolyakQuadratureType(qt))
+        return SparseGridQuadratureRule<ctype,dim>::numPoints(p, qt);
+      return TensorProductQuadratureRule<ctype,dim>::numPoints(t.id(), p, qt);
+    }
   };
 
   template<typename ctype>
@@ -401,6 +1289,14 @@ namespace Dune {
       }
       DUNE_THROW(Exception, "Unknown GeometryType");
     }
+    static std::size_t size(const GeometryType& t, int , QuadratureType::Enum)
+    {
+      if (t.isVertex())
+      {
+        return 1;
+      }
+      DUNE_THROW(Exception, "Unknown GeometryType");
+    }
   };
 
   template<typename ctype>
@@ -414,19 +1310,24 @@ namespace Dune {
       {
         switch (qt) {
         case QuadratureType::GaussLegendre :
-          return GaussQuadratureRule1D<ctype>::highest_order;
+        case QuadratureType::FullySymmetric :
+        case QuadratureType::GaussLobatto :
+        case QuadratureType::GaussRadauLeft :
+        case QuadratureType::GaussRadauRight :
+          return HighOrderGaussQuadratureRule1D<ctype>::highest_order;
         case QuadratureType::GaussJacobi_1_0 :
           return Jacobi1QuadratureRule1D<ctype>::highest_order;
         case QuadratureType::GaussJacobi_2_0 :
           return Jacobi2QuadratureRule1D<ctype>::highest_order;
-        case QuadratureType::GaussLobatto :
-          return GaussLobattoQuadratureRule1D<ctype>::highest_order;
         case QuadratureType::GaussJacobi_n_0 :
           return JacobiNQuadratureRule1D<ctype>::maxOrder();
-        case QuadratureType::GaussRadauLeft :
-          return GaussRadauLeftQuadratureRule1D<ctype>::highest_order;
-        case QuadratureType::GaussRadauRight :
-          return GaussRadauRightQuadratureRule1D<ctype>::highest_order;
+        case QuadratureType::GaussKronrod :
+        case QuadratureType::GaussPatterson :
+        case QuadratureType::ClenshawCurtis :
+          return NestedQuadratureRule1D<ctype>::maxOrder(qt);
+        case QuadratureType::SmolyakClenshawCurtis :
+        case QuadratureType::SmolyakGaussPatterson :
+          return NestedQuadratureRule1D<ctype>::maxOrder(Impl::smolyakLineType(qt));
         default :
           DUNE_THROW(Exception, "Unknown QuadratureType");
         }
@@ -439,25 +1340,70 @@ namespace Dune {
       {
         switch (qt) {
         case QuadratureType::GaussLegendre :
+        case QuadratureType::FullySymmetric :
+          if (p > GaussQuadratureRule1D<ctype>::highest_order)
+            return HighOrderGaussQuadratureRule1D<ctype>(p, QuadratureType::GaussLegendre);
           return GaussQuadratureRule1D<ctype>(p);
         case QuadratureType::GaussJacobi_1_0 :
           return Jacobi1QuadratureRule1D<ctype>(p);
         case QuadratureType::GaussJacobi_2_0 :
           return Jacobi2QuadratureRule1D<ctype>(p);
         case QuadratureType::GaussLobatto :
+          if (p > GaussLobattoQuadratureRule1D<ctype>::highest_order)
+            return HighOrderGaussQuadratureRule1D<ctype>(p, qt);
           return GaussLobattoQuadratureRule1D<ctype>(p);
         case QuadratureType::GaussJacobi_n_0 :
           return JacobiNQuadratureRule1D<ctype>(p);
         case QuadratureType::GaussRadauLeft :
+          if (p > GaussRadauLeftQuadratureRule1D<ctype>::highest_order)
+            return HighOrderGaussQuadratureRule1D<ctype>(p, qt);
           return GaussRadauLeftQuadratureRule1D<ctype>(p);
         case QuadratureType::GaussRadauRight :
+          if (p > GaussRadauRightQuadratureRule1D<ctype>::highest_order)
+            return HighOrderGaussQuadratureRule1D<ctype>(p, qt);
           return GaussRadauRightQuadratureRule1D<ctype>(p);
+        case QuadratureType::GaussKronrod :
+        case QuadratureType::GaussPatterson :
+        case QuadratureType::ClenshawCurtis :
+          return NestedQuadratureRule1D<ctype>(p, qt);
+        case QuadratureType::SmolyakClenshawCurtis :
+        case QuadratureType::SmolyakGaussPatterson :
+          return NestedQuadratureRule1D<ctype>(p, Impl::smolyakLineType(qt));
         default :
           DUNE_THROW(Exception, "Unknown QuadratureType");
         }
       }
       DUNE_THROW(Exception, "Unknown GeometryType");
     }
+    // the number of points follows from the order, as in the construction of the rules
+    static std::size_t size(const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      if (p < 0 || static_cast<unsigned>(p) > maxOrder(t, qt))
+        DUNE_THROW(QuadratureOrderOutOfRange, "Quadrature rule " << p << " not supported!");
+      switch (qt) {
+      case QuadratureType::GaussLegendre :
+      case QuadratureType::FullySymmetric :
+      case QuadratureType::GaussJacobi_1_0 :
+      case QuadratureType::GaussJacobi_2_0 :
+        return p/2 + 1;
+      case QuadratureType::GaussJacobi_n_0 :
+        return JacobiNQuadratureRule1D<ctype>::numPoints(p);
+      case QuadratureType::GaussLobatto :
+        return p/2 + 2;
+      case QuadratureType::GaussRadauLeft :
+      case QuadratureType::GaussRadauRight :
+        return (p+1)/2 + 1;
+      case QuadratureType::GaussKronrod :
+      case QuadratureType::GaussPatterson :
+      case QuadratureType::ClenshawCurtis :
+        return Impl::nestedLineRuleSize(p, qt);
+      case QuadratureType::SmolyakClenshawCurtis :
+      case QuadratureType::SmolyakGaussPatterson :
+        return Impl::nestedLineRuleSize(p, Impl::smolyakLineType(qt));
+      default :
+        DUNE_THROW(Exception, "Unknown QuadratureType");
+      }
+    }
   };
 
   template<typename ctype>
@@ -467,6 +1413,10 @@ namespace Dune {
     friend class QuadratureRules<ctype, dim>;
     static unsigned maxOrder(const GeometryType &t, QuadratureType::Enum qt)
     {
+      if (t.isCube() && Impl::isSmolyakQuadratureType(qt))
+        return SparseGridQuadratureRule<ctype,dim>::maxOrder(qt);
+      if (qt == QuadratureType::FullySymmetric)
+        qt = QuadratureType::GaussLegendre;
       unsigned order =
         TensorProductQuadratureRule<ctype,dim>::maxOrder(t.id(), qt);
       if (t.isSimplex())
@@ -476,6 +1426,17 @@ namespace Dune {
     }
     static QuadratureRule<ctype, dim> rule(const GeometryType& t, int p, QuadratureType::Enum qt)
     {
+      if (t.isCube() && Impl::isSmolyakQuadratureType(qt))
+        return SparseGridQuadratureRule<ctype,dim>(p, qt);
+      if (t.isCube()
+        && qt == QuadratureType::FullySymmetric
+        && p <= CubeQuadratureRule<ctype,dim>::highest_order
+        && CubeQuadraturePoints<dim>::numPoints(p) > 0)
+      {
+        return CubeQuadratureRule<ctype,dim>(p);
+      }
+      if (qt == QuadratureType::FullySymmetric)
+        qt = QuadratureType::GaussLegendre;
       if (t.isSimplex()
         && ( qt == QuadratureType::GaussLegendre || qt == QuadratureType::GaussJacobi_n_0 )
         && p <= SimplexQuadratureRule<ctype,dim>::highest_order)
@@ -484,6 +1445,27 @@ namespace Dune {
       }
       return TensorProductQuadratureRule<ctype,dim>(t.id(), p, qt);
     }
+    static std::size_t size(const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      if (t.isCube() && Impl::isSmolyakQuadratureType(qt))
+        return SparseGridQuadratureRule<ctype,dim>::numPoints(p, qt);
+      if (t.isCube()
+        && qt == QuadratureType::FullySymmetric
+        && p <= CubeQuadratureRule<ctype,dim>::highest_order
+        && CubeQuadraturePoints<dim>::numPoints(p) > 0)
+      {
+        return CubeQuadraturePoints<dim>::numPoints(p);
+      }
+      if (qt == QuadratureType::FullySymmetric)
+        qt = QuadratureType::GaussLegendre;
+      if (t.isSimplex()
+        && ( qt == QuadratureType::GaussLegendre || qt == QuadratureType::GaussJacobi_n_0 )
+        && p <= SimplexQuadratureRule<ctype,dim>::highest_order)
+      {
+        return SimplexQuadraturePoints<dim>::numPoints(p);
+      }
+      return TensorProductQuadratureRule<ctype,dim>::numPoints(t.id(), p, qt);
+    }
   };
 
   template<typename ctype>
@@ -493,6 +1475,10 @@ namespace Dune {
     friend class QuadratureRules<ctype, dim>;
     static unsigned maxOrder(const GeometryType &t, QuadratureType::Enum qt)
     {
+      if (t.isCube() && Impl::isSmolyakQuadratureType(qt))
+        return SparseGridQuadratureRule<ctype,dim>::maxOrder(qt);
+      if (qt == QuadratureType::FullySymmetric)
+        qt = QuadratureType::GaussLegendre;
       unsigned order =
         TensorProductQuadratureRule<ctype,dim>::maxOrder(t.id(), qt);
       if (t.isSimplex())
@@ -501,36 +1487,95 @@ namespace Dune {
       if (t.isPrism())
         order = std::max
           (order, static_cast<unsigned>(PrismQuadratureRule<ctype,dim>::highest_order));
+      if (t.isPyramid())
+        order = std::max
+          (order, static_cast<unsigned>(PyramidQuadratureRule<ctype,dim>::highest_order));
       return order;
     }
     static QuadratureRule<ctype, dim> rule(const GeometryType& t, int p, QuadratureType::Enum qt)
     {
-
+      if (t.isCube() && Impl::isSmolyakQuadratureType(qt))
+        return SparseGridQuadratureRule<ctype,dim>(p, qt);
+      if (t.isCube()
+        && qt == QuadratureType::FullySymmetric
+        && p <= CubeQuadratureRule<ctype,dim>::highest_order
+        && CubeQuadraturePoints<dim>::numPoints(p) > 0)
+      {
+        return CubeQuadratureRule<ctype,dim>(p);
+      }
+      if (t.isPrism()
+        && qt == QuadratureType::FullySymmetric
+        && p <= PrismQuadratureRule<ctype,dim>::highest_order
+        && PrismQuadraturePoints<dim>::numPoints(p) > 0)
+      {
+        return PrismQuadratureRule<ctype,dim>(p);
+      }
+      if (qt == QuadratureType::FullySymmetric)
+        qt = QuadratureType::GaussLegendre;
       if (t.isSimplex()
         && ( qt == QuadratureType::GaussLegendre || qt == QuadratureType::GaussJacobi_n_0 )
         && p <= SimplexQuadratureRule<ctype,dim>::highest_order)
       {
         return SimplexQuadratureRule<ctype,dim>(p);
       }
-      if (t.isPrism()
+      if (t.isPyramid()
         && qt == QuadratureType::GaussLegendre
-        && p <= PrismQuadratureRule<ctype,dim>::highest_order)
+        && p <= PyramidQuadratureRule<ctype,dim>::highest_order)
       {
-        return PrismQuadratureRule<ctype,dim>(p);
+        return PyramidQuadratureRule<ctype,dim>(p);
       }
       return TensorProductQuadratureRule<ctype,dim>(t.id(), p, qt);
     }
+    static std::size_t size(const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      if (t.isCube() && Impl::isSmolyakQuadratureType(qt))
+        return SparseGridQuadratureRule<ctype,dim>::numPoints(p, qt);
+      if (t.isCube()
+        && qt == QuadratureType::FullySymmetric
+        && p <= CubeQuadratureRule<ctype,dim>::highest_order
+        && CubeQuadraturePoints<dim>::numPoints(p) > 0)
+      {
+        return CubeQuadraturePoints<dim>::numPoints(p);
+      }
+      if (t.isPrism()
+        && qt == QuadratureType::FullySymmetric
+        && p <= PrismQuadratureRule<ctype,dim>::highest_order
+        && PrismQuadraturePoints<dim>::numPoints(p) > 0)
+      {
+        return PrismQuadraturePoints<dim>::numPoints(p);
+      }
+      if (qt == QuadratureType::FullySymmetric)
+        qt = QuadratureType::GaussLegendre;
+      if (t.isSimplex()
+        && ( qt == QuadratureType::GaussLegendre || qt == QuadratureType::GaussJacobi_n_0 )
+        && p <= SimplexQuadratureRule<ctype,dim>::highest_order)
+      {
+        return SimplexQuadraturePoints<dim>::numPoints(p);
+      }
+      if (t.isPyramid()
+        && qt == QuadratureType::GaussLegendre
+        && p <= PyramidQuadratureRule<ctype,dim>::highest_order)
+      {
+        return PyramidQuadraturePoints<dim>::numPoints(p);
+      }
+      return TensorProductQuadratureRule<ctype,dim>::numPoints(t.id(), p, qt);
+    }
   };
 
 #ifndef DUNE_NO_EXTERN_QUADRATURERULES
+  extern template class CubeQuadratureRule<double, 2>;
+  extern template class CubeQuadratureRule<double, 3>;
   extern template class GaussLobattoQuadratureRule<double, 1>;
   extern template class GaussQuadratureRule<double, 1>;
   extern template class GaussRadauLeftQuadratureRule<double, 1>;
   extern template class GaussRadauRightQuadratureRule<double, 1>;
+  extern template class HighOrderGaussQuadratureRule<double, 1>;
   extern template class Jacobi1QuadratureRule<double, 1>;
   extern template class Jacobi2QuadratureRule<double, 1>;
   extern template class JacobiNQuadratureRule<double, 1>;
+  extern template class NestedQuadratureRule<double, 1>;
   extern template class PrismQuadratureRule<double, 3>;
+  extern template class PyramidQuadratureRule<double, 3>;
   extern template class SimplexQuadratureRule<double, 2>;
   extern template class SimplexQuadratureRule<double, 3>;
 #endif // !DUNE_NO_EXTERN_QUADRATURERULES
@@ -0,0 +1,224 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_ADAPTIVEQUADRATURE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_ADAPTIVEQUADRATURE_HH
+
+/** \file
+ * \brief Adaptive integration over reference elements and geometries
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/geometry/multilineargeometry.hh>
+#include <dune/geometry/quadraturerules/embeddedquadraturerule.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+#include <dune/geometry/virtualrefinement.hh>
+
+namespace Dune {
+
+  /** \brief Globally adaptive integration with embedded quadrature rules
+   *  \ingroup Quadrature
+   *
+   * The integral over a reference element is approximated by an
+   * EmbeddedQuadratureRule on every element of a subdivision of the reference
+   * element. The difference to the embedded rule, which reuses the function
+   * values of the rule, estimates the error on each element. As long as the
+   * sum of the estimates exceeds the tolerance, the element with the largest
+   * estimate is subdivided by VirtualRefinement: simplices and cubes are
+   * bisected in every direction, prisms and pyramids are split into simplices.
+   * This resolves near-singular integrands by local refinement.
+   *
+   * The embedded rules and refinements are looked up once per call of
+   * integrate(). The points of the children do not coincide with the points
+   * of the subdivided element, so its function values are not reused and
+   * every subdivision costs the evaluations of all children.
+   *
+   * \code{.cpp}
+   * AdaptiveQuadrature<double,2> adaptive(1e-10, 1e-10);
+   * auto result = adaptive.integrate(GeometryTypes::triangle, [](const auto& x) { return 1.0 / (x[0] + x[1] + 1e-3); });
+   * \endcode
+   *
+   * \tparam ctype Type used for coordinates, quadrature weights and function values
+   * \tparam dim Dimension of the reference element
+   */
+  template<class ctype, int dim>
+  class AdaptiveQuadrature
+  {
+    typedef FieldVector<ctype,dim> Coordinate;
+    typedef MultiLinearGeometry<ctype,dim,dim> ElementGeometry;
+
+    struct Element
+    {
+      GeometryType type;
+      std::vector<Coordinate> corners;
+      ctype value;
+      ctype error;
+
+      bool operator< (const Element& other) const { return error < other.error; }
+    };
+
+  public:
+    //! Result of AdaptiveQuadrature::integrate
+    struct Result
+    {
+      //! approximation of the integral
+      ctype value = 0;
+      //! estimate of the absolute error
+      ctype error = 0;
+      //! number of evaluations of the integrand
+      std::size_t evaluations = 0;
+      //! number of elements of the final subdivision
+      std::size_t elements = 0;
+      //! true if the error estimate satisfies the tolerance
+      bool converged = false;
+    };
+
+    /** \brief Construct an adaptive integrator
+     *
+     * \param absoluteTolerance stop if the estimated error is below this tolerance
+     * \param relativeTolerance or below this tolerance relative to the integral
+     * \param maxEvaluations    do not refine beyond this number of evaluations of the integrand
+     * \param order             order of the embedded rule on every element
+     * \param qt                nested quadrature type, GaussKronrod, GaussPatterson or ClenshawCurtis
+     */
+    AdaptiveQuadrature (ctype absoluteTolerance, ctype relativeTolerance,
+                        std::size_t maxEvaluations = 1000000, int order = 11,
+                        QuadratureType::Enum qt = QuadratureType::GaussKronrod)
+      : absoluteTolerance_(absoluteTolerance), relativeTolerance_(relativeTolerance),
+        maxEvaluations_(maxEvaluations), order_(order), qt_(qt)
+    {}
+
+    /** \brief Integrate f over the reference element of type t
+     *
+     * \param f callable with the local coordinate, returning a value convertible to ctype
+     */
+    template<class F>
+    Result integrate (const GeometryType& t, F&& f) const
+    {
+      assert(t.dim() == dim);
+      const auto refElement = ReferenceElements<ctype,dim>::general(t);
+      std::vector<Coordinate> corners;
+      for (int i = 0; i < refElement.size(dim); ++i)
+        corners.push_back(refElement.position(i, dim));
+
+      // prisms and pyramids are split into simplices, which are bisected from then on
+      const bool sameType = t.isSimplex() || t.isCube();
+      const GeometryType childType = sameType ? t : GeometryTypes::simplex(dim);
+      const EmbeddedQuadratureRule<ctype,dim>& quad = EmbeddedQuadratureRule<ctype,dim>::rule(t, order_, qt_);
+      const EmbeddedQuadratureRule<ctype,dim>& childQuad = sameType ? quad : EmbeddedQuadratureRule<ctype,dim>::rule(childType, order_, qt_);
+      const VirtualRefinement<dim,ctype>& split = buildRefinement<dim,ctype>(t, childType);
+      const VirtualRefinement<dim,ctype>& bisection = buildRefinement<dim,ctype>(childType, childType);
+
+      Result result;
+      std::vector<Element> elements;
+      elements.push_back(evaluate(quad, t, std::move(corners), f, result));
+      result.value = elements.front().value;
+      result.error = elements.front().error;
+
+      using std::abs;
+      while (result.error > std::max(absoluteTolerance_, relativeTolerance_ * abs(result.value)))
+      {
+        // the element with the largest error estimate
+        std::pop_heap(elements.begin(), elements.end());
+        Element element = std::move(elements.back());
+        elements.pop_back();
+
+        const bool bisect = (element.type == childType);
+        const VirtualRefinement<dim,ctype>& refinement = bisect ? bisection : split;
+        const RefinementIntervals intervals = refinementIntervals(bisect ? 2 : 1);
+        if (result.evaluations + refinement.nElements(intervals) * childQuad.size() > maxEvaluations_)
+        {
+          elements.push_back(std::move(element));
+          std::push_heap(elements.begin(), elements.end());
+          break;
+        }
+
+        const ElementGeometry geometry(element.type, element.corners);
+        std::vector<Coordinate> vertices(refinement.nVertices(intervals));
+        for (auto vIt = refinement.vBegin(intervals); vIt != refinement.vEnd(intervals); ++vIt)
+          vertices[vIt.index()] = geometry.global(vIt.coords());
+
+        result.value -= element.value;
+        result.error -= element.error;
+        for (auto eIt = refinement.eBegin(intervals); eIt != refinement.eEnd(intervals); ++eIt)
+        {
+          std::vector<Coordinate> childCorners;
+          for (int v : eIt.vertexIndices())
+            childCorners.push_back(vertices[v]);
+          elements.push_back(evaluate(childQuad, childType, std::move(childCorners), f, result));
+          result.value += elements.back().value;
+          result.error += elements.back().error;
+          std::push_heap(elements.begin(), elements.end());
+        }
+      }
+
+      // sum up again to get rid of the cancellation in the updates
+      result.value = 0;
+      result.error = 0;
+      for (const Element& element : elements)
+      {
+        result.value += element.value;
+        result.error += element.error;
+      }
+      result.elements = elements.size();
+      result.converged = (result.error <= std::max(absoluteTolerance_, relativeTolerance_ * abs(result.value)));
+      return result;
+    }
+
+    /** \brief Integrate f over a geometry, e.g., f = 1 for its volume
+     *
+     * \param f callable with the local coordinate, returning a value convertible to ctype
+     */
+    template<class Geometry, class F>
+    Result integrate (const Geometry& geometry, F&& f) const
+    {
+      static_assert(Geometry::mydimension == dim, "Geometry does not match the dimension of the AdaptiveQuadrature");
+      return integrate(geometry.type(), [&](const Coordinate& x) {
+        return ctype(f(x)) * ctype(geometry.integrationElement(x));
+      });
+    }
+
+  private:
+    // apply the embedded rule of the given type to the element of the reference element with the given corners
+    template<class F>
+    Element evaluate (const EmbeddedQuadratureRule<ctype,dim>& quad, const GeometryType& type,
+                      std::vector<Coordinate>&& corners, F& f, Result& result) const
+    {
+      const ElementGeometry geometry(type, corners);
+      // the integration element of the affine elements is constant
+      const bool affine = geometry.affine();
+      const ctype volume = affine ? ctype(geometry.integrationElement(Coordinate(0))) : ctype(0);
+
+      ctype value = 0;
+      ctype embeddedValue = 0;
+      for (std::size_t i = 0; i < quad.size(); ++i)
+      {
+        const ctype fx = ctype(f(geometry.global(quad[i].position())))
+                         * (affine ? volume : ctype(geometry.integrationElement(quad[i].position())));
+        value += quad[i].weight() * fx;
+        embeddedValue += quad.embeddedWeights()[i] * fx;
+      }
+      result.evaluations += quad.size();
+
+      using std::abs;
+      return Element{ type, std::move(corners), value, abs(value - embeddedValue) };
+    }
+
+    ctype absoluteTolerance_;
+    ctype relativeTolerance_;
+    std::size_t maxEvaluations_;
+    int order_;
+    QuadratureType::Enum qt_;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_ADAPTIVEQUADRATURE_HH
@@ -9,12 +9,29 @@
  * \brief Construct composite quadrature rules from other quadrature rules
  */
 
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/geometry/multilineargeometry.hh>
 #include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/quadraturerules/lazytable.hh>
+#include <dune/geometry/type.hh>
+#include <dune/geometry/typeindex.hh>
 #include <dune/geometry/virtualrefinement.hh>
 
 namespace Dune {
 
   /** \brief Construct composite quadrature rules from other quadrature rules
+   *
+   * The reference element of the base rule is refined by VirtualRefinement
+   * and the base rule is mapped to every sub-element. Simplices and cubes are
+   * refined into elements of their own type. Prisms and pyramids are refined
+   * into simplices, which are integrated by the simplex rule of the same order
+   * and quadrature type as the base rule. Where the simplex has no rule of
+   * that type and order, the GaussLegendre rule of the order is used.
    *
    * \tparam ctype Type used for coordinates and quadrature weights
    * \tparam dim Dimension of the reference element
@@ -23,44 +40,104 @@ namespace Dune {
   class CompositeQuadratureRule
       : public Dune::QuadratureRule<ctype,dim>
   {
+    typedef Dune::MultiLinearGeometry<ctype,dim,dim> SubGeometry;
+
     public:
     /** \brief Construct composite quadrature rule
-     * \param quad Base quadrature rule.  Element type of this rule must be simplex
+     * \param quad Base quadrature rule on any reference element
      * \param intervals Number of refined intervals per axis
+     * \param qt Quadrature type of the simplex rule on the sub-elements of prisms and pyramids
      */
-    CompositeQuadratureRule(const Dune::QuadratureRule<ctype,dim>& quad, const Dune::RefinementIntervals intervals)
+    CompositeQuadratureRule(const Dune::QuadratureRule<ctype,dim>& quad, const Dune::RefinementIntervals intervals,
+                            QuadratureType::Enum qt = QuadratureType::GaussLegendre)
       : QuadratureRule<ctype,dim>(quad.type(), quad.order())
     {
-      // Currently only works for simplices, because we are using the StaticRefinement
-      assert(quad.type().isSimplex());
+      const GeometryType type = quad.type();
+      const bool sameType = type.isSimplex() || type.isCube();
+      const GeometryType subType = sameType ? type : GeometryTypes::simplex(dim);
+      const Dune::QuadratureRule<ctype,dim>& subQuad
+        = sameType ? quad : simplexRule(quad.order(), qt);
 
-      typedef Dune::StaticRefinement<GeometryTypes::simplex(dim).id(),
-                                     ctype,
-                                     GeometryTypes::simplex(dim).id(),
-                                     dim> Refinement;
-      typedef typename Refinement::ElementIterator eIterator;
+      const VirtualRefinement<dim,ctype>& refinement = buildRefinement<dim,ctype>(type, subType);
 
-      ctype volume = Dune::ReferenceElements<ctype,dim>::general(quad.type()).volume();
+      std::vector<FieldVector<ctype,dim> > vertices(refinement.nVertices(intervals));
+      for (auto vIt = refinement.vBegin(intervals); vIt != refinement.vEnd(intervals); ++vIt)
+        vertices[vIt.index()] = vIt.coords();
 
-      eIterator eSubEnd = Refinement::eEnd(intervals);
-      eIterator eSubIt  = Refinement::eBegin(intervals);
+      this->reserve(refinement.nElements(intervals) * subQuad.size());
 
-      for (; eSubIt != eSubEnd; ++eSubIt) {
+      std::vector<FieldVector<ctype,dim> > corners;
+      for (auto eIt = refinement.eBegin(intervals); eIt != refinement.eEnd(intervals); ++eIt) {
 
-        // Percentage of the overall volume of this subelement
-        ctype volumeFraction = eSubIt.geometry().volume() / volume;
+        corners.clear();
+        for (int v : eIt.vertexIndices())
+          corners.push_back(vertices[v]);
+        const SubGeometry geometry(subType, corners);
 
-        for (size_t i=0; i<quad.size(); i++) {
+        for (const auto& qp : subQuad)
+          this->push_back(Dune::QuadraturePoint<ctype,dim>(geometry.global(qp.position()),
+                                                           qp.weight() * geometry.integrationElement(qp.position())));
 
-          this->push_back(Dune::QuadraturePoint<ctype,dim>(eSubIt.geometry().global(quad[i].position()),
-                                                           volumeFraction*quad[i].weight()));
+      }
 
-        }
+    }
 
-      }
+    /** \brief Cached composite rule of the base rule QuadratureRules::rule(t, p, qt)
+     *
+     * Every rule is constructed only once and lives until the end of the program.
+     * The rules are kept in a table like the rules of QuadratureRules, later
+     * calls take three atomic loads.
+     * \note This method is thread-safe.
+     */
+    static const CompositeQuadratureRule& rule (const GeometryType& t, int p, const Dune::RefinementIntervals intervals,
+                                                QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+    {
+      constexpr std::size_t numGeometryTypes = LocalGeometryTypeIndex::size(dim);
+      static const Impl::LazyObjectTable<IntervalTable> table(std::size_t(QuadratureType::size) * numGeometryTypes);
+
+      assert(t.dim() == dim);
+      if (intervals.intervals() < 1)
+        DUNE_THROW(RangeError, "Composite QuadratureRule for " << intervals.intervals() << " intervals not available");
+      if (std::size_t(qt) >= std::size_t(QuadratureType::size))
+        DUNE_THROW(QuadratureOrderOutOfRange, "QuadratureType " << qt << " not available");
+      const auto& row = table.row(std::size_t(qt) * numGeometryTypes + LocalGeometryTypeIndex::index(t), [&]{
+        std::size_t numOrders = 0;
+        if (!t.isNone())
+          numOrders = dim == 0 ? 1 : QuadratureRules<ctype,dim>::maxOrder(t, qt)+1;
+        return numOrders;
+      });
+      // there is only one rule for points
+      const std::size_t order = dim == 0 ? 0 : std::size_t(p);
+      if (p < 0 || order >= row.size)
+        DUNE_THROW(QuadratureOrderOutOfRange, "QuadratureRule for order " << p << " and GeometryType " << t << " not available");
+      const IntervalTable& rules = table.object(row, order, []{ return IntervalTable(std::numeric_limits<int>::digits); });
+
+      // n intervals are at position n - 2^k of row k = floor(log2(n)), so the rows
+      // only grow with the numbers of intervals in use
+      const std::size_t n = intervals.intervals();
+      std::size_t k = 0;
+      while ((n >> (k+1)) > 0)
+        ++k;
+      const auto& intervalRow = rules.row(k, [&]{ return std::size_t(1) << k; });
+      return rules.object(intervalRow, n - (std::size_t(1) << k), [&]{
+        return CompositeQuadratureRule(QuadratureRules<ctype,dim>::rule(t, p, qt), intervals, qt);
+      });
+    }
 
+  private:
+    // the simplex rule of type qt, or the GaussLegendre rule if there is none of that order
+    static const Dune::QuadratureRule<ctype,dim>& simplexRule (int p, QuadratureType::Enum qt)
+    {
+      const GeometryType simplex = GeometryTypes::simplex(dim);
+      if (std::size_t(qt) >= std::size_t(QuadratureType::size)
+          || unsigned(p) > QuadratureRules<ctype,dim>::maxOrder(simplex, qt))
+        qt = QuadratureType::GaussLegendre;
+      return QuadratureRules<ctype,dim>::rule(simplex, p, qt);
     }
 
+    // composite rules of one base rule, indexed by the number of intervals
+    typedef Impl::LazyObjectTable<CompositeQuadratureRule> IntervalTable;
+
   };
 
 }
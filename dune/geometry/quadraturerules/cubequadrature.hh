@@ -0,0 +1,532 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURE_CUBE_HH
+#define DUNE_GEOMETRY_QUADRATURE_CUBE_HH
+
+#ifndef DUNE_INCLUDING_IMPLEMENTATION
+#error This is a private header that should not be included directly.
+#error Use #include <dune/geometry/quadraturerules.hh> instead.
+#endif
+
+#include <cstddef>
+
+namespace Dune {
+
+  /************************************************
+   * Symmetric quadrature for quadrilaterals and hexahedra
+   ***********************************************/
+
+  namespace Impl {
+
+    /** \brief Types of orbits of points under the symmetries of a cube
+     *
+     * The name gives the generator of the orbit in the cube \f$[-1,1]^d\f$,
+     * all points of the orbit are obtained by permuting its coordinates and
+     * changing their signs, e.g. the 24 points of an AB0 orbit in a hexahedron
+     * are \f$(\pm a, \pm b, 0)\f$ and their permutations.
+     */
+    enum class CubeOrbitType { Center, A0, AA, AB, A00, AA0, AAA, AB0, AAB, ABC };
+
+    /** \brief Orbit of a fully symmetric rule, given by the weight of each of its points and the parameters a, b, c */
+    struct CubeOrbit
+    {
+      CubeOrbitType type;
+      double weight;
+      double a = 0.0;
+      double b = 0.0;
+      double c = 0.0;
+    };
+
+    //! fully symmetric rule of the given order on the cube, consisting of a list of orbits
+    struct SymmetricCubeRule
+    {
+      template<std::size_t n>
+      constexpr SymmetricCubeRule (int order, const CubeOrbit (&orbits)[n])
+        : order(order), numOrbits(n), orbits(orbits)
+      {}
+
+      int order;
+      int numOrbits;
+      const CubeOrbit* orbits;
+    };
+
+    /** \brief Write the points and weights of an orbit, returns the number of points
+     *
+     * If points is a nullptr, only the number of points is computed. The
+     * points are mapped from \f$[-1,1]^d\f$ to the reference element \f$[0,1]^d\f$.
+     */
+    template<int dim>
+    constexpr int expandCubeOrbit (const CubeOrbit& orbit, double (*points)[dim], double* weights)
+    {
+      // generator of the orbit, equal labels mark equal coordinates, label 0 marks zeros
+      double generator[3] = {};
+      int label[3] = {};
+      switch (orbit.type)
+      {
+      case CubeOrbitType::Center :
+        break;
+      case CubeOrbitType::A0 :
+      case CubeOrbitType::A00 :
+        generator[0] = orbit.a; label[0] = 1;
+        break;
+      case CubeOrbitType::AA :
+      case CubeOrbitType::AA0 :
+        generator[0] = generator[1] = orbit.a; label[0] = label[1] = 1;
+        break;
+      case CubeOrbitType::AB :
+      case CubeOrbitType::AB0 :
+        generator[0] = orbit.a; generator[1] = orbit.b; label[0] = 1; label[1] = 2;
+        break;
+      case CubeOrbitType::AAA :
+        generator[0] = generator[1] = generator[2] = orbit.a; label[0] = label[1] = label[2] = 1;
+        break;
+      case CubeOrbitType::AAB :
+        generator[0] = generator[1] = orbit.a; generator[2] = orbit.b; label[0] = label[1] = 1; label[2] = 2;
+        break;
+      case CubeOrbitType::ABC :
+        generator[0] = orbit.a; generator[1] = orbit.b; generator[2] = orbit.c; label[0] = 1; label[1] = 2; label[2] = 3;
+        break;
+      }
+
+      // the first two permutations are those of the first two coordinates
+      constexpr int permutations[6][3] = { {0,1,2}, {1,0,2}, {0,2,1}, {1,2,0}, {2,0,1}, {2,1,0} };
+      constexpr int numPermutations = (dim == 2) ? 2 : 6;
+
+      // signed labels of the points found so far
+      int labels[48][dim] = {};
+      int n = 0;
+      for (int k = 0; k < numPermutations; ++k)
+      {
+        const int* perm = permutations[k];
+        for (int sign = 0; sign < (1 << dim); ++sign)
+        {
+          int signedLabel[dim] = {};
+          bool valid = true;
+          for (int j = 0; j < dim; ++j)
+          {
+            const bool negative = (sign >> j) & 1;
+            // the sign of a zero coordinate does not matter
+            valid = valid && !(negative && label[perm[j]] == 0);
+            signedLabel[j] = negative ? -label[perm[j]] : label[perm[j]];
+          }
+
+          bool seen = !valid;
+          for (int l = 0; l < n && !seen; ++l)
+          {
+            bool same = true;
+            for (int j = 0; j < dim; ++j)
+              same = same && (labels[l][j] == signedLabel[j]);
+            seen = same;
+          }
+          if (seen)
+            continue;
+
+          for (int j = 0; j < dim; ++j)
+          {
+            labels[n][j] = signedLabel[j];
+            if (points)
+            {
+              const double x = generator[perm[j]];
+              points[n][j] = 0.5 + 0.5 * ((sign >> j) & 1 ? -x : x);
+            }
+          }
+          if (weights)
+            weights[n] = orbit.weight;
+          ++n;
+        }
+      }
+      return n;
+    }
+
+    //! number of points of a rule
+    template<int dim>
+    constexpr int symmetricCubeRuleSize (const SymmetricCubeRule& rule)
+    {
+      int size = 0;
+      for (int k = 0; k < rule.numOrbits; ++k)
+        size += expandCubeOrbit<dim>(rule.orbits[k], nullptr, nullptr);
+      return size;
+    }
+
+    //! total number of points of a list of rules
+    template<int dim, std::size_t n>
+    constexpr int symmetricCubeRulesSize (const SymmetricCubeRule (&rules)[n])
+    {
+      int size = 0;
+      for (std::size_t r = 0; r < n; ++r)
+        size += symmetricCubeRuleSize<dim>(rules[r]);
+      return size;
+    }
+
+    //! index of the rule with m points in a list of rules, or -1
+    template<int dim, std::size_t n>
+    constexpr int findSymmetricCubeRule (const SymmetricCubeRule (&rules)[n], int m, int& offset)
+    {
+      offset = 0;
+      for (std::size_t r = 0; r < n; ++r)
+      {
+        const int size = symmetricCubeRuleSize<dim>(rules[r]);
+        if (size == m)
+          return r;
+        offset += size;
+      }
+      return -1;
+    }
+
+    /* Fully symmetric rules for the square and the cube.
+     *
+     * All weights are positive and all points are in the interior of the
+     * cube. The rules have been computed in the same way as the symmetric rules
+     * for simplices, the point counts coincide with or are close to those given
+     * by F.D. Witherden, P.E. Vincent, On the identification of symmetric
+     * quadrature rules for finite element methods, Comput. Math. Appl. 69 (2015).
+     * Only orders for which the rules need fewer points than the Gauss-Legendre
+     * tensor product rule are listed.
+     */
+
+    // polynomial degree 5, 8 points
+    constexpr CubeOrbit squareOrbits5[] = {
+      { CubeOrbitType::A0, 2.0408163265306122449e-1, 6.8313005106397322555e-1 },
+      { CubeOrbitType::AA, 4.5918367346938775510e-2, 8.8191710368819686350e-1 },
+    };
+
+    // polynomial degree 7, 12 points
+    constexpr CubeOrbit squareOrbits7[] = {
+      { CubeOrbitType::A0, 6.0493827160493827160e-2, 9.2582009977255146157e-1 },
+      { CubeOrbitType::AA, 1.3014822916684861428e-1, 3.8055443320831565638e-1 },
+      { CubeOrbitType::AA, 5.9357943672657558555e-2, 8.0597978291859874371e-1 },
+    };
+
+    // polynomial degree 9, 20 points
+    constexpr CubeOrbit squareOrbits9[] = {
+      { CubeOrbitType::A0, 1.1354099017168725686e-1, 4.8892685697436906957e-1 },
+      { CubeOrbitType::AA, 5.3550090231715407986e-2, 6.9088055048634387281e-1 },
+      { CubeOrbitType::AA, 1.0682807966443940645e-2, 9.3965525809683770586e-1 },
+      { CubeOrbitType::AB, 3.6113055815076697254e-2, 3.4487202536440357617e-1, 9.1862044105672225966e-1 },
+    };
+
+    // polynomial degree 11, 28 points
+    constexpr CubeOrbit squareOrbits11[] = {
+      { CubeOrbitType::A0, 2.3029697271710680347e-2, 9.6027970040874049553e-1 },
+      { CubeOrbitType::AA, 5.0240177911952267806e-2, 2.1732530375302547565e-1 },
+      { CubeOrbitType::AA, 5.2696937566934143891e-3, 9.5627848884743480008e-1 },
+      { CubeOrbitType::AB, 5.6617238641444531446e-2, 6.6944887787336923115e-1, 2.9237993148904524844e-1 },
+      { CubeOrbitType::AB, 2.9112976888377287283e-2, 9.0182845056045622464e-1, 6.3210117587976473083e-1 },
+    };
+
+    // polynomial degree 13, 37 points
+    constexpr CubeOrbit squareOrbits13[] = {
+      { CubeOrbitType::Center, 8.6698105633418808847e-4 },
+      { CubeOrbitType::A0, 6.8818035189043674770e-2, 3.7760244682200253697e-1 },
+      { CubeOrbitType::AA, 2.3223925473280696252e-2, 8.1668668875884017784e-1 },
+      { CubeOrbitType::AA, 3.8692377097481713134e-3, 9.6157792330976825552e-1 },
+      { CubeOrbitType::AB, 4.9117707816941615165e-2, 3.7471085476701420569e-1, 6.9682993710120281782e-1 },
+      { CubeOrbitType::AB, 1.4965341854781438104e-2, 9.1652910445562422664e-1, 4.8958473815051464730e-2 },
+      { CubeOrbitType::AB, 1.2852978510198902052e-2, 9.6942865317508243723e-1, 5.5273175239933363236e-1 },
+    };
+
+    // polynomial degree 15, 48 points
+    constexpr CubeOrbit squareOrbits15[] = {
+      { CubeOrbitType::A0, 2.9114375780843290178e-2, 8.6454204106738198718e-1 },
+      { CubeOrbitType::AA, 2.7021913023343324830e-2, 1.5366116947250301589e-1 },
+      { CubeOrbitType::AA, 1.3003927964412291540e-2, 3.3721991451654741202e-1 },
+      { CubeOrbitType::AA, 2.0241336776581368190e-3, 9.7396891850109294417e-1 },
+      { CubeOrbitType::AB, 3.6395909087290177331e-2, 5.5926135360832652625e-1, 2.1549981265842240273e-1 },
+      { CubeOrbitType::AB, 3.0355691129212576405e-2, 5.1502827420310464900e-1, 7.7292315666699185347e-1 },
+      { CubeOrbitType::AB, 1.2581659324167202699e-2, 7.6370982357222222598e-1, 9.3601941876908453774e-1 },
+      { CubeOrbitType::AB, 1.0084565236201521882e-2, 3.4091259236860836795e-1, 9.7678034340921257232e-1 },
+    };
+
+    // polynomial degree 17, 60 points
+    constexpr CubeOrbit squareOrbits17[] = {
+      { CubeOrbitType::A0, 2.8014173867687264434e-2, 8.0618614705575436475e-1 },
+      { CubeOrbitType::A0, 1.1451510194750020569e-2, 1.0035040925940075806e-1 },
+      { CubeOrbitType::AA, 1.9346108705137239298e-2, 6.5903433559585749666e-1 },
+      { CubeOrbitType::AA, 1.2528451604209402760e-2, 8.3386446915030588917e-1 },
+      { CubeOrbitType::AA, 3.8760717509655299302e-3, 9.5206039501233623480e-1 },
+      { CubeOrbitType::AB, 2.9334258197945246790e-2, 6.2056973101550216758e-1, 3.2079352778813951796e-1 },
+      { CubeOrbitType::AB, 2.5839157163023964643e-2, 1.4489387341185481650e-1, 3.9382222387552168703e-1 },
+      { CubeOrbitType::AB, 1.7466446698920650752e-2, 8.7689675805046617004e-1, 4.8656799665079373097e-1 },
+      { CubeOrbitType::AB, 9.4078082127214783689e-3, 9.6802323282800991563e-1, 2.2486608183435048099e-1 },
+      { CubeOrbitType::AB, 5.3441716660139309507e-3, 9.8238987439251753120e-1, 7.0604703146236544022e-1 },
+    };
+
+    // polynomial degree 19, 73 points
+    constexpr CubeOrbit squareOrbits19[] = {
+      { CubeOrbitType::Center, 3.4169633496134308435e-2 },
+      { CubeOrbitType::A0, 2.5080413063736358950e-2, 7.6341395779861311708e-1 },
+      { CubeOrbitType::A0, 5.7122781294853328548e-3, 9.8545612522679997726e-1 },
+      { CubeOrbitType::AA, 2.1475893509989574039e-2, 2.3341019849013439890e-1 },
+      { CubeOrbitType::AA, 8.8701622366863430423e-3, 5.3190987049430039363e-1 },
+      { CubeOrbitType::AA, 8.1431933595183755955e-4, 9.8420503879772835219e-1 },
+      { CubeOrbitType::AA, 1.0195888849520896499e-4, 9.7130440965997171082e-1 },
+      { CubeOrbitType::AB, 2.4892038868395170797e-2, 1.6832154197473731533e-1, 4.7687381006544187722e-1 },
+      { CubeOrbitType::AB, 2.2475417713272902200e-2, 4.1170753707223282169e-1, 6.8016099071385987964e-1 },
+      { CubeOrbitType::AB, 1.5911370149992612587e-2, 6.5664861424854051735e-1, 8.3968101863570585755e-1 },
+      { CubeOrbitType::AB, 1.5420594477751888784e-2, 9.1004266233557119501e-1, 2.8237047600587801521e-1 },
+      { CubeOrbitType::AB, 6.0773512646826647751e-3, 8.3773658812403203605e-1, 9.5571852199972141321e-1 },
+      { CubeOrbitType::AB, 4.9245107567156445966e-3, 5.4171789949142316476e-1, 9.8443099124220790962e-1 },
+    };
+
+    // polynomial degree 21, 88 points
+    constexpr CubeOrbit squareOrbits21[] = {
+      { CubeOrbitType::A0, 1.5513649729648873972e-2, 8.3032838127461507529e-1 },
+      { CubeOrbitType::A0, 3.7171327149649972195e-3, 9.8807635676286409535e-1 },
+      { CubeOrbitType::AA, 2.6892261691543767084e-2, 2.8974115105197859548e-1 },
+      { CubeOrbitType::AA, 1.5264724661321552684e-2, 1.1236180053306705215e-1 },
+      { CubeOrbitType::AA, 1.5091527435211864800e-2, 7.1112641977843835680e-1 },
+      { CubeOrbitType::AA, 7.6583168149448552592e-3, 8.6499316507293177041e-1 },
+      { CubeOrbitType::AB, 1.9976533657973556965e-2, 7.0303319451369082540e-1, 2.6028927482813315000e-1 },
+      { CubeOrbitType::AB, 1.5066733744195116024e-2, 3.5120499757804476182e-2, 4.9710114186962107714e-1 },
+      { CubeOrbitType::AB, 1.3860450404255030221e-2, 5.1726603171272825369e-1, 8.5415316433030665292e-1 },
+      { CubeOrbitType::AB, 1.3682313557131550809e-2, 5.6489267026517815104e-1, 4.5718910508078093843e-1 },
+      { CubeOrbitType::AB, 9.6370659265379412400e-3, 9.3469525384362726806e-1, 2.4712408356580462333e-1 },
+      { CubeOrbitType::AB, 6.0595475607159045843e-3, 7.1971011988209497536e-1, 9.5876457715489308540e-1 },
+      { CubeOrbitType::AB, 2.9632347219882633703e-3, 4.6587425367948492030e-1, 9.9040506345824933370e-1 },
+      { CubeOrbitType::AB, 1.6853139033846812775e-3, 9.8773197079686700106e-1, 9.2192103002642561499e-1 },
+    };
+
+    constexpr SymmetricCubeRule squareRules[] = {
+      { 5, squareOrbits5 },
+      { 7, squareOrbits7 },
+      { 9, squareOrbits9 },
+      { 11, squareOrbits11 },
+      { 13, squareOrbits13 },
+      { 15, squareOrbits15 },
+      { 17, squareOrbits17 },
+      { 19, squareOrbits19 },
+      { 21, squareOrbits21 },
+    };
+
+    // polynomial degree 5, 14 points
+    constexpr CubeOrbit hexahedronOrbits5[] = {
+      { CubeOrbitType::A00, 1.1080332409972299169e-1, 7.9582242575422146326e-1 },
+      { CubeOrbitType::AAA, 4.1897506925207756233e-2, 7.5878691063932814627e-1 },
+    };
+
+    // order 7 uses the rule of degree 9, the fully symmetric rules of degree 7
+    // with fewer points have points close to the boundary
+
+    // polynomial degree 9, 58 points
+    constexpr CubeOrbit hexahedronOrbits9[] = {
+      { CubeOrbitType::A00, 5.4159374468706817876e-2, 6.1368146959170899383e-1 },
+      { CubeOrbitType::AA0, 1.1473725767022205271e-2, 8.7768712325767828649e-1 },
+      { CubeOrbitType::AAA, 2.4857479768002937540e-2, 5.6411080702003005427e-1 },
+      { CubeOrbitType::AAA, 6.2685994124186287334e-3, 8.7009978466197591762e-1 },
+      { CubeOrbitType::AAB, 1.2014600439171670804e-2, 4.3226790263086216442e-1, 9.3853042186467174533e-1 },
+    };
+
+    // polynomial degree 11, 90 points
+    constexpr CubeOrbit hexahedronOrbits11[] = {
+      { CubeOrbitType::A00, 2.9616924524020557522e-2, 7.2213303887441850249e-1 },
+      { CubeOrbitType::AA0, 1.6027281776935595698e-2, 8.0393346721528444980e-1 },
+      { CubeOrbitType::AAA, 2.2221008109050483682e-2, 5.3365400888049707914e-1 },
+      { CubeOrbitType::AAA, 1.6988702144552002336e-2, 2.8077258665127436124e-1 },
+      { CubeOrbitType::AAA, 7.7511837875230730132e-3, 8.0948820196309895183e-1 },
+      { CubeOrbitType::AAB, 8.9763421101195533900e-3, 4.0568598019509638695e-1, 9.5458321892956610906e-1 },
+      { CubeOrbitType::AAB, 1.6188211900323230366e-3, 9.8009949100907141012e-1, 5.3078383119382638664e-1 },
+    };
+
+    // polynomial degree 13, 165 points
+    constexpr CubeOrbit hexahedronOrbits13[] = {
+      { CubeOrbitType::Center, 3.2566720231620479082e-2 },
+      { CubeOrbitType::AA0, 1.8323253513700779426e-2, 4.6373989826264175796e-1 },
+      { CubeOrbitType::AAA, 3.2600841134534253978e-3, 8.7555438596506330098e-1 },
+      { CubeOrbitType::AB0, 4.5938494645408288144e-3, 3.5082347158276736302e-1, 9.3899922264712334433e-1 },
+      { CubeOrbitType::AB0, 3.9703822019218334446e-3, 9.4486157093729056793e-1, 7.7417923194491214923e-1 },
+      { CubeOrbitType::AAB, 8.5587916832283051629e-3, 2.7704601144130184011e-1, 7.4822356472564456593e-1 },
+      { CubeOrbitType::AAB, 8.3403815969937786662e-3, 7.4719240093658160450e-1, 4.0768114956031114060e-1 },
+      { CubeOrbitType::AAB, 3.5172411054573480777e-3, 5.7091958806198713436e-1, 9.6406375329115644173e-1 },
+      { CubeOrbitType::AAB, 1.0807524768721876936e-3, 9.7289910794292498465e-1, 5.0408695474984315303e-1 },
+    };
+
+    // polynomial degree 15, 216 points
+    constexpr CubeOrbit hexahedronOrbits15[] = {
+      { CubeOrbitType::A00, 1.4278349952532663195e-2, 6.0225589710763630682e-1 },
+      { CubeOrbitType::A00, 2.9202088890718114967e-3, 9.9329050467275159748e-1 },
+      { CubeOrbitType::AA0, 3.1387870764169275277e-3, 9.0856286990796629474e-1 },
+      { CubeOrbitType::AAA, 1.2295096216524186396e-2, 2.4737373986187663135e-1 },
+      { CubeOrbitType::AAA, 1.1714483439287495276e-2, 4.8532728297955562388e-1 },
+      { CubeOrbitType::AAA, 1.3357355378712081139e-3, 9.1136529703289916979e-1 },
+      { CubeOrbitType::AB0, 6.4486347608119582291e-3, 6.8572443739378419589e-1, 5.7685047306327126483e-1 },
+      { CubeOrbitType::AAB, 7.7235248420204193149e-3, 2.9230402740321869551e-1, 8.5056447554192388571e-1 },
+      { CubeOrbitType::AAB, 5.7036979646591692756e-3, 7.9967300112605214572e-1, 4.9346243212433204534e-1 },
+      { CubeOrbitType::AAB, 1.3548058110635647840e-3, 7.2263302566556089083e-1, 9.7991464230629431186e-1 },
+      { CubeOrbitType::AAB, 6.8757790881537892486e-4, 9.7477781463506216148e-1, 4.9700332512295653851e-1 },
+      { CubeOrbitType::ABC, 2.7154768663961485530e-3, 2.4617756683725282945e-1, 9.6134674526963323611e-1, 6.2619324307807815096e-1 },
+    };
+
+    constexpr SymmetricCubeRule hexahedronRules[] = {
+      { 5, hexahedronOrbits5 },
+      { 9, hexahedronOrbits9 },
+      { 11, hexahedronOrbits11 },
+      { 13, hexahedronOrbits13 },
+      { 15, hexahedronOrbits15 },
+    };
+
+    //! the rules for the cube of dimension dim
+    template<int dim>
+    struct SymmetricCubeRules;
+
+    template<>
+    struct SymmetricCubeRules<2>
+    {
+      static constexpr const auto& rules = squareRules;
+    };
+
+    template<>
+    struct SymmetricCubeRules<3>
+    {
+      static constexpr const auto& rules = hexahedronRules;
+    };
+
+  } // end namespace Impl
+
+  /** \brief Table of the fully symmetric rules for the cube of dimension dim
+      \ingroup Quadrature
+
+      Like SimplexQuadraturePoints, a rule is identified by its number of points m.
+   */
+  template<int dim>
+  class CubeQuadraturePoints
+  {
+    static constexpr const auto& rules_ = Impl::SymmetricCubeRules<dim>::rules;
+    static constexpr int numRules_ = sizeof(rules_) / sizeof(rules_[0]);
+
+  public:
+    constexpr static int highest_order = rules_[numRules_-1].order;
+
+    //! expand the orbits of all rules
+    constexpr CubeQuadraturePoints ()
+    {
+      int offset = 0;
+      for (int r = 0; r < numRules_; ++r)
+        for (int k = 0; k < rules_[r].numOrbits; ++k)
+          offset += Impl::expandCubeOrbit<dim>(rules_[r].orbits[k], G + offset, W + offset);
+    }
+
+    //! i-th point of the rule with m points
+    FieldVector<double, dim> point (int m, int i) const
+    {
+      FieldVector<double, dim> x;
+      for (int j = 0; j < dim; ++j)
+        x[j] = coordinate(m, i, j);
+      return x;
+    }
+
+    //! j-th coordinate of the i-th point of the rule with m points
+    constexpr double coordinate (int m, int i, int j) const
+    {
+      int offset = 0;
+      Impl::findSymmetricCubeRule<dim>(rules_, m, offset);
+      return G[offset+i][j];
+    }
+
+    //! weight of the i-th point of the rule with m points
+    constexpr double weight (int m, int i) const
+    {
+      int offset = 0;
+      Impl::findSymmetricCubeRule<dim>(rules_, m, offset);
+      return W[offset+i];
+    }
+
+    //! order of the rule with m points
+    constexpr int order (int m) const
+    {
+      int offset = 0;
+      return rules_[Impl::findSymmetricCubeRule<dim>(rules_, m, offset)].order;
+    }
+
+    /** \brief number of points of the rule used for quadrature order p
+     *
+     * \returns 0 if the Gauss-Legendre tensor product rule of order p has at
+     *          most as many points as the symmetric rules of order p or higher
+     */
+    static constexpr int numPoints (int p)
+    {
+      int gaussPoints = 1;
+      for (int j = 0; j < dim; ++j)
+        gaussPoints *= p/2 + 1;
+
+      for (int r = 0; r < numRules_; ++r)
+        if (rules_[r].order >= p)
+        {
+          const int size = Impl::symmetricCubeRuleSize<dim>(rules_[r]);
+          return size < gaussPoints ? size : 0;
+        }
+      return 0;
+    }
+
+  private:
+    // the rules one after the other
+    constexpr static int numPoints_ = Impl::symmetricCubeRulesSize<dim>(rules_);
+    double G[numPoints_][dim] = {};
+    double W[numPoints_] = {};
+  };
+
+  /** \brief Fully symmetric quadrature rules for quadrilaterals and hexahedra
+      \ingroup Quadrature
+
+      The rules are invariant under all symmetries of the cube and integrate
+      polynomials of total degree up to their order exactly. Unlike the
+      Gauss-Legendre tensor product rules, they do not integrate all
+      polynomials of degree up to the order in each variable, e.g., the
+      product of the basis functions of a Q_k finite element. Hence they are
+      only handed out for QuadratureType::FullySymmetric, and only for orders
+      where they need fewer points than the Gauss-Legendre tensor product rule.
+   */
+  template<typename ct, int dim>
+  class CubeQuadratureRule : public QuadratureRule<ct,dim>
+  {
+    static_assert(dim == 2 || dim == 3, "Symmetric cube rules are only available for dim=2,3");
+
+  public:
+    /** \brief The highest quadrature order available */
+    constexpr static int highest_order = CubeQuadraturePoints<dim>::highest_order;
+
+  private:
+    friend class QuadratureRuleFactory<ct,dim>;
+    CubeQuadratureRule (int p);
+  };
+
+  /** \brief Singleton holding the symmetric quadrature points of the cube
+     \ingroup Quadrature
+   */
+  template<int dim>
+  struct CubeQuadraturePointsSingleton {};
+
+  template<>
+  struct CubeQuadraturePointsSingleton<2> {
+    static CubeQuadraturePoints<2> cqp;
+  };
+
+  template<>
+  struct CubeQuadraturePointsSingleton<3> {
+    static CubeQuadraturePoints<3> cqp;
+  };
+
+  template<typename ct, int dim>
+  CubeQuadratureRule<ct,dim>::CubeQuadratureRule (int p)
+    : QuadratureRule<ct,dim>(GeometryTypes::cube(dim))
+  {
+    const int m = CubeQuadraturePoints<dim>::numPoints(p);
+    if (p > highest_order || m == 0)
+      DUNE_THROW(QuadratureOrderOutOfRange,
+                 "QuadratureRule for order " << p << " and GeometryType "
+                                             << this->type() << " not available");
+
+    this->delivered_order = CubeQuadraturePointsSingleton<dim>::cqp.order(m);
+    for (int i = 0; i < m; ++i)
+    {
+      FieldVector<ct,dim> local = CubeQuadraturePointsSingleton<dim>::cqp.point(m,i);
+      ct weight = CubeQuadraturePointsSingleton<dim>::cqp.weight(m,i);
+      // put in container
+      this->push_back(QuadraturePoint<ct,dim>(local,weight));
+    }
+  }
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURE_CUBE_HH
@@ -0,0 +1,610 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_CUTCELLQUADRATURE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_CUTCELLQUADRATURE_HH
+
+/** \file
+ * \brief Quadrature rules on the part of a reference element where a level-set function is negative
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/quadraturerules/lazytable.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+
+namespace Dune {
+
+  namespace Impl {
+
+    //! restriction of the integration domain to one sign of a function
+    template<class ctype, int dim>
+    struct CutCellConstraint
+    {
+      std::function<ctype(const FieldVector<ctype,dim>&)> function;
+      //! -1: the function has to be negative, +1: non-negative, 0: its roots only split the domain
+      int sign;
+    };
+
+    //! a root of f in the interval [a,b] with f(a) and f(b) of different sign, by the Illinois method
+    template<class ctype, class F>
+    ctype cutCellRoot (const F& f, ctype a, ctype b, ctype fa, ctype fb)
+    {
+      const ctype tolerance = 4 * std::numeric_limits<ctype>::epsilon() * std::max(std::abs(a), std::abs(b));
+      ctype c = a;
+      int side = 0;
+      for (int i = 0; i < 128; ++i)
+      {
+        const ctype previous = c;
+        c = (fa * b - fb * a) / (fa - fb);
+        const ctype fc = f(c);
+        if (fc == 0 || std::abs(c - previous) <= tolerance)
+          break;
+        if ((fc < 0) == (fb < 0))
+        {
+          b = c; fb = fc;
+          if (side == -1)
+            fa /= 2;
+          side = -1;
+        }
+        else
+        {
+          a = c; fa = fc;
+          if (side == +1)
+            fb /= 2;
+          side = +1;
+        }
+      }
+      return c;
+    }
+
+    //! append the sign changes of f on [a,b], detected at the given number of uniform samples
+    template<class ctype, class F>
+    void cutCellRoots (const F& f, ctype a, ctype b, int samples, std::vector<ctype>& roots)
+    {
+      ctype x0 = a;
+      ctype f0 = f(a);
+      for (int i = 1; i <= samples; ++i)
+      {
+        const ctype x1 = (i == samples) ? b : a + (b - a) * i / samples;
+        const ctype f1 = f(x1);
+        if ((f0 < 0) != (f1 < 0))
+          roots.push_back(f1 == 0 ? x1 : cutCellRoot(f, x0, x1, f0, f1));
+        x0 = x1;
+        f0 = f1;
+      }
+    }
+
+    //! the direction in which f varies most across the box
+    template<class ctype, int dim, class F>
+    int cutCellHeightDirection (const F& f, const FieldVector<ctype,dim>& lower, const FieldVector<ctype,dim>& upper)
+    {
+      FieldVector<ctype,dim> center = lower;
+      center += upper;
+      center *= ctype(0.5);
+
+      int direction = 0;
+      ctype largest = -1;
+      for (int k = 0; k < dim; ++k)
+      {
+        const ctype h = (upper[k] - lower[k]) / 4;
+        FieldVector<ctype,dim> x = center;
+        x[k] = center[k] + h;
+        const ctype right = f(x);
+        x[k] = center[k] - h;
+        const ctype slope = std::abs(right - f(x)) / (2 * h);
+        if (slope > largest)
+        {
+          largest = slope;
+          direction = k;
+        }
+      }
+      return direction;
+    }
+
+    /** \brief Whether the interface of f in the box is a graph over the faces orthogonal to direction k
+     *
+     * f and its derivative in direction k are sampled at 5 points per direction.
+     * The direction is valid if f does not change sign or if the derivative
+     * has the same strict sign at all samples.
+     */
+    template<class ctype, int dim, class F>
+    bool cutCellHeightDirectionValid (const F& f, const FieldVector<ctype,dim>& lower, const FieldVector<ctype,dim>& upper, int k)
+    {
+      constexpr int intervals = 4;
+      int samples = 1;
+      for (int i = 0; i < dim; ++i)
+        samples *= intervals + 1;
+
+      auto samplePoint = [&](int index) {
+        FieldVector<ctype,dim> x;
+        for (int i = 0; i < dim; ++i, index /= intervals + 1)
+          x[i] = lower[i] + (upper[i] - lower[i]) * (index % (intervals + 1)) / intervals;
+        return x;
+      };
+
+      const bool negative = f(samplePoint(0)) < 0;
+      bool cut = false;
+      for (int index = 1; index < samples && !cut; ++index)
+        cut = (f(samplePoint(index)) < 0) != negative;
+      if (!cut)
+        return true;
+
+      const ctype h = std::sqrt(std::numeric_limits<ctype>::epsilon()) * (upper[k] - lower[k]);
+      int sign = 0;
+      for (int index = 0; index < samples; ++index)
+      {
+        FieldVector<ctype,dim> x = samplePoint(index);
+        x[k] += h;
+        const ctype right = f(x);
+        x[k] -= 2 * h;
+        const ctype difference = right - f(x);
+        const int derivativeSign = (difference > 0) - (difference < 0);
+        if (derivativeSign == 0 || derivativeSign == -sign)
+          return false;
+        sign = derivativeSign;
+      }
+      return true;
+    }
+
+    //! whether direction k is valid for the functions of all constraints
+    template<class ctype, int dim>
+    bool cutCellHeightDirectionValid (const std::vector<CutCellConstraint<ctype,dim> >& constraints,
+                                      const FieldVector<ctype,dim>& lower, const FieldVector<ctype,dim>& upper, int k)
+    {
+      return std::all_of(constraints.begin(), constraints.end(), [&](const auto& constraint) {
+        return cutCellHeightDirectionValid(constraint.function, lower, upper, k);
+      });
+    }
+
+    /** \brief Quadrature points of order p on the part of the box [lower,upper] where all constraints hold
+     *
+     * The box is integrated dimension by dimension, following R. Saye, "High-order
+     * quadrature methods for implicitly defined surfaces and volumes in
+     * hyperrectangles", SIAM J. Sci. Comput. 37 (2015). Along the height
+     * direction, in which the first constraint varies most, the integrand is
+     * split at the roots of the constraints and the pieces of the right sign
+     * are integrated by Gauss rules. The remaining directions are integrated
+     * recursively, split at the roots of the constraints on the lower and upper
+     * faces, where the number of roots along the height direction changes.
+     *
+     * On every level of the recursion, the height direction has to be valid for
+     * all constraints, see cutCellHeightDirectionValid(). If no direction is
+     * valid, the box is bisected in all directions, up to maxLevel times.
+     */
+    template<class ctype, int dim>
+    void cutBoxQuadrature (const std::vector<CutCellConstraint<ctype,dim> >& constraints,
+                           const FieldVector<ctype,dim>& lower, const FieldVector<ctype,dim>& upper,
+                           int p, int maxLevel, std::vector<QuadraturePoint<ctype,dim> >& points)
+    {
+      const QuadratureRule<ctype,1>& lineRule = QuadratureRules<ctype,1>::rule(GeometryTypes::line, p);
+      const int samples = p + 4;
+
+      // integrate along direction k through x, scaled by the weight w of x
+      auto integrateLine = [&](FieldVector<ctype,dim> x, int k, ctype w) {
+        std::vector<ctype> breaks = {lower[k], upper[k]};
+        for (const auto& constraint : constraints)
+          cutCellRoots([&](ctype t) { x[k] = t; return constraint.function(x); },
+                       lower[k], upper[k], samples, breaks);
+        std::sort(breaks.begin(), breaks.end());
+
+        for (std::size_t i = 0; i + 1 < breaks.size(); ++i)
+        {
+          const ctype a = breaks[i];
+          const ctype b = breaks[i+1];
+          if (!(b > a))
+            continue;
+
+          x[k] = (a + b) / 2;
+          bool inside = true;
+          for (const auto& constraint : constraints)
+            if (constraint.sign != 0 && (constraint.function(x) < 0) != (constraint.sign < 0))
+              inside = false;
+          if (!inside)
+            continue;
+
+          for (const auto& qp : lineRule)
+          {
+            x[k] = a + (b - a) * qp.position()[0];
+            points.emplace_back(x, w * (b - a) * qp.weight());
+          }
+        }
+      };
+
+      if constexpr (dim == 1)
+        integrateLine(lower, 0, 1);
+      else
+      {
+        // the direction in which the first constraint varies most, or any other valid one
+        int k = cutCellHeightDirection(constraints.front().function, lower, upper);
+        bool valid = cutCellHeightDirectionValid(constraints, lower, upper, k);
+        for (int i = 0; i < dim && !valid; ++i)
+          if (i != k && cutCellHeightDirectionValid(constraints, lower, upper, i))
+          {
+            k = i;
+            valid = true;
+          }
+
+        if (!valid && maxLevel > 0)
+        {
+          for (int child = 0; child < (1 << dim); ++child)
+          {
+            FieldVector<ctype,dim> childLower = lower;
+            FieldVector<ctype,dim> childUpper = upper;
+            for (int i = 0; i < dim; ++i)
+            {
+              const ctype center = (lower[i] + upper[i]) / 2;
+              if (child & (1 << i))
+                childLower[i] = center;
+              else
+                childUpper[i] = center;
+            }
+            cutBoxQuadrature(constraints, childLower, childUpper, p, maxLevel - 1, points);
+          }
+          return;
+        }
+
+        auto insert = [k](const FieldVector<ctype,dim-1>& y, ctype t) {
+          FieldVector<ctype,dim> x;
+          for (int i = 0, j = 0; i < dim; ++i)
+            x[i] = (i == k) ? t : y[j++];
+          return x;
+        };
+
+        std::vector<CutCellConstraint<ctype,dim-1> > faceConstraints;
+        for (const auto& constraint : constraints)
+          for (const ctype t : {lower[k], upper[k]})
+            faceConstraints.push_back({[f = constraint.function, insert, t](const FieldVector<ctype,dim-1>& y) {
+              return f(insert(y, t));
+            }, 0});
+
+        FieldVector<ctype,dim-1> faceLower, faceUpper;
+        for (int i = 0; i < dim-1; ++i)
+        {
+          faceLower[i] = lower[i < k ? i : i+1];
+          faceUpper[i] = upper[i < k ? i : i+1];
+        }
+
+        std::vector<QuadraturePoint<ctype,dim-1> > facePoints;
+        cutBoxQuadrature(faceConstraints, faceLower, faceUpper, p, maxLevel, facePoints);
+        for (const auto& qp : facePoints)
+          integrateLine(insert(qp.position(), lower[k]), k, qp.weight());
+      }
+    }
+
+    /** \brief Quadrature points of order p on the part of the box [lower,upper] where levelSet is negative
+     *
+     * Boxes in which no height direction is valid, e.g. around points where the
+     * interface is tangent to a coordinate direction, are bisected in all
+     * directions, up to maxLevel times on each level of the recursion.
+     */
+    template<class ctype, int dim>
+    void cutCellQuadrature (const std::function<ctype(const FieldVector<ctype,dim>&)>& levelSet,
+                            const FieldVector<ctype,dim>& lower, const FieldVector<ctype,dim>& upper,
+                            int p, int maxLevel, std::vector<QuadraturePoint<ctype,dim> >& points)
+    {
+      const std::vector<CutCellConstraint<ctype,dim> > constraints = {{levelSet, -1}};
+      cutBoxQuadrature(constraints, lower, upper, p, maxLevel, points);
+    }
+
+    //! map xi from the unit cube to the reference simplex by collapsing coordinates, returns the Jacobian determinant
+    template<class ctype, int dim>
+    ctype collapseToSimplex (const FieldVector<ctype,dim>& xi, FieldVector<ctype,dim>& x)
+    {
+      ctype scale = 1;
+      ctype jacobian = 1;
+      for (int k = dim-1; k >= 0; --k)
+      {
+        x[k] = scale * xi[k];
+        jacobian *= scale;
+        scale *= 1 - xi[k];
+      }
+      return jacobian;
+    }
+
+  } // end namespace Impl
+
+  /** \brief Quadrature rule on the part of a reference element where a level-set function is negative
+   *  \ingroup Quadrature
+   *
+   * Cut cells in fictitious-domain and extended finite element methods are
+   * integrated by a rule of the requested order on the region
+   * \f$\{x : \phi(x) < 0\}\f$ of a simplex or cube reference element, instead of
+   * a composite rule on a fine subdivision. Two descriptions of the level set
+   * \f$\phi\f$ are supported:
+   *
+   * - A callable `levelSet(x)` on the reference element: The region is
+   *   integrated dimension by dimension, the rule of order p on lines is placed
+   *   between the roots of \f$\phi\f$ along one coordinate direction, see
+   *   Impl::cutBoxQuadrature(). Simplices are collapsed onto the cube first.
+   *   Where the interface is not the graph of a function over the faces
+   *   orthogonal to any coordinate direction, the cube is bisected, on every
+   *   level of the dimension-by-dimension recursion. Roots are detected at p+4
+   *   samples per line, so features of \f$\phi\f$ smaller than that
+   *   resolution may be missed. order() is the order p of the rules on lines:
+   *   on curved interfaces the rule is not exact for polynomials of order p,
+   *   but for smooth \f$\phi\f$ its error decreases exponentially with p.
+   * - The values of \f$\phi\f$ at the vertices: \f$\phi\f$ is interpolated
+   *   linearly on simplices and linearly on the Kuhn simplices of cubes, and
+   *   the region is split into simplices, each of which gets the simplex rule
+   *   of order p. The rule is exact up to order p on the region. The splitting
+   *   only depends on the signs at the vertices and is cached per sign
+   *   pattern, see decomposition().
+   *
+   * \code{.cpp}
+   * // disc of radius 0.4 around the center of the unit square
+   * CutCellQuadratureRule<double,2> disc(GeometryTypes::quadrilateral, [](const auto& x) {
+   *   return (x[0]-0.5)*(x[0]-0.5) + (x[1]-0.5)*(x[1]-0.5) - 0.16;
+   * }, 8);
+   * // level set given by its vertex values
+   * CutCellQuadratureRule<double,2> part(GeometryTypes::triangle, std::vector<double>{-1.0, 0.5, 2.0}, 4);
+   * \endcode
+   *
+   * \tparam ctype Type used for coordinates and quadrature weights
+   * \tparam dim Dimension of the reference element
+   */
+  template<class ctype, int dim>
+  class CutCellQuadratureRule
+    : public QuadratureRule<ctype,dim>
+  {
+    static_assert(dim >= 1, "Cut cells need at least one dimension");
+
+  public:
+    //! type of the positions in the reference element
+    typedef FieldVector<ctype,dim> Coordinate;
+
+    /** \brief Vertex of a sub-simplex of the cut cell
+     *
+     * A pair (i,i) is vertex i of the reference element, a pair (i,j) with i<j
+     * is the root of the level set on the segment between vertices i and j.
+     */
+    typedef std::pair<int,int> CutVertex;
+
+    //! sub-simplex of the cut cell
+    typedef std::array<CutVertex,dim+1> CutSimplex;
+
+    /** \brief Rule of order p on the part of the reference element of type t where levelSet is negative
+     *
+     * \param t        simplex or cube type
+     * \param levelSet callable with the signature `ctype(const Coordinate&)`
+     * \param p        order of the rules on lines
+     * \param maxLevel maximal number of bisections of the cube where the interface is not a graph
+     */
+    template<class LevelSet,
+             std::enable_if_t<std::is_invocable_v<const LevelSet&, const Coordinate&>, int> = 0>
+    CutCellQuadratureRule (const GeometryType& t, const LevelSet& levelSet, int p, int maxLevel = 4)
+      : QuadratureRule<ctype,dim>(t, p)
+    {
+      checkType(t);
+
+      std::vector<QuadraturePoint<ctype,dim> > points;
+      const Coordinate lower(0), upper(1);
+
+      if (t.isCube())
+      {
+        Impl::cutCellQuadrature<ctype,dim>([&levelSet](const Coordinate& x) { return ctype(levelSet(x)); },
+                                           lower, upper, p, maxLevel, points);
+        this->assign(points.begin(), points.end());
+        return;
+      }
+
+      // the collapse multiplies the integrand by a polynomial of order dim-1
+      Impl::cutCellQuadrature<ctype,dim>([&levelSet](const Coordinate& xi) {
+        Coordinate x;
+        Impl::collapseToSimplex(xi, x);
+        return ctype(levelSet(x));
+      }, lower, upper, p + dim - 1, maxLevel, points);
+
+      this->reserve(points.size());
+      for (const auto& qp : points)
+      {
+        Coordinate x;
+        const ctype jacobian = Impl::collapseToSimplex(qp.position(), x);
+        this->push_back(QuadraturePoint<ctype,dim>(x, qp.weight() * jacobian));
+      }
+    }
+
+    /** \brief Rule of order p on the part of the reference element of type t where the interpolated level set is negative
+     *
+     * \param t            simplex or cube type
+     * \param vertexValues values of the level set at the vertices of the reference element
+     * \param p            order of the simplex rule on the sub-simplices
+     */
+    CutCellQuadratureRule (const GeometryType& t, const std::vector<ctype>& vertexValues, int p)
+      : QuadratureRule<ctype,dim>(t, p)
+    {
+      checkType(t);
+      const auto refElement = referenceElement<ctype,dim>(t);
+      if (int(vertexValues.size()) != refElement.size(dim))
+        DUNE_THROW(RangeError, "Expected " << refElement.size(dim) << " vertex values, got " << vertexValues.size());
+
+      const bool negative = std::any_of(vertexValues.begin(), vertexValues.end(), [](ctype v) { return v < 0; });
+      const bool positive = std::any_of(vertexValues.begin(), vertexValues.end(), [](ctype v) { return v > 0; });
+      if (!negative)
+        return;
+      if (!positive)
+      {
+        const QuadratureRule<ctype,dim>& full = QuadratureRules<ctype,dim>::rule(t, p);
+        this->assign(full.begin(), full.end());
+        return;
+      }
+
+      const QuadratureRule<ctype,dim>& simplexRule = QuadratureRules<ctype,dim>::rule(GeometryTypes::simplex(dim), p);
+      const std::vector<CutSimplex>& simplices = decomposition(t, vertexValues);
+      this->reserve(simplices.size() * simplexRule.size());
+
+      for (const CutSimplex& simplex : simplices)
+      {
+        std::array<Coordinate,dim+1> corners;
+        for (int i = 0; i <= dim; ++i)
+        {
+          const auto [first, second] = simplex[i];
+          corners[i] = refElement.position(first, dim);
+          if (first != second)
+          {
+            Coordinate direction = refElement.position(second, dim);
+            direction -= corners[i];
+            corners[i].axpy(vertexValues[first] / (vertexValues[first] - vertexValues[second]), direction);
+          }
+        }
+
+        FieldMatrix<ctype,dim,dim> jacobianTransposed;
+        for (int i = 0; i < dim; ++i)
+        {
+          jacobianTransposed[i] = corners[i+1];
+          jacobianTransposed[i] -= corners[0];
+        }
+        const ctype volume = std::abs(jacobianTransposed.determinant());
+        if (volume == 0)
+          continue;
+
+        for (const auto& qp : simplexRule)
+        {
+          Coordinate x = corners[0];
+          jacobianTransposed.umtv(qp.position(), x);
+          this->push_back(QuadraturePoint<ctype,dim>(x, qp.weight() * volume));
+        }
+      }
+    }
+
+    /** \brief Code of the signs of the vertex values, -1, 0 and +1 are the base-3 digits 0, 1 and 2 */
+    static std::uint64_t signPattern (const std::vector<ctype>& vertexValues)
+    {
+      std::uint64_t pattern = 0;
+      for (std::size_t i = vertexValues.size(); i-- > 0;)
+        pattern = 3 * pattern + (vertexValues[i] < 0 ? 0 : vertexValues[i] > 0 ? 2 : 1);
+      return pattern;
+    }
+
+    /** \brief Sub-simplices of the region where the interpolated level set is negative
+     *
+     * Cubes are split into their dim! Kuhn simplices. Every simplex is split
+     * recursively at the root on a segment between a negative and a positive
+     * vertex, until its vertices are either all non-positive or all
+     * non-negative. Degenerate sub-simplices may occur if vertex values are zero.
+     *
+     * The decomposition is cached by the type and signPattern() of the vertex
+     * values in lazy tables like the rules of QuadratureRules, it lives until
+     * the end of the program and later calls only take atomic loads. The
+     * lowest eight base-3 digits of the pattern index a row of the table of
+     * the higher digits, so simplices and cubes up to 16 vertices are supported.
+     * \note This method is thread-safe.
+     */
+    static const std::vector<CutSimplex>& decomposition (const GeometryType& t, const std::vector<ctype>& vertexValues)
+    {
+      // row 0 for the simplex, row 1 for the cube
+      static const Impl::LazyObjectTable<PatternTable> table(2);
+
+      checkType(t);
+      const std::size_t numVertices = vertexValues.size();
+      if (numVertices > 16)
+        DUNE_THROW(NotImplemented, "Decomposition of geometry type " << t << " with " << numVertices << " vertices");
+
+      const std::size_t numLowDigits = std::min<std::size_t>(numVertices, 8);
+      std::size_t numLowPatterns = 1, numHighPatterns = 1;
+      for (std::size_t i = 0; i < numVertices; ++i)
+        (i < numLowDigits ? numLowPatterns : numHighPatterns) *= 3;
+
+      const std::uint64_t pattern = signPattern(vertexValues);
+      const auto& row = table.row(t.isSimplex() ? 0 : 1, [&]{ return numHighPatterns; });
+      const PatternTable& decompositions = table.object(row, pattern / numLowPatterns, []{ return PatternTable(1); });
+      const auto& patternRow = decompositions.row(0, [&]{ return numLowPatterns; });
+      return decompositions.object(patternRow, pattern % numLowPatterns, [&]{
+        std::vector<int> signs(numVertices);
+        for (std::size_t i = 0; i < numVertices; ++i)
+          signs[i] = vertexValues[i] < 0 ? -1 : vertexValues[i] > 0 ? 1 : 0;
+
+        std::vector<CutSimplex> simplices;
+        for (const CutSimplex& simplex : elementSimplices(t))
+          cut(simplex, signs, simplices);
+        return simplices;
+      });
+    }
+
+  private:
+    static void checkType (const GeometryType& t)
+    {
+      if (int(t.dim()) != dim)
+        DUNE_THROW(RangeError, "Geometry type " << t << " does not have dimension " << dim);
+      if (!t.isSimplex() && !t.isCube())
+        DUNE_THROW(NotImplemented, "Cut-cell quadrature for geometry type " << t);
+    }
+
+    // the simplex itself, or the Kuhn simplices of the cube
+    static std::vector<CutSimplex> elementSimplices (const GeometryType& t)
+    {
+      std::vector<CutSimplex> simplices;
+      if (t.isSimplex())
+      {
+        CutSimplex simplex;
+        for (int i = 0; i <= dim; ++i)
+          simplex[i] = CutVertex(i, i);
+        simplices.push_back(simplex);
+        return simplices;
+      }
+
+      std::array<int,dim> permutation;
+      std::iota(permutation.begin(), permutation.end(), 0);
+      do
+      {
+        CutSimplex simplex;
+        int vertex = 0;
+        simplex[0] = CutVertex(vertex, vertex);
+        for (int i = 0; i < dim; ++i)
+        {
+          vertex |= 1 << permutation[i];
+          simplex[i+1] = CutVertex(vertex, vertex);
+        }
+        simplices.push_back(simplex);
+      } while (std::next_permutation(permutation.begin(), permutation.end()));
+      return simplices;
+    }
+
+    // append the parts of simplex where the level set is negative
+    static void cut (const CutSimplex& simplex, const std::vector<int>& signs, std::vector<CutSimplex>& negative)
+    {
+      // roots on segments have sign 0
+      auto sign = [&](const CutVertex& v) { return v.first == v.second ? signs[v.first] : 0; };
+
+      for (int i = 0; i <= dim; ++i)
+        for (int j = i+1; j <= dim; ++j)
+          if (sign(simplex[i]) * sign(simplex[j]) < 0)
+          {
+            const CutVertex root(std::min(simplex[i].first, simplex[j].first),
+                                 std::max(simplex[i].first, simplex[j].first));
+            CutSimplex first = simplex;
+            CutSimplex second = simplex;
+            first[j] = root;
+            second[i] = root;
+            cut(first, signs, negative);
+            cut(second, signs, negative);
+            return;
+          }
+
+      if (std::any_of(simplex.begin(), simplex.end(), [&](const CutVertex& v) { return sign(v) < 0; }))
+        negative.push_back(simplex);
+    }
+
+    // decompositions of one geometry type, indexed by the low digits of the sign pattern
+    typedef Impl::LazyObjectTable<std::vector<CutSimplex> > PatternTable;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_CUTCELLQUADRATURE_HH
@@ -0,0 +1,158 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_EMBEDDEDQUADRATURERULE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_EMBEDDEDQUADRATURERULE_HH
+
+/** \file
+ * \brief Quadrature rules together with a rule of lower order on a subset of their points
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/quadraturerules/lazytable.hh>
+#include <dune/geometry/type.hh>
+#include <dune/geometry/typeindex.hh>
+
+namespace Dune {
+
+  /** \brief Quadrature rule with an embedded rule of lower order
+   *  \ingroup Quadrature
+   *
+   * The embedded rule uses a subset of the quadrature points, its weights are
+   * given for all points of the rule and vanish at the points it does not use.
+   * Evaluating the integrand once at all points gives both approximations, their
+   * difference estimates the error of the embedded rule and, usually very
+   * pessimistically, the one of the rule itself.
+   *
+   * The rules are built from the nested 1d rules of the quadrature types
+   * GaussKronrod, GaussPatterson and ClenshawCurtis by the same tensor and
+   * conical products as TensorProductQuadratureRule, for all reference elements.
+   *
+   * \tparam ctype Type used for coordinates and quadrature weights
+   * \tparam dim Dimension of the reference element
+   */
+  template<class ctype, int dim>
+  class EmbeddedQuadratureRule
+    : public QuadratureRule<ctype,dim>
+  {
+    typedef QuadraturePoint<ctype,dim> QPoint;
+
+  public:
+    /** \brief Construct the embedded rule of order p of type qt for the reference element of type t
+     *
+     * \throws QuadratureOrderOutOfRange if the order is not available
+     * \throws NotImplemented if qt is not one of the nested quadrature types
+     */
+    EmbeddedQuadratureRule (const GeometryType& t, int p, QuadratureType::Enum qt = QuadratureType::GaussKronrod)
+      : QuadratureRule<ctype,dim>(t)
+    {
+      if (qt != QuadratureType::GaussKronrod && qt != QuadratureType::GaussPatterson
+          && qt != QuadratureType::ClenshawCurtis)
+        DUNE_THROW(NotImplemented, "QuadratureType " << qt << " has no embedded rules");
+      assert(t.dim() == dim);
+
+      if constexpr (dim == 0)
+      {
+        this->delivered_order = std::numeric_limits<int>::max();
+        embeddedOrder_ = std::numeric_limits<int>::max();
+        this->push_back(QPoint(typename QPoint::Vector(ctype(0)), ctype(1)));
+        embeddedWeights_.push_back(ctype(1));
+      }
+      else if constexpr (dim == 1)
+      {
+        const Impl::NestedLineRule<ctype> rule = Impl::nestedLineRule<ctype>(p, qt);
+        this->delivered_order = rule.order;
+        embeddedOrder_ = rule.embeddedOrder;
+        for (std::size_t i = 0; i < rule.points.size(); ++i)
+          this->push_back(QPoint(typename QPoint::Vector(rule.points[i]), rule.weights[i]));
+        embeddedWeights_ = rule.embeddedWeights;
+      }
+      else
+      {
+        const GeometryType baseType(t.id() & ~(1u << (dim-1)), dim-1);
+        const EmbeddedQuadratureRule<ctype,dim-1> baseQuad(baseType, p, qt);
+
+        // see TensorProductQuadratureRule::tensorProduct and conicalProduct
+        const bool isPrism = t.isPrismatic();
+        const int lineOrder = isPrism ? p : p + dim-1;
+        const EmbeddedQuadratureRule<ctype,1> lineQuad(GeometryTypes::line, lineOrder, qt);
+
+        const int lost = isPrism ? 0 : dim-1;
+        this->delivered_order = std::min(baseQuad.order(), lineQuad.order() - lost);
+        embeddedOrder_ = std::min(baseQuad.embeddedOrder(), lineQuad.embeddedOrder() - lost);
+        if (baseQuad.embeddedOrder() < 0 || lineQuad.embeddedOrder() - lost < 0)
+          embeddedOrder_ = -1;
+
+        this->reserve(baseQuad.size() * lineQuad.size());
+        embeddedWeights_.reserve(baseQuad.size() * lineQuad.size());
+        for (std::size_t bqi = 0; bqi < baseQuad.size(); ++bqi)
+          for (std::size_t oqi = 0; oqi < lineQuad.size(); ++oqi)
+          {
+            typename QPoint::Vector point;
+            point[dim-1] = lineQuad[oqi].position()[0];
+            const ctype scale = isPrism ? ctype(1) : ctype(1) - point[dim-1];
+            for (int i = 0; i < dim-1; ++i)
+              point[i] = scale * baseQuad[bqi].position()[i];
+
+            ctype jacobian = ctype(1);
+            for (int i = 0; i < lost; ++i)
+              jacobian *= scale;
+
+            this->push_back(QPoint(point, baseQuad[bqi].weight() * lineQuad[oqi].weight() * jacobian));
+            embeddedWeights_.push_back(baseQuad.embeddedWeights()[bqi] * lineQuad.embeddedWeights()[oqi] * jacobian);
+          }
+      }
+    }
+
+    //! order of the embedded rule, -1 if there is none
+    int embeddedOrder () const { return embeddedOrder_; }
+
+    //! weights of the embedded rule at all quadrature points of this rule
+    const std::vector<ctype>& embeddedWeights () const { return embeddedWeights_; }
+
+    /** \brief Cached embedded rule of order p of type qt for the reference element of type t
+     *
+     * Every rule is constructed only once and lives until the end of the program.
+     * The rules are kept in a table like the rules of QuadratureRules, later
+     * calls take two atomic loads.
+     * \note This method is thread-safe.
+     */
+    static const EmbeddedQuadratureRule& rule (const GeometryType& t, int p, QuadratureType::Enum qt = QuadratureType::GaussKronrod)
+    {
+      constexpr std::size_t numGeometryTypes = LocalGeometryTypeIndex::size(dim);
+      static const Impl::LazyObjectTable<EmbeddedQuadratureRule> table(std::size_t(QuadratureType::size) * numGeometryTypes);
+
+      assert(t.dim() == dim);
+      if (std::size_t(qt) >= std::size_t(QuadratureType::size))
+        DUNE_THROW(NotImplemented, "QuadratureType " << qt << " has no embedded rules");
+      const auto& row = table.row(std::size_t(qt) * numGeometryTypes + LocalGeometryTypeIndex::index(t), [&]{
+        // an upper bound, orders without embedded rule throw on construction
+        std::size_t numOrders = 0;
+        if (!t.isNone())
+          numOrders = dim == 0 ? 1 : QuadratureRules<ctype,dim>::maxOrder(t, qt)+1;
+        return numOrders;
+      });
+      // there is only one rule for points
+      const std::size_t order = dim == 0 ? 0 : std::size_t(p);
+      if (p < 0 || order >= row.size)
+        DUNE_THROW(QuadratureOrderOutOfRange, "Embedded QuadratureRule for order " << p << " and GeometryType " << t << " not available");
+
+      return table.object(row, order, [&]{ return EmbeddedQuadratureRule(t, p, qt); });
+    }
+
+  private:
+    int embeddedOrder_ = -1;
+    std::vector<ctype> embeddedWeights_;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_EMBEDDEDQUADRATURERULE_HH
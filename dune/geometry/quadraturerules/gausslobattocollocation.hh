@@ -0,0 +1,303 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_GAUSSLOBATTOCOLLOCATION_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_GAUSSLOBATTOCOLLOCATION_HH
+
+/** \file
+ * \brief Gauss-Lobatto collocation points on cubes with precomputed geometric factors
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/geometry/affinegeometry.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/quadraturerules/lazytable.hh>
+#include <dune/geometry/type.hh>
+
+namespace Dune {
+
+  /** \brief Tensor-product Gauss-Lobatto rule on the cube in lexicographic order
+   *  \ingroup Quadrature
+   *
+   * The points and weights are those of the GaussLobatto rule on the cube
+   * returned by QuadratureRules, i.e., of the TensorProductQuadratureRule of the
+   * 1d GaussLobattoQuadratureRule. Here the 1d points are sorted ascendingly and
+   * the point with the 1d indices \f$(i_0,\dots,i_{dim-1})\f$ has the index
+   * \f$\sum_e i_e n^e\f$, with the first direction running fastest. These are the
+   * nodes of spectral elements, where the rule gives the lumped mass matrix.
+   * Unlike the rules of QuadratureRules on the cube, the rule is available up to
+   * the highest order of the 1d GaussLobatto rules.
+   *
+   * \tparam ctype Type used for coordinates and quadrature weights
+   * \tparam dim Dimension of the cube
+   */
+  template<class ctype, int dim>
+  class GaussLobattoCollocationRule
+    : public QuadratureRule<ctype,dim>
+  {
+    typedef QuadraturePoint<ctype,dim> QPoint;
+
+  public:
+    /** \brief Construct the rule of order p, with p/2+2 points per direction
+     *
+     * \throws QuadratureOrderOutOfRange if the order is not available
+     */
+    explicit GaussLobattoCollocationRule (int p)
+      : QuadratureRule<ctype,dim>(GeometryTypes::cube(dim))
+    {
+      const QuadratureRule<ctype,1>& line
+        = QuadratureRules<ctype,1>::rule(GeometryTypes::line, p, QuadratureType::GaussLobatto);
+      this->delivered_order = line.order();
+
+      std::vector<std::pair<ctype,ctype> > nodes;
+      for (const auto& qp : line)
+        nodes.emplace_back(qp.position()[0], qp.weight());
+      std::sort(nodes.begin(), nodes.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+      for (const auto& [point, weight] : nodes)
+      {
+        points1d_.push_back(point);
+        weights1d_.push_back(weight);
+      }
+
+      const std::size_t n = points1d_.size();
+      std::size_t size = 1;
+      for (int e = 0; e < dim; ++e)
+        size *= n;
+
+      this->reserve(size);
+      for (std::size_t q = 0; q < size; ++q)
+      {
+        typename QPoint::Vector point;
+        ctype weight = ctype(1);
+        for (std::size_t e = 0, index = q; e < std::size_t(dim); ++e, index /= n)
+        {
+          point[e] = points1d_[index % n];
+          weight *= weights1d_[index % n];
+        }
+        this->push_back(QPoint(point, weight));
+      }
+    }
+
+    //! number of points per direction
+    std::size_t size1d () const { return points1d_.size(); }
+
+    //! the 1d points in ascending order
+    const std::vector<ctype>& points1d () const { return points1d_; }
+
+    //! the weights of the 1d points
+    const std::vector<ctype>& weights1d () const { return weights1d_; }
+
+    /** \brief Cached rule of order p
+     *
+     * Every rule is constructed only once and lives until the end of the program.
+     * The rules are kept in a table like the rules of QuadratureRules, later
+     * calls take two atomic loads.
+     * \note This method is thread-safe.
+     */
+    static const GaussLobattoCollocationRule& rule (int p)
+    {
+      static const Impl::LazyObjectTable<GaussLobattoCollocationRule> table(1);
+
+      const auto& row = table.row(0, []{
+        return std::size_t(QuadratureRules<ctype,1>::maxOrder(GeometryTypes::line, QuadratureType::GaussLobatto)) + 1;
+      });
+      if (p < 0 || std::size_t(p) >= row.size)
+        DUNE_THROW(QuadratureOrderOutOfRange, "Gauss-Lobatto collocation rule for order " << p << " not available");
+      return table.object(row, p, [&]{ return GaussLobattoCollocationRule(p); });
+    }
+
+  private:
+    std::vector<ctype> points1d_;
+    std::vector<ctype> weights1d_;
+  };
+
+  /** \brief Geometric factors of a multilinear cube at all Gauss-Lobatto collocation points
+   *  \ingroup Quadrature
+   *
+   * bind() evaluates the geometry of an element at all points of a
+   * GaussLobattoCollocationRule at once: the global points, the lumped (diagonal)
+   * mass weights \f$w_q\,\mu(x_q)\f$ and the transposed inverse Jacobians. The
+   * multilinear map is given by its corners, and its values and derivatives are
+   * obtained by applying the 1d factors of the corners to one direction after the
+   * other (sum factorization), which takes \f$O(dim^2 n^{dim})\f$ operations
+   * instead of \f$O(dim\,2^{dim} n^{dim})\f$ for evaluating the geometry point
+   * by point. The results are stored contiguously in the order of the points of
+   * the rule.
+   *
+   * \code{.cpp}
+   * GaussLobattoGeometricFactors<double,3> factors(7);
+   * for (const auto& element : elements(gridView))
+   * {
+   *   factors.bind(element.geometry());
+   *   for (std::size_t q = 0; q < factors.size(); ++q)
+   *     diagonal[q] += factors.massWeights()[q];
+   * }
+   * \endcode
+   *
+   * \tparam ctype Type used for coordinates and quadrature weights
+   * \tparam dim Dimension of the cube
+   * \tparam cdim Dimension of the world space
+   */
+  template<class ctype, int dim, int cdim = dim>
+  class GaussLobattoGeometricFactors
+  {
+  public:
+    //! type of the global coordinates
+    typedef FieldVector<ctype,cdim> GlobalCoordinate;
+
+    //! type of the transposed inverse Jacobians
+    typedef FieldMatrix<ctype,cdim,dim> JacobianInverseTransposed;
+
+    //! type of the collocation rule
+    typedef GaussLobattoCollocationRule<ctype,dim> Rule;
+
+    //! Prepare the evaluation at the points of the collocation rule of order p
+    explicit GaussLobattoGeometricFactors (int p)
+      : rule_(&Rule::rule(p))
+    {
+      // the 1d factors of the corners and their derivatives at the 1d points
+      const std::size_t n = rule_->size1d();
+      const std::vector<ctype>& points = rule_->points1d();
+      values_.resize(2*n);
+      derivatives_.resize(2*n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        values_[2*i] = ctype(1) - points[i];
+        values_[2*i+1] = points[i];
+        derivatives_[2*i] = ctype(-1);
+        derivatives_[2*i+1] = ctype(1);
+      }
+    }
+
+    /** \brief Evaluate the geometric factors of a geometry
+     *
+     * The geometry has to be a cube and multilinear, e.g., a MultiLinearGeometry,
+     * an AffineGeometry or an AxisAlignedCubeGeometry. It is only accessed by its corners.
+     * \throws NotImplemented if the geometry is not a cube
+     */
+    template<class Geometry>
+    void bind (const Geometry& geometry)
+    {
+      static_assert(int(Geometry::mydimension) == dim, "Geometry does not match the dimension of the rule");
+      static_assert(int(Geometry::coorddimension) == cdim, "Geometry does not match the world dimension");
+      if (!geometry.type().isCube())
+        DUNE_THROW(NotImplemented, "GaussLobattoGeometricFactors are only available for cubes");
+
+      for (int i = 0; i < (1 << dim); ++i)
+        corners_[i] = geometry.corner(i);
+      bindCorners();
+    }
+
+    /** \brief Evaluate the geometric factors of the multilinear cube with the given corners
+     *
+     * The corners are numbered as in the reference cube, i.e., bit e of the
+     * index of a corner is its coordinate in direction e.
+     */
+    void bind (const std::vector<GlobalCoordinate>& corners)
+    {
+      assert(corners.size() == std::size_t(1 << dim));
+      std::copy(corners.begin(), corners.end(), corners_.begin());
+      bindCorners();
+    }
+
+    //! the collocation rule
+    const Rule& rule () const { return *rule_; }
+
+    //! number of collocation points
+    std::size_t size () const { return rule_->size(); }
+
+    //! the images of the collocation points under the bound geometry
+    const std::vector<GlobalCoordinate>& globalPoints () const { return globalPoints_; }
+
+    //! the weights times the integration element, the diagonal of the lumped mass matrix
+    const std::vector<ctype>& massWeights () const { return massWeights_; }
+
+    //! the transposed inverse Jacobians at the collocation points
+    const std::vector<JacobianInverseTransposed>& jacobianInverseTransposed () const
+    {
+      return jacobianInverseTransposed_;
+    }
+
+  private:
+    // The buffers are reused by later calls, so only the first bind() allocates
+    void bindCorners ()
+    {
+      tabulate(-1, globalPoints_);
+      for (int d = 0; d < dim; ++d)
+        tabulate(d, jacobianTransposed_[d]);
+
+      const std::size_t size = rule_->size();
+      massWeights_.resize(size);
+      jacobianInverseTransposed_.resize(size);
+      FieldMatrix<ctype,dim,cdim> jt;
+      for (std::size_t q = 0; q < size; ++q)
+      {
+        for (int d = 0; d < dim; ++d)
+          jt[d] = jacobianTransposed_[d][q];
+        const ctype integrationElement
+          = Impl::FieldMatrixHelper<ctype>::template rightInvA<dim,cdim>(jt, jacobianInverseTransposed_[q]);
+        massWeights_[q] = (*rule_)[q].weight() * integrationElement;
+      }
+    }
+
+    // The corners with the 1d factors applied in all directions, with their
+    // derivatives in direction d, alternating between the two scratch buffers
+    void tabulate (int d, std::vector<GlobalCoordinate>& result)
+    {
+      const GlobalCoordinate* in = corners_.data();
+      std::size_t size = corners_.size();
+      for (int e = 0; e < dim; ++e)
+      {
+        std::vector<GlobalCoordinate>& out = (e == dim-1) ? result : scratch_[e % 2];
+        size = contract(in, size, e, (e == d) ? derivatives_ : values_, out);
+        in = out.data();
+      }
+    }
+
+    // Apply the n x 2 matrix to the axis a of extent 2 of the tensor in,
+    // whose axes before a have extent n and after a extent 2
+    std::size_t contract (const GlobalCoordinate* in, std::size_t size, int a,
+                          const std::vector<ctype>& matrix, std::vector<GlobalCoordinate>& out) const
+    {
+      const std::size_t n = rule_->size1d();
+      std::size_t inner = 1;
+      for (int e = 0; e < a; ++e)
+        inner *= n;
+      const std::size_t outer = size / (2*inner);
+
+      out.resize(outer * n * inner);
+      for (std::size_t o = 0; o < outer; ++o)
+        for (std::size_t i = 0; i < n; ++i)
+          for (std::size_t k = 0; k < inner; ++k)
+          {
+            GlobalCoordinate& value = out[(o*n + i)*inner + k];
+            value = in[(o*2)*inner + k];
+            value *= matrix[2*i];
+            value.axpy(matrix[2*i+1], in[(o*2 + 1)*inner + k]);
+          }
+      return out.size();
+    }
+
+    const Rule* rule_;
+    std::vector<ctype> values_, derivatives_;
+    std::array<GlobalCoordinate, (1 << dim)> corners_;
+    std::array<std::vector<GlobalCoordinate>, 2> scratch_;
+    std::array<std::vector<GlobalCoordinate>, dim> jacobianTransposed_;
+    std::vector<GlobalCoordinate> globalPoints_;
+    std::vector<ctype> massWeights_;
+    std::vector<JacobianInverseTransposed> jacobianInverseTransposed_;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_GAUSSLOBATTOCOLLOCATION_HH
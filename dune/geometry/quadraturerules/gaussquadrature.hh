@@ -42,16 +42,18 @@ namespace Dune {
   //! internal Helper template for the initialization of the quadrature rules
   template<typename ct>
   struct GaussQuadratureInitHelper {
-    static void init(int p,
-                     std::vector< FieldVector<ct, 1> > & _points,
-                     std::vector< ct > & _weight,
-                     int & delivered_order);
+    template<class Points, class Weights>
+    static constexpr void init(int p,
+                               Points & _points,
+                               Weights & _weight,
+                               int & delivered_order);
   };
 
   template<typename ct>
-  void GaussQuadratureInitHelper<ct>::init(int p,
-         std::vector< FieldVector<ct, 1> > & _points,
-         std::vector< ct > & _weight,
+  template<class Points, class Weights>
+  constexpr void GaussQuadratureInitHelper<ct>::init(int p,
+         Points & _points,
+         Weights & _weight,
          int & delivered_order)
   {
     switch(p)
@@ -1297,7 +1299,7 @@ namespace Dune {
       break;
 
     default :
-      DUNE_THROW(QuadratureOrderOutOfRange, "Quadrature rule " << p << " not supported!");
+      Impl::throwQuadratureOrderOutOfRange(p);
     }
   }
 
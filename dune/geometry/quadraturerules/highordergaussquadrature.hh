@@ -0,0 +1,487 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_HIGHORDERGAUSSQUADRATURE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_HIGHORDERGAUSSQUADRATURE_HH
+
+#ifndef DUNE_INCLUDING_IMPLEMENTATION
+#error This is a private header that should not be included directly.
+#error Use #include <dune/geometry/quadraturerules.hh> instead.
+#endif
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/math.hh>
+
+namespace Dune {
+
+  namespace Impl {
+
+    // Values of the Legendre polynomials P_0,...,P_n at x
+    template<class ct>
+    void legendrePolynomials (int n, const ct& x, std::vector<ct>& values)
+    {
+      values.resize(n+1);
+      values[0] = ct(1);
+      if (n > 0)
+        values[1] = x;
+      for (int k = 1; k < n; ++k)
+        values[k+1] = (ct(2*k+1)*x*values[k] - ct(k)*values[k-1]) / ct(k+1);
+    }
+
+    // The product a*b = p + e exactly, by the splitting of Dekker for a binary floating point type
+    template<class ct>
+    void twoProduct (const ct& a, const ct& b, ct& p, ct& e)
+    {
+      const ct splitter = ct(1ull << ((std::numeric_limits<ct>::digits + 1) / 2)) + ct(1);
+      const auto split = [&](const ct& x, ct& high, ct& low) {
+        const ct c = splitter * x;
+        high = c - (c - x);
+        low = x - high;
+      };
+      ct ah, al, bh, bl;
+      split(a, ah, al);
+      split(b, bh, bl);
+      p = a * b;
+      e = ((ah*bh - p) + ah*bl + al*bh) + al*bl;
+    }
+
+    /* The constant 4/pi Gamma(n+1)/Gamma(n+3/2) of the asymptotic expansion of P_n
+     *
+     * It is the product of 4/pi and the factors 2k/(2k+1), k = 1,...,n. The
+     * rounding errors of the n factors and products would add up to a bias of
+     * the weights, so the product is kept as an unevaluated sum of two numbers.
+     */
+    template<class ct>
+    ct legendreAsymptoticConstant (int n)
+    {
+      ct high = ct(4) / MathematicalConstants<ct>::pi(), low = ct(0);
+      for (int k = 1; k <= n; ++k)
+      {
+        // the factor 2k/(2k+1) = f + g
+        ct p, e;
+        const ct f = ct(2*k) / ct(2*k+1);
+        twoProduct(f, ct(2*k+1), p, e);
+        const ct g = ((ct(2*k) - p) - e) / ct(2*k+1);
+
+        twoProduct(high, f, p, e);
+        e += high*g + low*f;
+        high = p + e;
+        low = e - (high - p);
+      }
+      return high;
+    }
+
+    /* Legendre polynomial P_n at x = cos(t), for 0 <= t <= pi/2
+     *
+     * Away from the endpoint, P_n is evaluated in O(1) by the asymptotic expansion
+     * of Stieltjes as in the method of Hale and Townsend,
+     *
+     *   P_n(cos t) = C_n sum_m h_m cos(a_m) / (2 sin t)^(m+1/2),
+     *   a_m = (n+m+1/2) t - (m+1/2) pi/2,
+     *
+     * with C_n = 4/pi Gamma(n+1)/Gamma(n+3/2) and h_m = prod_{k=1}^m (k-1/2)^2 / (k (n+k+1/2)).
+     * The terms decrease while m < 2 n sin(t), so the series is summed until the
+     * terms are below the precision of ct, for any floating point type. Where it
+     * does not get there, which happens for a number of roots next to the endpoint
+     * that does not grow with n, the three-term recurrence is evaluated in the form
+     * of Reinsch for the differences P_k - P_{k-1} and d = 1 - x = 2 sin^2(t/2).
+     * Unlike the recurrence in x, it resolves t close to the endpoint x = 1, where
+     * the roots of P_n cluster, to full relative accuracy. A rule thus costs O(n).
+     *
+     * The Bessel function expansion of Hale and Townsend and the tables of Bogaert
+     * for the roots next to the endpoints would only be accurate for double.
+     */
+    template<class ct>
+    class LegendreOnAngle
+    {
+      // the maximal number of terms of the asymptotic expansion
+      constexpr static int maxTerms = 64;
+
+    public:
+      explicit LegendreOnAngle (int n)
+        : n_(n), a_(n), b_(n), h_(maxTerms)
+      {
+        for (int k = 0; k < n; ++k)
+        {
+          a_[k] = ct(k) / ct(k+1);
+          b_[k] = ct(2*k+1) / ct(k+1);
+        }
+
+        h_[0] = legendreAsymptoticConstant<ct>(n);
+        for (int m = 0; m+1 < maxTerms; ++m)
+          h_[m+1] = h_[m] * ct(2*m+1) * ct(2*m+1) / (ct(4) * ct(m+1) * (ct(n) + ct(m) + ct(1.5)));
+      }
+
+      // P_n(cos t) and the difference P_n(cos t) - P_{n-1}(cos t)
+      void evaluate (const ct& t, ct& value, ct& difference) const
+      {
+        if (n_ < 2 || !expansion(t, value, difference))
+          recurrence(t, value, difference);
+      }
+
+    private:
+      /* The asymptotic expansion, returns false if it does not converge
+       *
+       * The terms of P_{n-1} are those of P_n with the factor 1 + (m+1/2)/n and
+       * the angle a_m - t. With b_m = a_m - t/2, the difference is summed as
+       * cos(a_m) - cos(a_m - t) = -2 sin(b_m) sin(t/2) to avoid the cancellation
+       * of the two expansions.
+       */
+      bool expansion (const ct& t, ct& value, ct& difference) const
+      {
+        using std::cos; using std::sin; using std::sqrt;
+        const ct eps = std::numeric_limits<ct>::epsilon();
+        const ct s = sin(t), c = cos(t);
+        const ct sh = sin(t / ct(2)), ch = cos(t / ct(2));
+        const ct scale = ct(1) / (ct(2)*s);
+
+        // the angle b_m is increased by t - pi/2 from one term to the next
+        const ct b = ct(n_)*t - MathematicalConstants<ct>::pi() / ct(4);
+        ct cosB = cos(b), sinB = sin(b);
+        ct factor = sqrt(scale);
+        const ct first = h_[0] * factor;
+        value = ct(0);
+        difference = ct(0);
+        for (int m = 0; m < maxTerms; ++m)
+        {
+          const ct term = h_[m] * factor;
+          value += term * (cosB*ch - sinB*sh);
+          difference -= term * (ct(2)*sinB*sh + ct(2*m+1) / ct(2*n_) * (cosB*ch + sinB*sh));
+          if (term * ct(m+1) <= eps * first)
+            return true;
+
+          // the terms grow from m = 2 n sin(t) on
+          if (m+1 < maxTerms && h_[m+1] * scale >= h_[m])
+            return false;
+          factor *= scale;
+          const ct nextCos = sinB*c + cosB*s;
+          sinB = sinB*s - cosB*c;
+          cosB = nextCos;
+        }
+        return false;
+      }
+
+      void recurrence (const ct& t, ct& value, ct& difference) const
+      {
+        using std::sin;
+        const ct h = sin(t / ct(2));
+        const ct d = ct(2)*h*h;
+        value = ct(1);
+        difference = ct(0);
+        for (std::size_t k = 0; k < a_.size(); ++k)
+        {
+          difference = a_[k]*difference - b_[k]*d*value;
+          value += difference;
+        }
+      }
+
+      int n_;
+      std::vector<ct> a_, b_, h_;
+    };
+
+    // Newton's method for a root t of a function of the angle, step(t) gives the Newton correction
+    template<class ct, class Step>
+    ct newtonOnAngle (ct t, const Step& step)
+    {
+      using std::abs; using std::sqrt;
+      const ct eps = std::numeric_limits<ct>::epsilon();
+      ct lastCorrection = std::numeric_limits<ct>::max();
+      for (int iteration = 0; iteration < 100; ++iteration)
+      {
+        const ct dt = step(t);
+        t -= dt;
+        // stop at full accuracy or once rounding errors dominate the correction
+        if (abs(dt) <= ct(2)*eps*t || (abs(dt) < sqrt(eps)*t && abs(dt) >= lastCorrection / ct(2)))
+          break;
+        lastCorrection = abs(dt);
+      }
+      return t;
+    }
+
+    /* Angles t of the n/2 largest roots cos(t) of P_n and the weights at them of
+     * the Gauss-Legendre rule on [0,1]
+     *
+     * The roots are found by Newton's method in t, started from the asymptotic
+     * approximation of Tricomi. The weights are computed from P_n', which,
+     * unlike P_{n-1}, is insensitive to a small error of the root.
+     */
+    template<class ct>
+    void gaussLegendreAngles (int n, std::vector<ct>& angles, std::vector<ct>& weights)
+    {
+      using std::cos; using std::sin;
+      const ct pi = MathematicalConstants<ct>::pi();
+      const LegendreOnAngle<ct> legendre(n);
+      angles.resize(n/2);
+      weights.resize(n/2);
+
+      // sin(t) P_n'(cos t) = n (P_{n-1} - x P_n) / sin(t) = n (d P_n - (P_n - P_{n-1})) / sin(t)
+      const auto derivative = [&](const ct& t, const ct& value, const ct& difference) {
+        const ct h = sin(t / ct(2));
+        return ct(n) * (ct(2)*h*h*value - difference) / sin(t);
+      };
+
+      for (int i = 0; i < n/2; ++i)
+      {
+        ct t = pi * ct(4*i+3) / ct(4*n+2);
+        t += cos(t) / (ct(8)*ct(n)*ct(n)*sin(t));
+        t = newtonOnAngle(t, [&](const ct& t) {
+          ct value, difference;
+          legendre.evaluate(t, value, difference);
+          return -value / derivative(t, value, difference);
+        });
+
+        ct value, difference;
+        legendre.evaluate(t, value, difference);
+        const ct u = derivative(t, value, difference);
+        angles[i] = t;
+        weights[i] = ct(1) / (u*u);
+      }
+    }
+
+    // Weight of the midpoint of the Gauss-Legendre rule with odd n on [0,1]
+    template<class ct>
+    ct gaussLegendreMidpointWeight (int n)
+    {
+      std::vector<ct> p;
+      legendrePolynomials(n, ct(0), p);
+      return ct(1) / (ct(n)*ct(n)*p[n-1]*p[n-1]);
+    }
+
+    /* Gauss-Legendre rule with n points on [0,1], the points in ascending order
+     *
+     * The points (1 - cos t)/2 close to 0 are computed as sin^2(t/2) to keep their
+     * relative accuracy.
+     */
+    template<class ct>
+    void gaussLegendreRule (int n, std::vector<ct>& points, std::vector<ct>& weights)
+    {
+      using std::cos; using std::sin;
+      std::vector<ct> angles, angleWeights;
+      gaussLegendreAngles(n, angles, angleWeights);
+      points.resize(n);
+      weights.resize(n);
+      for (int i = 0; i < n/2; ++i)
+      {
+        const ct h = sin(angles[i] / ct(2));
+        points[i] = h*h;
+        points[n-1-i] = (ct(1) + cos(angles[i])) / ct(2);
+        weights[i] = weights[n-1-i] = angleWeights[i];
+      }
+
+      // the root of odd n is the midpoint
+      if (n % 2 == 1)
+      {
+        points[n/2] = ct(0.5);
+        weights[n/2] = gaussLegendreMidpointWeight<ct>(n);
+      }
+    }
+
+    // Gauss-Legendre rule with n points on [-1,1], the points in ascending order
+    template<class ct>
+    void gaussLegendreLine (int n, std::vector<ct>& points, std::vector<ct>& weights)
+    {
+      using std::cos;
+      std::vector<ct> angles, angleWeights;
+      gaussLegendreAngles(n, angles, angleWeights);
+      points.resize(n);
+      weights.resize(n);
+      for (int i = 0; i < n/2; ++i)
+      {
+        points[n-1-i] = cos(angles[i]);
+        points[i] = -points[n-1-i];
+        weights[i] = weights[n-1-i] = ct(2) * angleWeights[i];
+      }
+      if (n % 2 == 1)
+      {
+        points[n/2] = ct(0);
+        weights[n/2] = ct(2) * gaussLegendreMidpointWeight<ct>(n);
+      }
+    }
+
+    /* Gauss-Lobatto rule with n >= 2 points on [0,1], the points in ascending order
+     *
+     * The interior points are the roots of P_{n-1}', found by Newton's method in
+     * the angle as for the Gauss-Legendre rule.
+     */
+    template<class ct>
+    void gaussLobattoRule (int n, std::vector<ct>& points, std::vector<ct>& weights)
+    {
+      using std::cos; using std::sin;
+      const ct pi = MathematicalConstants<ct>::pi();
+      const int m = n-1;
+      const LegendreOnAngle<ct> legendre(m);
+      points.resize(n);
+      weights.resize(n);
+
+      points[0] = ct(0);
+      points[n-1] = ct(1);
+      weights[0] = weights[n-1] = ct(1) / (ct(m)*ct(m+1));
+      for (int i = 1; i < n/2; ++i)
+      {
+        ct t = pi * (ct(i) + ct(0.25)) / (ct(m) + ct(0.5));
+        // the root of g = sin^2(t) P_m' / m = P_{m-1} - x P_m, with dg/dt = (m+1) sin(t) P_m
+        t = newtonOnAngle(t, [&](const ct& t) {
+          ct value, difference;
+          legendre.evaluate(t, value, difference);
+          const ct h = sin(t / ct(2));
+          return (ct(2)*h*h*value - difference) / (ct(m+1) * sin(t) * value);
+        });
+
+        ct value, difference;
+        legendre.evaluate(t, value, difference);
+        const ct h = sin(t / ct(2));
+        points[i] = h*h;
+        points[n-1-i] = (ct(1) + cos(t)) / ct(2);
+        weights[i] = weights[n-1-i] = ct(1) / (ct(m)*ct(m+1)*value*value);
+      }
+
+      if (n % 2 == 1)
+      {
+        std::vector<ct> p;
+        legendrePolynomials(m, ct(0), p);
+        points[n/2] = ct(0.5);
+        weights[n/2] = ct(1) / (ct(m)*ct(m+1)*p[m]*p[m]);
+      }
+    }
+
+    /* Gauss-Radau rule with n points on [0,1] including the left or the right endpoint
+     *
+     * The points of the left rule on [-1,1] besides -1 are the roots of
+     * P_{n-1} + P_n. The roots with x > 0 are found as roots in t with x = cos(t),
+     * the ones with x < 0 as roots of P_n - P_{n-1} with -x = cos(t), such that
+     * the Newton iteration is always close to the endpoint x = 1 of the recurrence.
+     * The right rule is the mirrored left rule.
+     */
+    template<class ct>
+    void gaussRadauRule (int n, bool left, std::vector<ct>& points, std::vector<ct>& weights)
+    {
+      using std::cos; using std::sin;
+      const ct pi = MathematicalConstants<ct>::pi();
+      const LegendreOnAngle<ct> legendre(n);
+      points.resize(n);
+      weights.resize(n);
+
+      // the point of the left rule and its distance to 1
+      const auto setPoint = [&](int i, const ct& point, const ct& complement, const ct& weight) {
+        const int j = left ? i : n-1-i;
+        points[j] = left ? point : complement;
+        weights[j] = weight;
+      };
+
+      setPoint(0, ct(0), ct(1), ct(1) / (ct(n)*ct(n)));
+      for (int k = 1; k < n; ++k)
+      {
+        // the weights use P_{n-1} - P_n, which is insensitive to a small error of the root
+        if (2*k <= n)
+        {
+          // the k-th largest point x = cos(t), a root of g = P_n + P_{n-1}, dg/dt = -n (1 + x) (P_{n-1} - P_n) / sin(t)
+          ct t = pi * (ct(k) - ct(0.25)) / ct(n);
+          t = newtonOnAngle(t, [&](const ct& t) {
+            ct value, difference;
+            legendre.evaluate(t, value, difference);
+            const ct hc = cos(t / ct(2));
+            return (ct(2)*value - difference) * sin(t) / (ct(n) * ct(2)*hc*hc * difference);
+          });
+
+          ct value, difference;
+          legendre.evaluate(t, value, difference);
+          const ct h = sin(t / ct(2));
+          setPoint(n-k, (ct(1) + cos(t)) / ct(2), h*h, ct(4)*h*h / (ct(n)*ct(n)*difference*difference));
+        }
+        else
+        {
+          // the point -cos(t), with P_k(-y) = (-1)^k P_k(y) a root of g = P_n - P_{n-1} in y = cos(t)
+          const int j = n-k;
+          ct t = pi * (ct(j) + ct(0.25)) / ct(n);
+          t = newtonOnAngle(t, [&](const ct& t) {
+            ct value, difference;
+            legendre.evaluate(t, value, difference);
+            const ct h = sin(t / ct(2));
+            return -difference * sin(t) / (ct(n) * ct(2)*h*h * (ct(2)*value - difference));
+          });
+
+          ct value, difference;
+          legendre.evaluate(t, value, difference);
+          const ct sum = ct(2)*value - difference;
+          const ct h = sin(t / ct(2));
+          const ct complement = (ct(1) + cos(t)) / ct(2);
+          setPoint(j, h*h, complement, ct(4)*complement / (ct(n)*ct(n)*sum*sum));
+        }
+      }
+    }
+
+  } // end namespace Impl
+
+  /************************************************
+   * Quadraturerule for 1d line
+   *************************************************/
+
+  template<typename ct, int dim>
+  class HighOrderGaussQuadratureRule;
+
+  template<typename ct>
+  using HighOrderGaussQuadratureRule1D = HighOrderGaussQuadratureRule<ct,1>;
+
+  /** \brief Gauss-Legendre, Gauss-Lobatto and Gauss-Radau rules of arbitrary order
+   *
+   * The points and weights are computed at run time for the number type ct by
+   * Newton's method on the angle, started from asymptotic approximations of
+   * the roots, with O(1) evaluations of the Legendre polynomials by their
+   * asymptotic expansion, see Impl::LegendreOnAngle. Neither LAPACK nor a
+   * particular floating point type is needed. The rules are used on lines
+   * beyond the orders of the tabulated rules, the products on other reference
+   * elements keep the orders of the tabulated rules.
+   */
+  template<typename ct>
+  class HighOrderGaussQuadratureRule<ct,1> : public QuadratureRule<ct,1>
+  {
+  public:
+    // compile time parameters
+    constexpr static int dim = 1;
+
+    /** brief The highest quadrature order available */
+    constexpr static int highest_order = 2047;
+
+  private:
+    friend class QuadratureRuleFactory<ct,dim>;
+
+    HighOrderGaussQuadratureRule (int p, QuadratureType::Enum qt)
+      : QuadratureRule<ct,1>(GeometryTypes::line)
+    {
+      if (p < 0 || p > highest_order)
+        DUNE_THROW(QuadratureOrderOutOfRange, "Quadrature rule " << p << " not supported!");
+
+      std::vector<ct> points, weights;
+      switch (qt) {
+      case QuadratureType::GaussLegendre :
+        Impl::gaussLegendreRule(p/2 + 1, points, weights);
+        this->delivered_order = 2*points.size() - 1;
+        break;
+      case QuadratureType::GaussLobatto :
+        Impl::gaussLobattoRule(p/2 + 2, points, weights);
+        this->delivered_order = 2*points.size() - 3;
+        break;
+      case QuadratureType::GaussRadauLeft :
+      case QuadratureType::GaussRadauRight :
+        Impl::gaussRadauRule((p+1)/2 + 1, qt == QuadratureType::GaussRadauLeft, points, weights);
+        this->delivered_order = 2*points.size() - 2;
+        break;
+      default :
+        DUNE_THROW(Exception, "QuadratureType " << qt << " has no high order rules");
+      }
+
+      this->reserve(points.size());
+      for (std::size_t i = 0; i < points.size(); ++i)
+        this->push_back(QuadraturePoint<ct,dim>(FieldVector<ct,dim>(points[i]), weights[i]));
+    }
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_HIGHORDERGAUSSQUADRATURE_HH
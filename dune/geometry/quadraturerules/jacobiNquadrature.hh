@@ -3,6 +3,8 @@
 #ifndef DUNE_GEOMETRY_QUADRATURERULES_JACOBI_N_0_H
 #define DUNE_GEOMETRY_QUADRATURERULES_JACOBI_N_0_H
 
+#include <algorithm>
+#include <cstddef>
 #include <vector>
 #include <type_traits>
 
@@ -40,6 +42,26 @@ namespace Dune {
     // compile time parameters
     constexpr static int dim = 1;
 
+    /** \brief Number of points of the rule, computed without building it
+     *
+     * \throws QuadratureOrderOutOfRange or NotImplemented like the constructor
+     */
+    static std::size_t numPoints (int const order, int const alpha=0)
+    {
+      if (static_cast<unsigned>(order) > maxOrder())
+        DUNE_THROW(QuadratureOrderOutOfRange, "Quadrature rule " << order << " not supported!");
+      if (static_cast<unsigned>(order) >= tabulatedOrder() || alpha > 2)
+      {
+#if HAVE_LAPACK
+        if (!std::is_floating_point<ct>::value)
+          DUNE_THROW(QuadratureOrderOutOfRange, "Quadrature rule with degree: "<< order << " and jacobi exponent: "<< alpha<< " is not supported for this type!");
+#else
+        DUNE_THROW(NotImplemented, "LAPACK must be enable to use JacobiN quadrature rules.");
+#endif
+      }
+      return order/2 + 1;
+    }
+
   private:
 
     typedef QuadratureRule<ct, dim> Rule;
@@ -49,6 +71,9 @@ namespace Dune {
     template< class ctype, int dimension>
     friend class TensorProductQuadratureRule;
 
+    template< class ctype, int dimension>
+    friend class TensorProductQuadratureFactors;
+
     explicit JacobiNQuadratureRule (int const order, int const alpha=0)
       : Rule( GeometryTypes::line )
     {
@@ -66,13 +91,18 @@ namespace Dune {
       return 127; // can be changed
     }
 
+    // the orders below which the rules for alpha <= 2 are tabulated
+    static unsigned tabulatedOrder()
+    {
+      return std::min(   static_cast<unsigned>(GaussQuadratureRule1D<ct>::highest_order),
+                std::min( static_cast<unsigned>(Jacobi1QuadratureRule1D<ct>::highest_order),
+                          static_cast<unsigned>(Jacobi2QuadratureRule1D<ct>::highest_order))
+                );
+    }
+
     QuadratureRule<ct,1> decideRule(int const degree, int const alpha)
     {
-      const auto maxOrder = std::min(   static_cast<unsigned>(GaussQuadratureRule1D<ct>::highest_order),
-                              std::min( static_cast<unsigned>(Jacobi1QuadratureRule1D<ct>::highest_order),
-                                        static_cast<unsigned>(Jacobi2QuadratureRule1D<ct>::highest_order))
-                              );
-      return static_cast<unsigned>(degree) < maxOrder ? decideRuleExponent(degree,alpha) : UseLapackOrError<ct>(degree, alpha);
+      return static_cast<unsigned>(degree) < tabulatedOrder() ? decideRuleExponent(degree,alpha) : UseLapackOrError<ct>(degree, alpha);
     }
 
 #if HAVE_LAPACK
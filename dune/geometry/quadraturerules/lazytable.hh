@@ -0,0 +1,163 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_LAZYTABLE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_LAZYTABLE_HH
+
+/** \file
+ * \brief Tables of cached values that are initialized on first access
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace Dune {
+
+  namespace Impl {
+
+    /** \brief Table of entries that are initialized once, on first access
+     *
+     * The table consists of rows of entries. A row is allocated on the first
+     * access to one of its entries, such that a table only grows with the
+     * combinations in use. Each entry holds the value empty until it is
+     * initialized, guarded by its once_flag. Reading an initialized entry takes
+     * the acquire loads of the row and the entry, no lock.
+     *
+     * \tparam T type of the entries, e.g., a pointer or an enum
+     */
+    template<class T>
+    class LazyTable
+    {
+    public:
+      //! entries of one row, the number of entries is fixed when the row is allocated
+      struct Row
+      {
+        Row (std::size_t size, T empty)
+          : size(size)
+          , entries(std::make_unique<std::atomic<T>[]>(size))
+          , onceFlags(std::make_unique<std::once_flag[]>(size))
+        {
+          for (std::size_t i = 0; i < size; ++i)
+            entries[i].store(empty, std::memory_order_relaxed);
+        }
+
+        std::size_t size;
+        std::unique_ptr<std::atomic<T>[]> entries;
+        std::unique_ptr<std::once_flag[]> onceFlags;
+      };
+
+      //! table of numRows rows, none of which is allocated yet
+      LazyTable (std::size_t numRows, T empty)
+        : numRows_(numRows)
+        , empty_(empty)
+        , rows_(std::make_unique<std::atomic<const Row*>[]>(numRows))
+        , onceFlags_(std::make_unique<std::once_flag[]>(numRows))
+      {
+        for (std::size_t r = 0; r < numRows_; ++r)
+          rows_[r].store(nullptr, std::memory_order_relaxed);
+      }
+
+      ~LazyTable ()
+      {
+        for (std::size_t r = 0; r < numRows_; ++r)
+          delete rows_[r].load(std::memory_order_relaxed);
+      }
+
+      LazyTable (const LazyTable&) = delete;
+      LazyTable& operator= (const LazyTable&) = delete;
+
+      /** \brief Row r, allocated on first access
+       *
+       * \param size returns the number of entries of the row
+       */
+      template<class Size>
+      const Row& row (std::size_t r, Size&& size) const
+      {
+        if (const Row* row = rows_[r].load(std::memory_order_acquire))
+          return *row;
+
+        std::call_once(onceFlags_[r], [&]{
+          rows_[r].store(new Row(size(), empty_), std::memory_order_release);
+        });
+        return *rows_[r].load(std::memory_order_acquire);
+      }
+
+      //! row r if it has been allocated, otherwise nullptr
+      const Row* find (std::size_t r) const
+      {
+        return rows_[r].load(std::memory_order_acquire);
+      }
+
+      /** \brief Entry i of the row, initialized on first access
+       *
+       * \param init returns the value of the entry, it is called once only
+       *             unless it throws
+       */
+      template<class Init>
+      T entry (const Row& row, std::size_t i, Init&& init) const
+      {
+        const T value = row.entries[i].load(std::memory_order_acquire);
+        if (value != empty_)
+          return value;
+
+        std::call_once(row.onceFlags[i], [&]{
+          row.entries[i].store(init(), std::memory_order_release);
+        });
+        return row.entries[i].load(std::memory_order_acquire);
+      }
+
+      //! number of rows
+      std::size_t numRows () const { return numRows_; }
+
+      //! value of the entries that are not initialized
+      T empty () const { return empty_; }
+
+    private:
+      std::size_t numRows_;
+      T empty_;
+      std::unique_ptr<std::atomic<const Row*>[]> rows_;
+      std::unique_ptr<std::once_flag[]> onceFlags_;
+    };
+
+    /** \brief LazyTable of objects that are created on first access and owned by the table
+     *
+     * The objects live as long as the table and never move, references to
+     * them stay valid.
+     */
+    template<class Value>
+    class LazyObjectTable
+      : public LazyTable<const Value*>
+    {
+      using Base = LazyTable<const Value*>;
+
+    public:
+      using Row = typename Base::Row;
+
+      explicit LazyObjectTable (std::size_t numRows)
+        : Base(numRows, nullptr)
+      {}
+
+      ~LazyObjectTable ()
+      {
+        for (std::size_t r = 0; r < this->numRows(); ++r)
+          if (const Row* row = this->find(r))
+            for (std::size_t i = 0; i < row->size; ++i)
+              delete row->entries[i].load(std::memory_order_relaxed);
+      }
+
+      //! object i of the row, create() returns it on first access
+      template<class Create>
+      const Value& object (const Row& row, std::size_t i, Create&& create) const
+      {
+        return *this->entry(row, i, [&]{ return new const Value(create()); });
+      }
+    };
+
+  } // end namespace Impl
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_LAZYTABLE_HH
@@ -0,0 +1,463 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_MAPQUADRATURE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_MAPQUADRATURE_HH
+
+/** \file
+ * \brief Map all points and weights of a quadrature rule onto a geometry in one pass
+ */
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/diagonalmatrix.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/geometry/affinegeometry.hh>
+#include <dune/geometry/axisalignedcubegeometry.hh>
+#include <dune/geometry/localfiniteelementgeometry.hh>
+#include <dune/geometry/mappedgeometry.hh>
+#include <dune/geometry/multilineargeometry.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+namespace Dune {
+
+  namespace Impl {
+
+    //! placeholder for the Jacobians if they are not requested
+    struct NoJacobianInverseTransposed {};
+
+    template<class ctype, int m, int n>
+    const FieldMatrix<ctype,m,n>& asFieldMatrix (const FieldMatrix<ctype,m,n>& matrix)
+    {
+      return matrix;
+    }
+
+    template<class ctype, int n>
+    FieldMatrix<ctype,n,n> asFieldMatrix (const DiagonalMatrix<ctype,n>& matrix)
+    {
+      FieldMatrix<ctype,n,n> result(0);
+      for (int i = 0; i < n; ++i)
+        result[i][i] = matrix.diagonal(i);
+      return result;
+    }
+
+    //! the Jacobian is constant, the points are mapped by a single matrix-vector product each
+    template<class Geometry, class Rule, class Points, class Weights, class JacobianInverseTransposeds>
+    void mapQuadratureAffine (const Geometry& geometry, const Rule& rule,
+                              Points& points, Weights& weights, JacobianInverseTransposeds& jacobianInverseTransposeds)
+    {
+      typedef typename Geometry::ctype ctype;
+      constexpr int mydim = Geometry::mydimension;
+      constexpr int cdim = Geometry::coorddimension;
+      typedef Impl::FieldMatrixHelper<ctype> MatrixHelper;
+
+      const FieldVector<ctype,mydim> x0(0);
+      const FieldVector<ctype,cdim> origin = geometry.global(x0);
+      const FieldMatrix<ctype,mydim,cdim> jacobianTransposed = geometry.jacobianTransposed(x0);
+      FieldMatrix<ctype,cdim,mydim> jacobianInverseTransposed;
+      const ctype integrationElement = MatrixHelper::rightInvA(jacobianTransposed, jacobianInverseTransposed);
+
+      const std::size_t size = rule.size();
+      for (std::size_t q = 0; q < size; ++q)
+      {
+        FieldVector<ctype,cdim> point = origin;
+        jacobianTransposed.umtv(rule[q].position(), point);
+        points[q] = point;
+        weights[q] = rule[q].weight() * integrationElement;
+        if constexpr (!std::is_same_v<JacobianInverseTransposeds, NoJacobianInverseTransposed>)
+          jacobianInverseTransposeds[q] = jacobianInverseTransposed;
+      }
+    }
+
+    //! affine cached multilinear geometries reuse their stored Jacobian, inverse and integration element
+    template<class ct, int mydim, int cdim, class Traits, class Rule, class Points, class Weights, class JacobianInverseTransposeds>
+    void mapQuadratureAffine (const CachedMultiLinearGeometry<ct,mydim,cdim,Traits>& geometry, const Rule& rule,
+                              Points& points, Weights& weights, JacobianInverseTransposeds& jacobianInverseTransposeds)
+    {
+      const FieldVector<ct,mydim> x0(0);
+      const FieldVector<ct,cdim> origin = geometry.corner(0);
+      const FieldMatrix<ct,mydim,cdim> jacobianTransposed = geometry.jacobianTransposed(x0);
+      FieldMatrix<ct,cdim,mydim> jacobianInverseTransposed;
+      // computing the inverse first stores the integration element with it
+      if constexpr (!std::is_same_v<JacobianInverseTransposeds, NoJacobianInverseTransposed>)
+        jacobianInverseTransposed = geometry.jacobianInverseTransposed(x0);
+      const ct integrationElement = geometry.integrationElement(x0);
+
+      const std::size_t size = rule.size();
+      for (std::size_t q = 0; q < size; ++q)
+      {
+        FieldVector<ct,cdim> point = origin;
+        jacobianTransposed.umtv(rule[q].position(), point);
+        points[q] = point;
+        weights[q] = rule[q].weight() * integrationElement;
+        if constexpr (!std::is_same_v<JacobianInverseTransposeds, NoJacobianInverseTransposed>)
+          jacobianInverseTransposeds[q] = jacobianInverseTransposed;
+      }
+    }
+
+    //! evaluates global() and jacobianTransposed() of any geometry at a point
+    template<class Geometry>
+    class GeometryEvaluator
+    {
+      typedef typename Geometry::ctype ctype;
+      constexpr static int mydim = Geometry::mydimension;
+      constexpr static int cdim = Geometry::coorddimension;
+
+    public:
+      explicit GeometryEvaluator (const Geometry& geometry)
+        : geometry_(geometry)
+      {}
+
+      void evaluate (const FieldVector<ctype,mydim>& x, FieldVector<ctype,cdim>& y, FieldMatrix<ctype,mydim,cdim>& jacobianTransposed) const
+      {
+        jacobianTransposed = geometry_.jacobianTransposed(x);
+        y = geometry_.global(x);
+      }
+
+    private:
+      const Geometry& geometry_;
+    };
+
+    /* The multilinear map of the subelement of dimension dim and its transposed
+     * Jacobian with respect to the scaled coordinates df*x
+     *
+     * The recursion over the dimensions is the one of MultiLinearGeometry, see
+     * MultiLinearGeometry::jacobianTransposed() for the pyramid case. The value
+     * and the Jacobian of each subelement are computed together, so every corner
+     * is visited once per point instead of once for global() and up to twice
+     * for jacobianTransposed().
+     */
+    template<class Traits, class ct, int mydim, int cdim, class CornerIterator>
+    void multiLinearMap (unsigned int, std::integral_constant<int,0>, CornerIterator& cit, const ct&,
+                         const FieldVector<ct,mydim>&, FieldVector<ct,cdim>& y, FieldMatrix<ct,mydim,cdim>&)
+    {
+      y = *cit;
+      ++cit;
+    }
+
+    template<class Traits, class ct, int mydim, int cdim, int dim, class CornerIterator>
+    void multiLinearMap (unsigned int topologyId, std::integral_constant<int,dim>, CornerIterator& cit, const ct& df,
+                         const FieldVector<ct,mydim>& x, FieldVector<ct,cdim>& y, FieldMatrix<ct,mydim,cdim>& jt)
+    {
+      const ct xn = df*x[dim-1];
+      const ct cxn = ct(1) - xn;
+
+      FieldVector<ct,cdim> bottom;
+      FieldMatrix<ct,mydim,cdim> bottomJt;
+      if (Impl::isPrism(topologyId, mydim, mydim-dim))
+      {
+        // (1-xn) times the bottom plus xn times the top
+        FieldVector<ct,cdim> top;
+        FieldMatrix<ct,mydim,cdim> topJt;
+        multiLinearMap<Traits>(topologyId, std::integral_constant<int,dim-1>(), cit, df, x, bottom, bottomJt);
+        multiLinearMap<Traits>(topologyId, std::integral_constant<int,dim-1>(), cit, df, x, top, topJt);
+        for (int j = 0; j < dim-1; ++j)
+        {
+          jt[j] = bottomJt[j];
+          jt[j] *= cxn;
+          jt[j].axpy(xn, topJt[j]);
+        }
+        jt[dim-1] = top;
+        jt[dim-1] -= bottom;
+        y = bottom;
+        y *= cxn;
+        y.axpy(xn, top);
+      }
+      else
+      {
+        assert(Impl::isPyramid(topologyId, mydim, mydim-dim));
+        // (1-xn) times the base at x/(1-xn) plus xn times the tip, the base at 0 in the tip
+        const bool tip = !(cxn > Traits::tolerance() || cxn < -Traits::tolerance());
+        const ct dfcxn = tip ? ct(0) : ct(df / cxn);
+        multiLinearMap<Traits>(topologyId, std::integral_constant<int,dim-1>(), cit, dfcxn, x, bottom, bottomJt);
+        const FieldVector<ct,cdim> top = *cit;
+        ++cit;
+        jt[dim-1] = top;
+        jt[dim-1] -= bottom;
+        for (int j = 0; j < dim-1; ++j)
+        {
+          jt[j] = bottomJt[j];
+          jt[dim-1].axpy(dfcxn*x[j], bottomJt[j]);
+        }
+        y = top;
+        y *= xn;
+        if (!tip)
+          y.axpy(cxn, bottom);
+      }
+    }
+
+    //! evaluates a multilinear geometry and its Jacobian in one pass over the corners
+    template<class ct, int mydim, int cdim, class Traits>
+    class MultiLinearGeometryEvaluator
+    {
+    public:
+      template<class Geometry>
+      explicit MultiLinearGeometryEvaluator (const Geometry& geometry)
+        : topologyId_(geometry.type().id())
+      {
+        for (int i = 0; i < geometry.corners(); ++i)
+          corners_[i] = geometry.corner(i);
+      }
+
+      void evaluate (const FieldVector<ct,mydim>& x, FieldVector<ct,cdim>& y, FieldMatrix<ct,mydim,cdim>& jacobianTransposed) const
+      {
+        auto cit = corners_.cbegin();
+        multiLinearMap<Traits>(topologyId_, std::integral_constant<int,mydim>(), cit, ct(1), x, y, jacobianTransposed);
+      }
+
+    private:
+      unsigned int topologyId_;
+      std::array<FieldVector<ct,cdim>, (1 << mydim)> corners_;
+    };
+
+    //! evaluates the shape functions and their Jacobians once per point
+    template<class LFE, int cdim>
+    class LocalFiniteElementGeometryEvaluator
+    {
+      typedef LocalFiniteElementGeometry<LFE,cdim> Geometry;
+      typedef typename Geometry::ctype ctype;
+      constexpr static int mydim = Geometry::mydimension;
+      typedef typename LFE::Traits::LocalBasisType::Traits LocalBasisTraits;
+
+    public:
+      explicit LocalFiniteElementGeometryEvaluator (const Geometry& geometry)
+        : geometry_(geometry)
+      {}
+
+      void evaluate (const FieldVector<ctype,mydim>& x, FieldVector<ctype,cdim>& y, FieldMatrix<ctype,mydim,cdim>& jacobianTransposed) const
+      {
+        thread_local std::vector<typename LocalBasisTraits::RangeType> shapeValues;
+        thread_local std::vector<typename LocalBasisTraits::JacobianType> shapeJacobians;
+        geometry_.localBasis().evaluateFunction(x, shapeValues);
+        geometry_.localBasis().evaluateJacobian(x, shapeJacobians);
+
+        const auto& coefficients = geometry_.coefficients();
+        assert(shapeValues.size() == coefficients.size() && shapeJacobians.size() == coefficients.size());
+        y = ctype(0);
+        jacobianTransposed = ctype(0);
+        for (std::size_t i = 0; i < coefficients.size(); ++i)
+        {
+          y.axpy(shapeValues[i], coefficients[i]);
+          for (int j = 0; j < mydim; ++j)
+            jacobianTransposed[j].axpy(shapeJacobians[i][0][j], coefficients[i]);
+        }
+      }
+
+    private:
+      const Geometry& geometry_;
+    };
+
+    template<class Geometry>
+    GeometryEvaluator<Geometry> geometryEvaluator (const Geometry& geometry)
+    {
+      return GeometryEvaluator<Geometry>(geometry);
+    }
+
+    template<class ct, int mydim, int cdim, class Traits>
+    MultiLinearGeometryEvaluator<ct,mydim,cdim,Traits> geometryEvaluator (const MultiLinearGeometry<ct,mydim,cdim,Traits>& geometry)
+    {
+      return MultiLinearGeometryEvaluator<ct,mydim,cdim,Traits>(geometry);
+    }
+
+    template<class ct, int mydim, int cdim, class Traits>
+    MultiLinearGeometryEvaluator<ct,mydim,cdim,Traits> geometryEvaluator (const CachedMultiLinearGeometry<ct,mydim,cdim,Traits>& geometry)
+    {
+      return MultiLinearGeometryEvaluator<ct,mydim,cdim,Traits>(geometry);
+    }
+
+    template<class LFE, int cdim>
+    LocalFiniteElementGeometryEvaluator<LFE,cdim> geometryEvaluator (const LocalFiniteElementGeometry<LFE,cdim>& geometry)
+    {
+      return LocalFiniteElementGeometryEvaluator<LFE,cdim>(geometry);
+    }
+
+    //! evaluates the wrapped geometry, and the mapping and its derivative at its image, once per point
+    template<class Map, class Geo>
+    class MappedGeometryEvaluator
+    {
+      typedef MappedGeometry<Map,Geo> Geometry;
+      typedef typename Geometry::ctype ctype;
+      constexpr static int mydim = Geometry::mydimension;
+      constexpr static int cdim = Geometry::coorddimension;
+      constexpr static int wrappedCdim = Geo::coorddimension;
+
+    public:
+      explicit MappedGeometryEvaluator (const Geometry& geometry)
+        : geometry_(geometry), wrapped_(geometryEvaluator(geometry.geometry()))
+      {}
+
+      void evaluate (const FieldVector<ctype,mydim>& x, FieldVector<ctype,cdim>& y, FieldMatrix<ctype,mydim,cdim>& jacobianTransposed) const
+      {
+        FieldVector<ctype,wrappedCdim> z;
+        FieldMatrix<ctype,mydim,wrappedCdim> wrappedJt;
+        wrapped_.evaluate(x, z, wrappedJt);
+        y = geometry_.mapping()(z);
+
+        // the chain rule J = DM(z) J_wrapped, stored transposed
+        const auto& dm = geometry_.derivativeMapping()(z);
+        for (int j = 0; j < mydim; ++j)
+          for (int i = 0; i < cdim; ++i)
+          {
+            jacobianTransposed[j][i] = ctype(0);
+            for (int k = 0; k < wrappedCdim; ++k)
+              jacobianTransposed[j][i] += dm[i][k] * wrappedJt[j][k];
+          }
+      }
+
+    private:
+      const Geometry& geometry_;
+      decltype(geometryEvaluator(std::declval<const Geo&>())) wrapped_;
+    };
+
+    template<class Map, class Geo>
+    MappedGeometryEvaluator<Map,Geo> geometryEvaluator (const MappedGeometry<Map,Geo>& geometry)
+    {
+      return MappedGeometryEvaluator<Map,Geo>(geometry);
+    }
+
+    /* Non-affine geometries, the map and its Jacobian are evaluated together once per point
+     *
+     * MultiLinearGeometry, CachedMultiLinearGeometry, LocalFiniteElementGeometry
+     * and MappedGeometry have evaluators that share the work of global() and
+     * jacobianTransposed(), the others are evaluated through their interface.
+     */
+    template<class Geometry, class Rule, class Points, class Weights, class JacobianInverseTransposeds>
+    void mapQuadrature (const Geometry& geometry, const Rule& rule,
+                        Points& points, Weights& weights, JacobianInverseTransposeds& jacobianInverseTransposeds)
+    {
+      if (geometry.affine())
+        return mapQuadratureAffine(geometry, rule, points, weights, jacobianInverseTransposeds);
+
+      typedef typename Geometry::ctype ctype;
+      constexpr int mydim = Geometry::mydimension;
+      constexpr int cdim = Geometry::coorddimension;
+      typedef Impl::FieldMatrixHelper<ctype> MatrixHelper;
+
+      const auto evaluator = geometryEvaluator(geometry);
+      const std::size_t size = rule.size();
+      for (std::size_t q = 0; q < size; ++q)
+      {
+        FieldVector<ctype,cdim> point;
+        FieldMatrix<ctype,mydim,cdim> jacobianTransposed;
+        evaluator.evaluate(rule[q].position(), point, jacobianTransposed);
+        points[q] = point;
+        if constexpr (!std::is_same_v<JacobianInverseTransposeds, NoJacobianInverseTransposed>)
+        {
+          FieldMatrix<ctype,cdim,mydim> jacobianInverseTransposed;
+          weights[q] = rule[q].weight() * MatrixHelper::rightInvA(jacobianTransposed, jacobianInverseTransposed);
+          jacobianInverseTransposeds[q] = jacobianInverseTransposed;
+        }
+        else
+          weights[q] = rule[q].weight() * MatrixHelper::sqrtDetAAT(jacobianTransposed);
+      }
+    }
+
+    //! affine geometries store their Jacobians
+    template<class ct, int mydim, int cdim, class Rule, class Points, class Weights, class JacobianInverseTransposeds>
+    void mapQuadrature (const AffineGeometry<ct,mydim,cdim>& geometry, const Rule& rule,
+                        Points& points, Weights& weights, JacobianInverseTransposeds& jacobianInverseTransposeds)
+    {
+      const FieldVector<ct,mydim> x0(0);
+      const FieldVector<ct,cdim> origin = geometry.global(x0);
+      const auto& jacobianTransposed = geometry.jacobianTransposed(x0);
+      const ct integrationElement = geometry.integrationElement(x0);
+
+      const std::size_t size = rule.size();
+      for (std::size_t q = 0; q < size; ++q)
+      {
+        FieldVector<ct,cdim> point = origin;
+        jacobianTransposed.umtv(rule[q].position(), point);
+        points[q] = point;
+        weights[q] = rule[q].weight() * integrationElement;
+        if constexpr (!std::is_same_v<JacobianInverseTransposeds, NoJacobianInverseTransposed>)
+          jacobianInverseTransposeds[q] = geometry.jacobianInverseTransposed(x0);
+      }
+    }
+
+    //! axis-aligned cubes scale every direction separately
+    template<class ct, unsigned int mydim, unsigned int cdim, class Rule, class Points, class Weights, class JacobianInverseTransposeds>
+    void mapQuadrature (const AxisAlignedCubeGeometry<ct,mydim,cdim>& geometry, const Rule& rule,
+                        Points& points, Weights& weights, JacobianInverseTransposeds& jacobianInverseTransposeds)
+    {
+      const FieldVector<ct,mydim> x0(0);
+      const ct integrationElement = geometry.integrationElement(x0);
+      const FieldMatrix<ct,cdim,mydim> jacobianInverseTransposed = asFieldMatrix(geometry.jacobianInverseTransposed(x0));
+
+      const std::size_t size = rule.size();
+      for (std::size_t q = 0; q < size; ++q)
+      {
+        points[q] = geometry.global(rule[q].position());
+        weights[q] = rule[q].weight() * integrationElement;
+        if constexpr (!std::is_same_v<JacobianInverseTransposeds, NoJacobianInverseTransposed>)
+          jacobianInverseTransposeds[q] = jacobianInverseTransposed;
+      }
+    }
+
+  } // end namespace Impl
+
+  /** \brief Map the points of a quadrature rule onto a geometry and scale the weights by the integration element
+   *  \ingroup Quadrature
+   *
+   * After the call, `points[q]` holds `geometry.global(rule[q].position())` and
+   * `weights[q]` holds `rule[q].weight() * geometry.integrationElement(rule[q].position())`.
+   * The function makes one pass over the rule and allocates no memory apart
+   * from the reused shape function buffers of a LocalFiniteElementGeometry, the
+   * output ranges have to provide at least rule.size() entries:
+   * \code{.cpp}
+   * std::vector<FieldVector<double,3> > points(quad.size());
+   * std::vector<double> weights(quad.size());
+   * mapQuadrature(geometry, quad, points, weights);
+   * for (std::size_t q = 0; q < quad.size(); ++q)
+   *   integral += f(points[q]) * weights[q];
+   * \endcode
+   *
+   * Affine geometries, including AffineGeometry and AxisAlignedCubeGeometry
+   * objects, evaluate their Jacobian only once, affine CachedMultiLinearGeometry
+   * objects reuse their stored Jacobian and integration element. Non-affine
+   * MultiLinearGeometry, CachedMultiLinearGeometry, LocalFiniteElementGeometry
+   * and MappedGeometry objects compute the point and the Jacobian together,
+   * evaluating the corners or the shape functions and their derivatives once per
+   * point. Other geometries are evaluated by global() and jacobianTransposed().
+   *
+   * \param geometry  geometry with a FieldMatrix or DiagonalMatrix Jacobian
+   * \param rule      quadrature rule on the reference element of the geometry
+   * \param points    random-access range, assignable from FieldVector<ctype,coorddimension>
+   * \param weights   random-access range, assignable from ctype
+   */
+  template<class Geometry, class Points, class Weights>
+  void mapQuadrature (const Geometry& geometry,
+                      const QuadratureRule<typename Geometry::ctype, Geometry::mydimension>& rule,
+                      Points&& points, Weights&& weights)
+  {
+    Impl::NoJacobianInverseTransposed noJacobians;
+    Impl::mapQuadrature(geometry, rule, points, weights, noJacobians);
+  }
+
+  /** \brief Map a quadrature rule onto a geometry together with the transposed inverse Jacobians
+   *  \ingroup Quadrature
+   *
+   * In addition to mapQuadrature(geometry, rule, points, weights), this stores
+   * `geometry.jacobianInverseTransposed(rule[q].position())` in
+   * `jacobianInverseTransposeds[q]`, as a FieldMatrix<ctype,coorddimension,mydimension>.
+   * The inverse is computed along with the integration element from the same
+   * Jacobian.
+   */
+  template<class Geometry, class Points, class Weights, class JacobianInverseTransposeds>
+  void mapQuadrature (const Geometry& geometry,
+                      const QuadratureRule<typename Geometry::ctype, Geometry::mydimension>& rule,
+                      Points&& points, Weights&& weights, JacobianInverseTransposeds&& jacobianInverseTransposeds)
+  {
+    Impl::mapQuadrature(geometry, rule, points, weights, jacobianInverseTransposeds);
+  }
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_MAPQUADRATURE_HH
@@ -0,0 +1,387 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_NESTEDQUADRATURE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_NESTEDQUADRATURE_HH
+
+#ifndef DUNE_INCLUDING_IMPLEMENTATION
+#error This is a private header that should not be included directly.
+#error Use #include <dune/geometry/quadraturerules.hh> instead.
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/math.hh>
+
+namespace Dune {
+
+  namespace Impl {
+
+    // Points and weights of a 1d rule on [0,1] together with the weights of the
+    // rule embedded in it. The embedded rule uses a subset of the points, its
+    // weights are zero at all other points.
+    template<class ct>
+    struct NestedLineRule
+    {
+      std::vector<ct> points;
+      std::vector<ct> weights;
+      std::vector<ct> embeddedWeights;
+      int order = 0;
+      // -1 if there is no embedded rule
+      int embeddedOrder = -1;
+    };
+
+    // Weights of the interpolatory rule on [-1,1] for the given points
+    template<class ct>
+    std::vector<ct> interpolatoryWeights (const std::vector<ct>& points)
+    {
+      const int n = points.size();
+      std::vector<ct> gaussPoints, gaussWeights;
+      gaussLegendreLine(n/2+1, gaussPoints, gaussWeights);
+
+      std::vector<ct> weights(n, ct(0));
+      for (int i = 0; i < n; ++i)
+        for (std::size_t q = 0; q < gaussPoints.size(); ++q)
+        {
+          ct lagrange = gaussWeights[q];
+          for (int j = 0; j < n; ++j)
+            if (j != i)
+              lagrange *= (gaussPoints[q] - points[j]) / (points[i] - points[j]);
+          weights[i] += lagrange;
+        }
+      return weights;
+    }
+
+    /* Points of the Kronrod extension of a symmetric rule on [-1,1]
+     *
+     * Computes the m+1 points y such that the rule on the m given points x
+     * together with y is exact for polynomials of degree 3m+1, i.e., the node
+     * polynomial w(y) is orthogonal to all polynomials of degree m for the
+     * weight w(x). Extending the Gauss-Legendre rules gives the Gauss-Kronrod
+     * rules, repeatedly extending the midpoint rule the Gauss-Patterson rules.
+     * The positive new points are found by Newton's method, started in the
+     * middle of the gaps between the given points, which they interlace.
+     */
+    template<class ct>
+    std::vector<ct> kronrodExtension (const std::vector<ct>& x)
+    {
+      using std::abs; using std::acos; using std::cos; using std::max;
+      const ct eps = std::numeric_limits<ct>::epsilon();
+      const int m = x.size();
+
+      // by symmetry the odd parity of w(x)*w(y) leaves one condition for every odd degree
+      const bool zeroPoint = (m % 2 == 0);
+      const int r = m - m/2;
+      std::vector<ct> y(r);
+      for (int j = 0; j < r; ++j)
+      {
+        const int gap = m/2 + 1 + j;
+        const ct a = x[gap-1];
+        const ct b = (gap < m) ? x[gap] : ct(1);
+        y[j] = cos((acos(a) + acos(b)) / ct(2));
+      }
+
+      std::vector<ct> gaussPoints, gaussWeights, p;
+      gaussLegendreLine((3*m+3)/2 + 2, gaussPoints, gaussWeights);
+
+      for (int iteration = 0; iteration < 100; ++iteration)
+      {
+        DynamicMatrix<ct> jacobian(r, r, ct(0));
+        DynamicVector<ct> residual(r, ct(0));
+        for (std::size_t q = 0; q < gaussPoints.size(); ++q)
+        {
+          const ct& t = gaussPoints[q];
+          ct weight = gaussWeights[q] * (zeroPoint ? ct(2)*t : ct(1));
+          for (const ct& xi : x)
+            weight *= ct(2) * (t - xi);
+          legendrePolynomials(m, t, p);
+
+          for (int j = 0; j < r; ++j)
+          {
+            // derivative of the node polynomial with respect to y[j]
+            ct derivative = ct(-8) * y[j] * weight;
+            for (int l = 0; l < r; ++l)
+              if (l != j)
+                derivative *= ct(4) * (t*t - y[l]*y[l]);
+            for (int i = 0; i < r; ++i)
+              jacobian[i][j] += derivative * p[2*i+1];
+          }
+
+          for (int l = 0; l < r; ++l)
+            weight *= ct(4) * (t*t - y[l]*y[l]);
+          for (int i = 0; i < r; ++i)
+            residual[i] += weight * p[2*i+1];
+        }
+
+        DynamicVector<ct> dy(r);
+        jacobian.solve(dy, residual);
+        ct change = 0;
+        for (int j = 0; j < r; ++j)
+        {
+          y[j] -= dy[j];
+          change = max(change, abs(dy[j]));
+        }
+        if (change <= eps)
+          break;
+      }
+
+      std::vector<ct> extension;
+      extension.reserve(m+1);
+      for (int j = r-1; j >= 0; --j)
+        extension.push_back(-y[j]);
+      if (zeroPoint)
+        extension.push_back(ct(0));
+      for (int j = 0; j < r; ++j)
+        extension.push_back(y[j]);
+      return extension;
+    }
+
+    // Map a rule on [-1,1] with its embedded weights to [0,1]
+    template<class ct>
+    NestedLineRule<ct> nestedLineRuleOnUnitInterval (const std::vector<ct>& points, const std::vector<ct>& weights,
+                                                     const std::vector<ct>& embeddedWeights, int order, int embeddedOrder)
+    {
+      NestedLineRule<ct> rule;
+      rule.order = order;
+      rule.embeddedOrder = embeddedOrder;
+      for (std::size_t i = 0; i < points.size(); ++i)
+      {
+        rule.points.push_back((ct(1) + points[i]) / ct(2));
+        rule.weights.push_back(weights[i] / ct(2));
+        rule.embeddedWeights.push_back(embeddedWeights[i] / ct(2));
+      }
+      return rule;
+    }
+
+    // Union of two sets of points in ascending order, the weights of the first set are kept
+    template<class ct>
+    void mergeEmbeddedPoints (const std::vector<ct>& points, const std::vector<ct>& weights, const std::vector<ct>& newPoints,
+                              std::vector<ct>& mergedPoints, std::vector<ct>& mergedWeights)
+    {
+      std::vector<std::pair<ct, ct>> merged;
+      for (std::size_t i = 0; i < points.size(); ++i)
+        merged.emplace_back(points[i], weights[i]);
+      for (const ct& point : newPoints)
+        merged.emplace_back(point, ct(0));
+      std::sort(merged.begin(), merged.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+      mergedPoints.clear();
+      mergedWeights.clear();
+      for (const auto& [point, weight] : merged)
+      {
+        mergedPoints.push_back(point);
+        mergedWeights.push_back(weight);
+      }
+    }
+
+    constexpr int gaussKronrodMaxOrder = 191;
+    constexpr int gaussPattersonMaxOrder = 47;
+    constexpr int clenshawCurtisMaxOrder = 129;
+
+    // Gauss-Kronrod rule with 2n+1 points and the embedded n-point Gauss-Legendre rule
+    template<class ct>
+    NestedLineRule<ct> gaussKronrodLineRule (int p)
+    {
+      int n = 1;
+      while (3*n + 1 + n%2 < p)
+        ++n;
+
+      std::vector<ct> gaussPoints, gaussWeights;
+      gaussLegendreLine(n, gaussPoints, gaussWeights);
+
+      std::vector<ct> points, embeddedWeights;
+      mergeEmbeddedPoints(gaussPoints, gaussWeights, kronrodExtension(gaussPoints), points, embeddedWeights);
+      return nestedLineRuleOnUnitInterval(points, interpolatoryWeights(points), embeddedWeights, 3*n + 1 + n%2, 2*n - 1);
+    }
+
+    // Gauss-Patterson rule with 2^(l+1)-1 points and the embedded rule of level l-1
+    template<class ct>
+    NestedLineRule<ct> gaussPattersonLineRule (int p)
+    {
+      std::vector<ct> points(1, ct(0));
+      std::vector<ct> weights(1, ct(2));
+      std::vector<ct> embeddedWeights(1, ct(0));
+      int order = 1;
+      int embeddedOrder = -1;
+      while (order < p)
+      {
+        mergeEmbeddedPoints(points, weights, kronrodExtension(points), points, embeddedWeights);
+        weights = interpolatoryWeights(points);
+        embeddedOrder = order;
+        order = 3*(points.size()+1)/2 - 1;
+      }
+      return nestedLineRuleOnUnitInterval(points, weights, embeddedWeights, order, embeddedOrder);
+    }
+
+    // Weights of the Clenshaw-Curtis rule on [-1,1] with the n+1 points cos(j*pi/n)
+    template<class ct>
+    std::vector<ct> clenshawCurtisWeights (int n)
+    {
+      using std::cos;
+      const ct pi = MathematicalConstants<ct>::pi();
+      std::vector<ct> weights(n+1);
+      for (int j = 0; j <= n/2; ++j)
+      {
+        ct sum = ct(1);
+        for (int k = 1; k <= n/2; ++k)
+        {
+          const ct b = (2*k == n) ? ct(1) : ct(2);
+          sum -= b / ct(4*k*k - 1) * cos(ct(2*k*j) * pi / ct(n));
+        }
+        const ct c = (j == 0) ? ct(1) : ct(2);
+        weights[j] = weights[n-j] = c * sum / ct(n);
+      }
+      return weights;
+    }
+
+    // Clenshaw-Curtis rule with 2^l+1 points and the embedded rule of level l-1
+    template<class ct>
+    NestedLineRule<ct> clenshawCurtisLineRule (int p)
+    {
+      using std::cos;
+      const ct pi = MathematicalConstants<ct>::pi();
+
+      // the midpoint rule is level 0
+      if (p <= 1)
+        return nestedLineRuleOnUnitInterval<ct>({ ct(0) }, { ct(2) }, { ct(0) }, 1, -1);
+
+      int n = 2;
+      while (n+1 < p)
+        n *= 2;
+
+      std::vector<ct> points(n+1);
+      for (int j = 0; j <= n/2; ++j)
+      {
+        points[j] = -cos(ct(j) * pi / ct(n));
+        points[n-j] = -points[j];
+      }
+      points[n/2] = ct(0);
+
+      std::vector<ct> embeddedWeights(n+1, ct(0));
+      if (n == 2)
+        embeddedWeights[1] = ct(2);
+      else
+      {
+        const std::vector<ct> coarseWeights = clenshawCurtisWeights<ct>(n/2);
+        for (int j = 0; j <= n/2; ++j)
+          embeddedWeights[2*j] = coarseWeights[j];
+      }
+      return nestedLineRuleOnUnitInterval(points, clenshawCurtisWeights<ct>(n), embeddedWeights, n+1, (n == 2) ? 1 : n/2+1);
+    }
+
+    inline int nestedLineRuleMaxOrder (QuadratureType::Enum qt)
+    {
+      switch (qt) {
+      case QuadratureType::GaussKronrod :
+        return gaussKronrodMaxOrder;
+      case QuadratureType::GaussPatterson :
+        return gaussPattersonMaxOrder;
+      case QuadratureType::ClenshawCurtis :
+        return clenshawCurtisMaxOrder;
+      default :
+        DUNE_THROW(Exception, "QuadratureType " << qt << " has no embedded rules");
+      }
+    }
+
+    // number of points of the rule of order p, following the choice of the rules above
+    inline std::size_t nestedLineRuleSize (int p, QuadratureType::Enum qt)
+    {
+      if (p < 0 || p > nestedLineRuleMaxOrder(qt))
+        DUNE_THROW(QuadratureOrderOutOfRange, "Quadrature rule " << p << " not supported!");
+      switch (qt) {
+      case QuadratureType::GaussKronrod : {
+        int n = 1;
+        while (3*n + 1 + n%2 < p)
+          ++n;
+        return 2*n + 1;
+      }
+      case QuadratureType::GaussPatterson : {
+        std::size_t size = 1;
+        for (int order = 1; order < p; order = 3*(int(size)+1)/2 - 1)
+          size = 2*size + 1;
+        return size;
+      }
+      default : {
+        if (p <= 1)
+          return 1;
+        std::size_t n = 2;
+        while (int(n)+1 < p)
+          n *= 2;
+        return n+1;
+      }
+      }
+    }
+
+    template<class ct>
+    NestedLineRule<ct> nestedLineRule (int p, QuadratureType::Enum qt)
+    {
+      if (p < 0 || p > nestedLineRuleMaxOrder(qt))
+        DUNE_THROW(QuadratureOrderOutOfRange, "Quadrature rule " << p << " not supported!");
+      switch (qt) {
+      case QuadratureType::GaussKronrod :
+        return gaussKronrodLineRule<ct>(p);
+      case QuadratureType::GaussPatterson :
+        return gaussPattersonLineRule<ct>(p);
+      default :
+        return clenshawCurtisLineRule<ct>(p);
+      }
+    }
+
+  } // end namespace Impl
+
+  /************************************************
+   * Quadraturerule for 1d line
+   *************************************************/
+
+  template<typename ct, int dim>
+  class NestedQuadratureRule;
+
+  template<typename ct>
+  using NestedQuadratureRule1D = NestedQuadratureRule<ct,1>;
+
+  /** \brief Rules of the embedded families GaussKronrod, GaussPatterson and ClenshawCurtis
+   *
+   * The points and weights are computed at run time for the number type ct.
+   * The rule of the next lower level, resp. the Gauss-Legendre rule for
+   * Gauss-Kronrod, uses a subset of the points. Both together are provided by
+   * EmbeddedQuadratureRule.
+   */
+  template<typename ct>
+  class NestedQuadratureRule<ct,1> : public QuadratureRule<ct,1>
+  {
+  public:
+    // compile time parameters
+    constexpr static int dim = 1;
+
+    //! The highest quadrature order available for the quadrature type
+    static unsigned maxOrder (QuadratureType::Enum qt)
+    {
+      return Impl::nestedLineRuleMaxOrder(qt);
+    }
+
+  private:
+    friend class QuadratureRuleFactory<ct,dim>;
+
+    NestedQuadratureRule (int p, QuadratureType::Enum qt)
+      : QuadratureRule<ct,1>(GeometryTypes::line)
+    {
+      const Impl::NestedLineRule<ct> rule = Impl::nestedLineRule<ct>(p, qt);
+      this->delivered_order = rule.order;
+      this->reserve(rule.points.size());
+      for (std::size_t i = 0; i < rule.points.size(); ++i)
+        this->push_back(QuadraturePoint<ct,dim>(FieldVector<ct,dim>(rule.points[i]), rule.weights[i]));
+    }
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_NESTEDQUADRATURE_HH
@@ -16,7 +16,7 @@ namespace Dune::Impl {
 
 //! Construct the number type `ct` from `double` or from a character sequence
 template<typename ct>
-ct numberFromString([[maybe_unused]] double value, [[maybe_unused]] const char* str)
+constexpr ct numberFromString([[maybe_unused]] double value, [[maybe_unused]] const char* str)
 {
   if constexpr(std::is_constructible_v<ct,const char*>)
     return ct{str};
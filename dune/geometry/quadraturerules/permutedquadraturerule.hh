@@ -0,0 +1,275 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_PERMUTEDQUADRATURERULE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_PERMUTEDQUADRATURERULE_HH
+
+/** \file
+ * \brief Quadrature points of a reference element seen with a permuted vertex numbering
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/geometry/multilineargeometry.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/quadraturerules/lazytable.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+#include <dune/geometry/typeindex.hh>
+
+namespace Dune {
+
+  /** \brief Quadrature rule on a reference element mapped by a symmetry of its vertices
+   *  \ingroup Quadrature
+   *
+   * Two elements sharing a face in general number the vertices of the face
+   * differently, e.g., as described by their GeneralVertexOrder. Given the
+   * vertex permutation, such that vertex i of the first numbering is vertex
+   * permutation[i] of the second one, this class stores the positions of the
+   * points of a rule on the face in the coordinates of the second numbering.
+   * If the rule is invariant under the symmetry, as the symmetric rules of
+   * QuadratureRules are, the mapped points are points of the rule again, and
+   * permutation() gives their indices. Then a point of the rule on the face of
+   * one element is matched with a point of the same rule on the face of the
+   * other element by a table lookup:
+   * \code{.cpp}
+   * const auto vertexPermutation = PermutedQuadratureRule<double,2>::vertexPermutation(insideOrder, outsideOrder);
+   * const auto& permuted = PermutedQuadratureRule<double,2>::rule(faceType, vertexPermutation, order);
+   * // point q of the inside face is point permuted.permutation()[q] of the outside face
+   * \endcode
+   * With the index of the symmetry, e.g., computed once per face by
+   * symmetryIndex(), the lookup does not compare permutations:
+   * \code{.cpp}
+   * const auto& permuted = PermutedQuadratureRule<double,2>::rule(faceType, symmetry, order);
+   * \endcode
+   *
+   * Only the symmetries of the reference element, listed by symmetries(), map
+   * faces of conforming elements onto each other.
+   *
+   * \tparam ctype Type used for coordinates and quadrature weights
+   * \tparam dim Dimension of the reference element, i.e., of the face
+   */
+  template<class ctype, int dim>
+  class PermutedQuadratureRule
+  {
+  public:
+    //! type of the positions
+    typedef FieldVector<ctype,dim> Coordinate;
+
+    /** \brief Map the rule of order p of type qt on the reference element of type t by a vertex permutation
+     *
+     * \throws NotImplemented if the permutation is not a symmetry of the reference element
+     * \throws QuadratureOrderOutOfRange if the order is not available
+     */
+    PermutedQuadratureRule (const GeometryType& t, const std::vector<int>& vertexPermutation, int p,
+                            QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+      : type_(t), vertexPermutation_(vertexPermutation)
+    {
+      assert(t.dim() == dim);
+      if (!isSymmetry(t, vertexPermutation))
+        DUNE_THROW(NotImplemented, "The vertex permutation is no symmetry of the reference element " << t);
+
+      const auto refElement = ReferenceElements<ctype,dim>::general(t);
+      std::vector<Coordinate> corners;
+      for (int i : vertexPermutation)
+        corners.push_back(refElement.position(i, dim));
+      const MultiLinearGeometry<ctype,dim,dim> symmetry(t, corners);
+
+      const QuadratureRule<ctype,dim>& quad = QuadratureRules<ctype,dim>::rule(t, p, qt);
+      order_ = quad.order();
+      using std::abs;
+      const ctype tolerance = 64 * std::numeric_limits<ctype>::epsilon();
+      for (const auto& qp : quad)
+      {
+        const Coordinate x = symmetry.global(qp.position());
+        positions_.push_back(x);
+
+        int match = -1;
+        for (std::size_t j = 0; j < quad.size() && match < 0; ++j)
+          if ((quad[j].position() - x).infinity_norm() <= tolerance
+              && abs(quad[j].weight() - qp.weight()) <= tolerance * abs(qp.weight()))
+            match = j;
+        permutation_.push_back(match);
+        isPermutation_ = isPermutation_ && (match >= 0);
+      }
+    }
+
+    //! type of the reference element
+    GeometryType type () const { return type_; }
+
+    //! vertex i of the first numbering is vertex vertexPermutation()[i] of the second one
+    const std::vector<int>& vertexPermutation () const { return vertexPermutation_; }
+
+    //! order of the rule
+    int order () const { return order_; }
+
+    //! number of quadrature points
+    std::size_t size () const { return positions_.size(); }
+
+    //! positions of the quadrature points in the coordinates of the second numbering
+    const std::vector<Coordinate>& positions () const { return positions_; }
+
+    //! index of the point of the rule at each position, -1 if there is none
+    const std::vector<int>& permutation () const { return permutation_; }
+
+    //! whether all positions are points of the rule, i.e., permutation() is a permutation
+    bool isPermutation () const { return isPermutation_; }
+
+    /** \brief Vertex permutation between two numberings of the vertices of the same entity
+     *
+     * The numberings are given by the reduced vertex orders, e.g., from
+     * GeneralVertexOrder::getReduced(), of both elements, which hold the rank
+     * of every vertex among the vertices of the entity.
+     */
+    template<class Index>
+    static std::vector<int> vertexPermutation (const std::vector<Index>& first, const std::vector<Index>& second)
+    {
+      assert(first.size() == second.size());
+      std::vector<int> permutation(first.size());
+      for (std::size_t i = 0; i < first.size(); ++i)
+        permutation[i] = std::find(second.begin(), second.end(), first[i]) - second.begin();
+      return permutation;
+    }
+
+    //! whether the vertex permutation maps every sub-entity of the reference element of type t onto a sub-entity
+    static bool isSymmetry (const GeometryType& t, const std::vector<int>& vertexPermutation)
+    {
+      const auto refElement = ReferenceElements<ctype,dim>::general(t);
+      if (int(vertexPermutation.size()) != refElement.size(dim))
+        return false;
+      std::vector<int> sorted = vertexPermutation;
+      std::sort(sorted.begin(), sorted.end());
+      for (std::size_t i = 0; i < sorted.size(); ++i)
+        if (sorted[i] != int(i))
+          return false;
+
+      std::vector<int> vertices, image;
+      for (int codim = 1; codim < dim; ++codim)
+        for (int i = 0; i < refElement.size(codim); ++i)
+        {
+          subEntityVertices(refElement, i, codim, vertices);
+          for (int& v : vertices)
+            v = vertexPermutation[v];
+          std::sort(vertices.begin(), vertices.end());
+
+          bool found = false;
+          for (int j = 0; j < refElement.size(codim) && !found; ++j)
+          {
+            subEntityVertices(refElement, j, codim, image);
+            found = (image == vertices);
+          }
+          if (!found)
+            return false;
+        }
+      return true;
+    }
+
+    //! all vertex permutations that are symmetries of the reference element of type t
+    static std::vector<std::vector<int> > symmetries (const GeometryType& t)
+    {
+      std::vector<int> permutation(ReferenceElements<ctype,dim>::general(t).size(dim));
+      std::iota(permutation.begin(), permutation.end(), 0);
+      std::vector<std::vector<int> > result;
+      do
+      {
+        if (isSymmetry(t, permutation))
+          result.push_back(permutation);
+      } while (std::next_permutation(permutation.begin(), permutation.end()));
+      return result;
+    }
+
+    /** \brief Cached rules of order p of type qt mapped by all symmetries of the reference element
+     *
+     * The rule at index i is mapped by the vertex permutation symmetries(t)[i].
+     * The rules of all symmetries are constructed at once on the first call
+     * and live until the end of the program. They are kept in a table like
+     * the rules of QuadratureRules, later calls take two atomic loads.
+     * Callers matching many faces may keep the index of the symmetry, see
+     * symmetryIndex(), instead of the vertex permutation.
+     * \note This method is thread-safe.
+     *
+     * \throws QuadratureOrderOutOfRange if the order is not available
+     */
+    static const std::vector<PermutedQuadratureRule>& rules (const GeometryType& t, int p,
+                                                             QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+    {
+      constexpr std::size_t numGeometryTypes = LocalGeometryTypeIndex::size(dim);
+      static const Impl::LazyObjectTable<std::vector<PermutedQuadratureRule> > table(std::size_t(QuadratureType::size) * numGeometryTypes);
+
+      assert(t.dim() == dim);
+      if (std::size_t(qt) >= std::size_t(QuadratureType::size))
+        DUNE_THROW(QuadratureOrderOutOfRange, "QuadratureType " << qt << " not available");
+      const auto& row = table.row(std::size_t(qt) * numGeometryTypes + LocalGeometryTypeIndex::index(t), [&]{
+        return t.isNone() ? std::size_t(0) : std::size_t(QuadratureRules<ctype,dim>::maxOrder(t, qt)) + 1;
+      });
+      if (p < 0 || std::size_t(p) >= row.size)
+        DUNE_THROW(QuadratureOrderOutOfRange, "QuadratureRule for order " << p << " and GeometryType " << t << " not available");
+
+      return table.object(row, p, [&]{
+        std::vector<PermutedQuadratureRule> permuted;
+        for (const auto& vertexPermutation : symmetries(t))
+          permuted.emplace_back(t, vertexPermutation, p, qt);
+        return permuted;
+      });
+    }
+
+    //! Cached rule mapped by the symmetry with index symmetry in symmetries(t), see rules()
+    static const PermutedQuadratureRule& rule (const GeometryType& t, int symmetry, int p,
+                                               QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+    {
+      const auto& permuted = rules(t, p, qt);
+      assert(symmetry >= 0 && std::size_t(symmetry) < permuted.size());
+      return permuted[symmetry];
+    }
+
+    /** \brief Cached rule mapped by a vertex permutation, see rules()
+     *
+     * \throws NotImplemented if the permutation is not a symmetry of the reference element
+     */
+    static const PermutedQuadratureRule& rule (const GeometryType& t, const std::vector<int>& vertexPermutation, int p,
+                                               QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+    {
+      for (const auto& permuted : rules(t, p, qt))
+        if (permuted.vertexPermutation() == vertexPermutation)
+          return permuted;
+      DUNE_THROW(NotImplemented, "The vertex permutation is no symmetry of the reference element " << t);
+    }
+
+    //! index of the vertex permutation in symmetries(t), -1 if it is no symmetry
+    static int symmetryIndex (const GeometryType& t, const std::vector<int>& vertexPermutation)
+    {
+      const auto all = symmetries(t);
+      const auto it = std::find(all.begin(), all.end(), vertexPermutation);
+      return it != all.end() ? int(it - all.begin()) : -1;
+    }
+
+  private:
+    template<class RefElement>
+    static void subEntityVertices (const RefElement& refElement, int i, int codim, std::vector<int>& vertices)
+    {
+      vertices.clear();
+      for (int k = 0; k < refElement.size(i, codim, dim); ++k)
+        vertices.push_back(refElement.subEntity(i, codim, k, dim));
+      std::sort(vertices.begin(), vertices.end());
+    }
+
+    GeometryType type_;
+    std::vector<int> vertexPermutation_;
+    int order_ = -1;
+    std::vector<Coordinate> positions_;
+    std::vector<int> permutation_;
+    bool isPermutation_ = true;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_PERMUTEDQUADRATURERULE_HH
@@ -10,34 +10,273 @@
 #error Use #include <dune/geometry/quadraturerules.hh> instead.
 #endif
 
+#include <cstddef>
+
+#include <dune/geometry/quadraturerules/simplexquadrature.hh>
+
 namespace Dune {
 
   /***********************************
    * quadrature for Prism
    **********************************/
 
-  /** \brief Quadrature rules for prisms
-      \ingroup Quadrature
-   */
-  template<typename ct, int dim>
-  class PrismQuadratureRule;
+  namespace Impl {
 
-  /** \brief Quadrature rules for prisms
-      \ingroup Quadrature
-   */
-  template<typename ct>
-  class PrismQuadratureRule<ct,3> : public QuadratureRule<ct,3>
-  {
-  public:
-    /** \brief The highest quadrature order available */
-    constexpr static int highest_order = 2;
+    /** \brief Orbit of points under the symmetries of a prism
+     *
+     * The orbit consists of the points of the SimplexOrbit of the given type
+     * and parameters a, b in the triangles at the heights z and 1-z, which
+     * coincide for z = 1/2.
+     */
+    struct PrismOrbit
+    {
+      SimplexOrbitType type;
+      double weight;
+      double z;
+      double a = 0.0;
+      double b = 0.0;
+    };
+
+    //! number of points of an orbit
+    constexpr int prismOrbitSize (const PrismOrbit& orbit)
+    {
+      return simplexOrbitSize(orbit.type) * (orbit.z == 0.5 ? 1 : 2);
+    }
 
-  private:
-    friend class QuadratureRuleFactory<ct,3>;
-    PrismQuadratureRule(int p);
-  };
+    //! symmetric rule of the given order on the prism, consisting of a list of orbits
+    struct SymmetricPrismRule
+    {
+      template<std::size_t n>
+      constexpr SymmetricPrismRule (int order, const PrismOrbit (&orbits)[n])
+        : order(order), numOrbits(n), orbits(orbits)
+      {}
+
+      //! number of points
+      constexpr int size () const
+      {
+        int size = 0;
+        for (int k = 0; k < numOrbits; ++k)
+          size += prismOrbitSize(orbits[k]);
+        return size;
+      }
+
+      int order;
+      int numOrbits;
+      const PrismOrbit* orbits;
+    };
+
+    //! total number of points of a list of rules
+    template<std::size_t n>
+    constexpr int symmetricPrismRulesSize (const SymmetricPrismRule (&rules)[n])
+    {
+      int size = 0;
+      for (std::size_t r = 0; r < n; ++r)
+        size += rules[r].size();
+      return size;
+    }
 
-  /** \todo Please doc me! */
+    //! index of the rule with m points in a list of rules, or -1
+    template<std::size_t n>
+    constexpr int findSymmetricPrismRule (const SymmetricPrismRule (&rules)[n], int m, int& offset)
+    {
+      offset = 0;
+      for (std::size_t r = 0; r < n; ++r)
+      {
+        if (rules[r].size() == m)
+          return r;
+        offset += rules[r].size();
+      }
+      return -1;
+    }
+
+    //! write the points and weights of an orbit, returns the number of points
+    constexpr int expandPrismOrbit (const PrismOrbit& orbit, double (*points)[3], double* weights)
+    {
+      double trianglePoints[6][2] = {};
+      double triangleWeights[6] = {};
+      const int n = expandSimplexOrbit<2>(SimplexOrbit{orbit.type, orbit.weight, orbit.a, orbit.b},
+                                          trianglePoints, triangleWeights);
+      const int layers = (orbit.z == 0.5) ? 1 : 2;
+      for (int l = 0; l < layers; ++l)
+        for (int i = 0; i < n; ++i)
+        {
+          points[l*n+i][0] = trianglePoints[i][0];
+          points[l*n+i][1] = trianglePoints[i][1];
+          points[l*n+i][2] = (l == 0) ? orbit.z : 1.0 - orbit.z;
+          weights[l*n+i] = triangleWeights[i];
+        }
+      return layers*n;
+    }
+
+    /* Symmetric rules for the prism.
+     *
+     * The rules are invariant under the symmetries of the triangle and the
+     * reflection z -> 1-z. All weights are positive and all points are in the
+     * interior of the prism. The rules have been computed in the same way as the
+     * symmetric rules of the pyramid, those of degree 6 and higher by eliminating
+     * orbits from the product of a symmetric rule of the triangle with a Gauss
+     * rule. They need a few points more than those given by
+     * F.D. Witherden, P.E. Vincent, On the identification of symmetric quadrature
+     * rules for finite element methods, Comput. Math. Appl. 69 (2015).
+     */
+
+    // polynomial degree 1, 1 point
+    constexpr PrismOrbit prismOrbits1[] = {
+      { SimplexOrbitType::S3, 5.0000000000000000000e-1, 5.0000000000000000000e-1 },
+    };
+
+    // polynomial degree 2, 5 points
+    constexpr PrismOrbit prismOrbits2[] = {
+      { SimplexOrbitType::S3, 1.1349387666818209882e-1, 7.1556887192226226257e-2 },
+      { SimplexOrbitType::S21, 9.1004082221211934121e-2, 5.0000000000000000000e-1, 1.0778340816303065059e-1 },
+    };
+
+    // polynomial degree 3, 8 points
+    constexpr PrismOrbit prismOrbits3[] = {
+      { SimplexOrbitType::S3, 1.0028129470523539632e-1, 4.4205148617806707234e-2 },
+      { SimplexOrbitType::S111, 4.9906235098254867892e-2, 5.0000000000000000000e-1, 7.4469448794191662358e-1, 1.7034779810048563413e-2 },
+    };
+
+    // polynomial degree 4, 11 points
+    constexpr PrismOrbit prismOrbits4[] = {
+      { SimplexOrbitType::S3, 5.3955987407767752394e-2, 6.6569012995482600792e-2 },
+      { SimplexOrbitType::S21, 3.1244351046041338436e-2, 1.6218008815887014130e-1, 1.0074040579891063627e-1 },
+      { SimplexOrbitType::S21, 6.8207306302738821533e-2, 5.0000000000000000000e-1, 4.6865580986199521227e-1 },
+    };
+
+    // polynomial degree 5, 16 points
+    constexpr PrismOrbit prismOrbits5[] = {
+      { SimplexOrbitType::S3, 8.8931944491435856245e-2, 5.0000000000000000000e-1 },
+      { SimplexOrbitType::S21, 2.3207677664519767484e-2, 6.4498532567277973635e-2, 4.4559810467037200376e-1 },
+      { SimplexOrbitType::S21, 3.1259285718474244890e-2, 2.1478650964742036397e-1, 1.0085894598270853092e-1 },
+      { SimplexOrbitType::S21, 2.8088758403533356503e-2, 5.0000000000000000000e-1, 4.8729996455024566612e-1 },
+    };
+
+    // polynomial degree 6, 29 points
+    constexpr PrismOrbit prismOrbits6[] = {
+      { SimplexOrbitType::S3, 2.7291816576131609225e-2, 3.8903892472672719625e-2 },
+      { SimplexOrbitType::S21, 2.1279626742140752475e-2, 2.6146577392065145473e-1, 4.7203157162728789085e-1 },
+      { SimplexOrbitType::S21, 2.8425825124186351563e-2, 3.5300323003384387357e-1, 2.0240357907244971788e-1 },
+      { SimplexOrbitType::S21, 1.2051146147871566806e-2, 5.0000000000000000000e-1, 4.7011593238062465062e-2 },
+      { SimplexOrbitType::S111, 9.2525181005132880754e-3, 8.5114614707842053493e-2, 2.8237937055364148278e-2, 2.0301257421198913405e-1 },
+    };
+
+    // polynomial degree 7, 39 points
+    constexpr PrismOrbit prismOrbits7[] = {
+      { SimplexOrbitType::S3, 4.4225084546846947291e-2, 1.9688023080754425350e-1 },
+      { SimplexOrbitType::S3, 1.3717949046227442043e-3, 5.0000000000000000000e-1 },
+      { SimplexOrbitType::S21, 1.0244922556798564969e-2, 1.2926308781363609250e-2, 1.5920788674207178822e-1 },
+      { SimplexOrbitType::S111, 9.3212269684388689815e-3, 1.5411106503883772651e-1, 4.5801956816322203286e-2, 5.4377620169113604267e-1 },
+      { SimplexOrbitType::S111, 5.8514322213090810272e-3, 2.1824030591514771396e-1, 1.1330689245643559163e-1, 8.4976851191484154635e-3 },
+      { SimplexOrbitType::S111, 2.7772765063986095216e-2, 5.0000000000000000000e-1, 9.7857191294441672535e-2, 6.3900666473500633267e-1 },
+    };
+
+    // polynomial degree 8, 51 points
+    constexpr PrismOrbit prismOrbits8[] = {
+      { SimplexOrbitType::S3, 1.1383902131190085796e-2, 2.4456642021522622211e-2 },
+      { SimplexOrbitType::S3, 2.8315302034911162469e-2, 5.0000000000000000000e-1 },
+      { SimplexOrbitType::S21, 1.0839290629932260317e-2, 9.2160521283106840220e-2, 4.6806354196745569268e-1 },
+      { SimplexOrbitType::S21, 3.1071431062087194651e-3, 1.8133218551093070073e-1, 2.9786277095496809220e-2 },
+      { SimplexOrbitType::S21, 2.4490182590159357856e-2, 2.3357359304453343855e-1, 2.0919466374836376791e-1 },
+      { SimplexOrbitType::S21, 1.3056250035999587430e-2, 5.0000000000000000000e-1, 8.6880342389682027577e-2 },
+      { SimplexOrbitType::S21, 2.0510724305883997503e-2, 5.0000000000000000000e-1, 4.6271861781662071551e-1 },
+      { SimplexOrbitType::S111, 4.0596447214164274748e-3, 3.7643000421647859605e-2, 5.3016417358872804849e-2, 7.6383658827963023262e-1 },
+      { SimplexOrbitType::S111, 5.7400446718548963013e-3, 2.9260699839274568648e-1, 2.6040000648867542639e-1, 1.4435909192826273943e-2 },
+    };
+
+    // polynomial degree 9, 62 points
+    constexpr PrismOrbit prismOrbits9[] = {
+      { SimplexOrbitType::S3, 2.0559108554452123750e-2, 3.4425430235661567376e-1 },
+      { SimplexOrbitType::S21, 1.2061863585890401901e-2, 6.8819071497516185627e-2, 4.1956517868393446844e-1 },
+      { SimplexOrbitType::S21, 3.7274582107461880648e-3, 1.2129090476647257392e-1, 4.4235196766086578527e-2 },
+      { SimplexOrbitType::S21, 5.6227451170651951938e-3, 1.6116835042167564125e-1, 4.9324318425536809532e-1 },
+      { SimplexOrbitType::S21, 1.8994244243477557658e-2, 2.5258640245650194379e-1, 1.8954252398049852439e-1 },
+      { SimplexOrbitType::S21, 5.3023430396787768620e-3, 5.0000000000000000000e-1, 4.5326399246519701779e-2 },
+      { SimplexOrbitType::S21, 2.1634306250417224008e-2, 5.0000000000000000000e-1, 4.5753284554938056037e-1 },
+      { SimplexOrbitType::S111, 3.3804120831220290762e-3, 2.0972023935046101166e-2, 5.6401713503885240456e-2, 7.1915944859278006550e-1 },
+      { SimplexOrbitType::S111, 4.8113696001510479086e-3, 2.4180686384173719893e-1, 2.7257960632540480258e-2, 7.4757453759131966521e-1 },
+      { SimplexOrbitType::S111, 6.2220979797424615284e-3, 5.0000000000000000000e-1, 4.2241937864062393751e-2, 7.4491004892895503355e-1 },
+    };
+
+    // polynomial degree 10, 91 points
+    constexpr PrismOrbit prismOrbits10[] = {
+      { SimplexOrbitType::S3, 5.8855941373606129948e-3, 6.8061127067017650197e-3 },
+      { SimplexOrbitType::S3, 1.8083934008523062185e-2, 3.0750609131818539602e-1 },
+      { SimplexOrbitType::S21, 3.1918973300299241254e-3, 2.4850606860079408819e-2, 1.2651190672528944456e-1 },
+      { SimplexOrbitType::S21, 6.8709170169487723408e-4, 3.8880184878795491835e-2, 2.4836428557741000737e-2 },
+      { SimplexOrbitType::S21, 8.9958091948523436562e-3, 9.3034874294418517426e-2, 4.4493688838965682189e-1 },
+      { SimplexOrbitType::S21, 1.3641067678175377792e-2, 1.7563553287465849239e-1, 2.0496477830230013124e-1 },
+      { SimplexOrbitType::S21, 2.4709105680337748573e-3, 5.0000000000000000000e-1, 2.4445122565345335730e-2 },
+      { SimplexOrbitType::S111, 2.6823084980994020586e-3, 4.1806722875365462556e-2, 2.9427211611013958518e-2, 6.6660320379769889711e-1 },
+      { SimplexOrbitType::S111, 3.3275613515903424887e-3, 1.8219989456365200347e-1, 1.1815794564474172939e-1, 2.2118300093363802963e-2 },
+      { SimplexOrbitType::S111, 4.6522525650750561695e-3, 2.8770798186084712833e-1, 1.8607900984399386332e-2, 6.0179465302846729069e-1 },
+      { SimplexOrbitType::S111, 5.8157561916117959689e-3, 3.8292648746044786138e-1, 1.8346431100295450872e-1, 5.8239250918763507068e-2 },
+      { SimplexOrbitType::S111, 7.3182061082580856661e-3, 4.2846449772543750481e-1, 1.2820609645365722548e-1, 3.3837332450267616579e-1 },
+    };
+
+    // polynomial degree 11, 107 points
+    constexpr PrismOrbit prismOrbits11[] = {
+      { SimplexOrbitType::S3, 9.5831639499647707779e-3, 1.0775143659220521264e-1 },
+      { SimplexOrbitType::S21, 3.6506326672418350978e-3, 1.0750477869188059521e-2, 2.2334727649840455246e-1 },
+      { SimplexOrbitType::S21, 1.2248912497877878156e-3, 1.3918825338522702357e-2, 4.8941610293680024353e-1 },
+      { SimplexOrbitType::S21, 2.1106451593839080046e-3, 4.3866103070694379976e-2, 5.4421532824897718522e-2 },
+      { SimplexOrbitType::S21, 1.0475534098508118777e-2, 2.2461168990367662105e-1, 1.4268864832336091371e-1 },
+      { SimplexOrbitType::S21, 6.8539951162663941213e-4, 2.3495371099450605366e-1, 1.0353786354730943977e-2 },
+      { SimplexOrbitType::S21, 1.2948858301461724209e-2, 3.4855126301746433202e-1, 2.5614304228970630338e-1 },
+      { SimplexOrbitType::S21, 5.9842667634060422575e-3, 5.0000000000000000000e-1, 6.0448741141780617312e-2 },
+      { SimplexOrbitType::S111, 3.5299717819168436355e-3, 6.0255352915110592461e-2, 4.3668371351871127384e-2, 2.4764068066833854209e-1 },
+      { SimplexOrbitType::S111, 5.8601343346106324113e-3, 1.2874676454232076702e-1, 5.0121537058336724540e-1, 1.1737332214959013291e-1 },
+      { SimplexOrbitType::S111, 2.2096579098914864347e-3, 2.3759665628358123277e-1, 1.4362581562677046234e-1, 6.3062052750311242829e-3 },
+      { SimplexOrbitType::S111, 2.9796443842962521174e-3, 2.6563551851418105666e-1, 1.1278625176312717735e-2, 3.9733854342398348062e-1 },
+      { SimplexOrbitType::S111, 4.3853962170891347276e-3, 3.9389557310905128099e-1, 9.8124044304845848654e-2, 3.7444513413293717536e-1 },
+      { SimplexOrbitType::S111, 8.1212417246900099758e-3, 5.0000000000000000000e-1, 5.2152006344309883523e-2, 2.5776534587802281058e-1 },
+    };
+
+    // polynomial degree 12, 149 points
+    constexpr PrismOrbit prismOrbits12[] = {
+      { SimplexOrbitType::S3, 8.7770792171166329645e-3, 1.0734275346339429656e-1 },
+      { SimplexOrbitType::S21, 2.5741027675491854335e-3, 1.6841319779484958685e-2, 1.6718696010840299648e-1 },
+      { SimplexOrbitType::S21, 3.8603286486437165959e-3, 2.7105836627453211414e-2, 4.1979694347143028547e-1 },
+      { SimplexOrbitType::S21, 5.2315477999885786905e-3, 1.4825982609653310476e-1, 2.1108465200259192987e-1 },
+      { SimplexOrbitType::S21, 8.6653355175639656599e-4, 1.6233227067471381186e-1, 1.8570037898131614477e-2 },
+      { SimplexOrbitType::S21, 2.6316765415545906016e-3, 2.4572543943626949652e-1, 4.9505729534525855092e-1 },
+      { SimplexOrbitType::S21, 5.5303190141043443444e-3, 2.9522088732751197756e-1, 4.3835312368268032459e-1 },
+      { SimplexOrbitType::S21, 7.5374627847417242125e-3, 2.9617554689160430157e-1, 2.5031675931374705666e-1 },
+      { SimplexOrbitType::S21, 9.9993131128994491559e-3, 5.0000000000000000000e-1, 3.9603321320723479457e-1 },
+      { SimplexOrbitType::S111, 7.1244648609451754244e-4, 2.7082290958800076727e-2, 1.7791426392124998245e-2, 9.4080705254530315640e-2 },
+      { SimplexOrbitType::S111, 1.4315449217028740001e-3, 3.1913440348224516240e-2, 2.0129239454880864102e-2, 3.4694810181747944969e-1 },
+      { SimplexOrbitType::S111, 3.1942298332220204885e-3, 1.1771253282382073792e-1, 1.7245976250611489075e-1, 5.0327765326214207637e-2 },
+      { SimplexOrbitType::S111, 4.0410953876567393630e-3, 1.3317357284624977297e-1, 7.3071605870604551230e-2, 3.5369884677685723749e-1 },
+      { SimplexOrbitType::S111, 2.4937588798104124080e-3, 2.9486457659711125677e-1, 1.0458824875464356792e-1, 4.8442007697146114745e-2 },
+      { SimplexOrbitType::S111, 1.7480331455793958651e-3, 3.0860840691728736082e-1, 3.1848546378230283716e-3, 2.3827994350910407642e-1 },
+      { SimplexOrbitType::S111, 3.9798487803110345315e-3, 3.1829764160964383663e-1, 1.0126198982635255118e-1, 2.5980294750322273913e-1 },
+      { SimplexOrbitType::S111, 5.4623000526261223129e-3, 5.0000000000000000000e-1, 4.1518636006676714077e-2, 3.6691605455317697840e-1 },
+      { SimplexOrbitType::S111, 1.3342820672971134004e-3, 5.0000000000000000000e-1, 6.6328741330864494968e-2, 5.8378097266048634342e-3 },
+      { SimplexOrbitType::S111, 5.1775156074956372124e-3, 5.0000000000000000000e-1, 9.8599187511599034071e-2, 1.8520868944577084285e-1 },
+    };
+
+    constexpr SymmetricPrismRule prismRules[] = {
+      { 1, prismOrbits1 },
+      { 2, prismOrbits2 },
+      { 3, prismOrbits3 },
+      { 4, prismOrbits4 },
+      { 5, prismOrbits5 },
+      { 6, prismOrbits6 },
+      { 7, prismOrbits7 },
+      { 8, prismOrbits8 },
+      { 9, prismOrbits9 },
+      { 10, prismOrbits10 },
+      { 11, prismOrbits11 },
+      { 12, prismOrbits12 },
+    };
+
+  } // end namespace Impl
+
+  /** \brief Table of the symmetric quadrature rules for prisms
+      \ingroup Quadrature
+
+      Like SimplexQuadraturePoints, a rule is identified by its number of points m.
+   */
   template<int dim>
   class PrismQuadraturePoints;
 
@@ -55,122 +294,112 @@ namespace Dune {
     static PrismQuadraturePoints<3> prqp;
   };
 
-  /** \todo Please doc me! */
   template<>
   class PrismQuadraturePoints<3>
   {
+    static constexpr const auto& rules_ = Impl::prismRules;
+    static constexpr int numRules_ = sizeof(rules_) / sizeof(rules_[0]);
+
   public:
-    constexpr static int MAXP = 6;
-    constexpr static int highest_order = 2;
+    constexpr static int highest_order = rules_[numRules_-1].order;
 
-    //! initialize quadrature points on the interval for all orders
-    PrismQuadraturePoints ()
+    //! expand the orbits of all rules
+    constexpr PrismQuadraturePoints ()
     {
-      int m = 0;
-      O[m] = 0;
-
-      // polynom degree 0  ???
-      m = 6;
-      G[m][0][0] = 0.0;
-      G[m][0][1] = 0.0;
-      G[m][0][2] = 0.0;
-
-      G[m][1][0] = 1.0;
-      G[m][1][1] = 0.0;
-      G[m][1][2] = 0.0;
-
-      G[m][2][0] = 0.0;
-      G[m][2][1] = 1.0;
-      G[m][2][2] = 0.0;
-
-      G[m][3][0] = 0.0;
-      G[m][3][1] = 0.0;
-      G[m][3][2] = 1.0;
-
-      G[m][4][0] = 1.0;
-      G[m][4][1] = 0.0;
-      G[m][4][2] = 1.0;
-
-      G[m][5][0] = 0.0;
-      G[m][5][1] = 0.1;
-      G[m][5][2] = 1.0;
-
-      W[m][0] = 0.16666666666666666 / 2.0;
-      W[m][1] = 0.16666666666666666 / 2.0;
-      W[m][2] = 0.16666666666666666 / 2.0;
-      W[m][3] = 0.16666666666666666 / 2.0;
-      W[m][4] = 0.16666666666666666 / 2.0;
-      W[m][5] = 0.16666666666666666 / 2.0;
-
-      O[m] = 0;  // verify ????????
-
-
-      // polynom degree 2  ???
-      m = 6;
-      G[m][0][0] =0.66666666666666666 ;
-      G[m][0][1] =0.16666666666666666 ;
-      G[m][0][2] =0.211324865405187 ;
-
-      G[m][1][0] = 0.16666666666666666;
-      G[m][1][1] =0.66666666666666666 ;
-      G[m][1][2] = 0.211324865405187;
-
-      G[m][2][0] = 0.16666666666666666;
-      G[m][2][1] = 0.16666666666666666;
-      G[m][2][2] = 0.211324865405187;
-
-      G[m][3][0] = 0.66666666666666666;
-      G[m][3][1] = 0.16666666666666666;
-      G[m][3][2] = 0.788675134594813;
-
-      G[m][4][0] = 0.16666666666666666;
-      G[m][4][1] = 0.66666666666666666;
-      G[m][4][2] = 0.788675134594813;
-
-      G[m][5][0] = 0.16666666666666666;
-      G[m][5][1] = 0.16666666666666666;
-      G[m][5][2] = 0.788675134594813;
-
-      W[m][0] = 0.16666666666666666 / 2.0;
-      W[m][1] = 0.16666666666666666 / 2.0;
-      W[m][2] = 0.16666666666666666 / 2.0;
-      W[m][3] = 0.16666666666666666 / 2.0;
-      W[m][4] = 0.16666666666666666 / 2.0;
-      W[m][5] = 0.16666666666666666 / 2.0;
+      int offset = 0;
+      for (int r = 0; r < numRules_; ++r)
+        for (int k = 0; k < rules_[r].numOrbits; ++k)
+          offset += Impl::expandPrismOrbit(rules_[r].orbits[k], G + offset, W + offset);
+    }
 
-      O[m] = 2;  // verify ????????
+    //! i-th point of the rule with m points
+    FieldVector<double, 3> point (int m, int i) const
+    {
+      return { coordinate(m,i,0), coordinate(m,i,1), coordinate(m,i,2) };
+    }
 
+    //! j-th coordinate of the i-th point of the rule with m points
+    constexpr double coordinate (int m, int i, int j) const
+    {
+      int offset = 0;
+      Impl::findSymmetricPrismRule(rules_, m, offset);
+      return G[offset+i][j];
     }
 
-    /** \todo Please doc me! */
-    FieldVector<double, 3> point(int m, int i)
+    //! weight of the i-th point of the rule with m points
+    constexpr double weight (int m, int i) const
     {
-      return G[m][i];
+      int offset = 0;
+      Impl::findSymmetricPrismRule(rules_, m, offset);
+      return W[offset+i];
     }
 
-    /** \todo Please doc me! */
-    double weight (int m, int i)
+    //! order of the rule with m points
+    constexpr int order (int m) const
     {
-      return W[m][i];
+      int offset = 0;
+      return rules_[Impl::findSymmetricPrismRule(rules_, m, offset)].order;
     }
 
-    /** \todo Please doc me! */
-    int order (int m)
+    /** \brief number of points of the rule used for quadrature order p
+     *
+     * Returns 0 if the symmetric rule needs more points than the product of
+     * the triangle rule with the Gauss rule.
+     */
+    static constexpr int numPoints (int p)
     {
-      return O[m];
+      const int productSize = SimplexQuadraturePoints<2>::numPoints(p) * (p/2 + 1);
+      for (int r = 0; r < numRules_; ++r)
+        if (rules_[r].order >= p)
+          return rules_[r].size() <= productSize ? rules_[r].size() : 0;
+      return 0;
     }
 
   private:
-    FieldVector<double, 3> G[MAXP+1][MAXP]; //positions
+    constexpr static int numPoints_ = Impl::symmetricPrismRulesSize(rules_);
+    double G[numPoints_][3] = {};
+    double W[numPoints_] = {};
+  };
 
-    double W[MAXP+1][MAXP];     // weights associated with points
-    int O[MAXP+1];              // order of the rule
+  /** \brief Quadrature rules for prisms
+      \ingroup Quadrature
+   */
+  template<typename ct, int dim>
+  class PrismQuadratureRule;
+
+  /** \brief Symmetric quadrature rules for prisms
+      \ingroup Quadrature
+
+      The rules integrate polynomials of total degree up to their order
+      exactly. Unlike the product of the rule of the triangle with the Gauss
+      rule of the same order, they do not integrate all products of
+      polynomials of this degree on the triangle and on the line, e.g., the
+      product of the basis functions of a prismatic finite element. Hence they
+      are only handed out for QuadratureType::FullySymmetric, and only unless
+      they need more points than that product, which
+      TensorProductQuadratureRule gives for all other orders.
+   */
+  template<typename ct>
+  class PrismQuadratureRule<ct,3> : public QuadratureRule<ct,3>
+  {
+  public:
+    /** \brief The highest quadrature order available */
+    constexpr static int highest_order = PrismQuadraturePoints<3>::highest_order;
+
+  private:
+    friend class QuadratureRuleFactory<ct,3>;
+    PrismQuadratureRule(int p);
   };
 
   template<typename ct>
-  PrismQuadratureRule<ct,3>::PrismQuadratureRule(int /* p */) : QuadratureRule<ct,3>(GeometryTypes::prism)
+  PrismQuadratureRule<ct,3>::PrismQuadratureRule(int p) : QuadratureRule<ct,3>(GeometryTypes::prism)
   {
-    int m=6;
+    const int m = PrismQuadraturePoints<3>::numPoints(p);
+    if (p > highest_order || m == 0)
+      DUNE_THROW(QuadratureOrderOutOfRange,
+                 "QuadratureRule for order " << p << " and GeometryType "
+                                             << this->type() << " not available");
+
     this->delivered_order = PrismQuadraturePointsSingleton<3>::prqp.order(m);
     for(int i=0; i<m; ++i)
     {
@@ -0,0 +1,434 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURE_PYRAMID_HH
+#define DUNE_GEOMETRY_QUADRATURE_PYRAMID_HH
+
+#ifndef DUNE_INCLUDING_IMPLEMENTATION
+#error This is a private header that should not be included directly.
+#error Use #include <dune/geometry/quadraturerules.hh> instead.
+#endif
+
+#include <cstddef>
+
+namespace Dune {
+
+  /***********************************
+   * quadrature for Pyramid
+   **********************************/
+
+  namespace Impl {
+
+    /** \brief Types of orbits of points under the symmetries of a pyramid
+     *
+     * The name gives the generator of the orbit in the horizontal square of
+     * the pyramid \f$|\xi|, |\eta| \leq 1-z\f$ at the height z of the orbit,
+     * relative to the size 1-z of the square. The points of the orbit are
+     * obtained by swapping the two coordinates and changing their signs, e.g.
+     * the 8 points of an AB orbit are \f$((1-z)(\pm a), (1-z)(\pm b), z)\f$
+     * and \f$((1-z)(\pm b), (1-z)(\pm a), z)\f$.
+     */
+    enum class PyramidOrbitType { Axis, A0, AA, AB };
+
+    /** \brief Orbit of a symmetric rule, given by the weight of each of its points, its height z and the parameters a, b */
+    struct PyramidOrbit
+    {
+      PyramidOrbitType type;
+      double weight;
+      double z;
+      double a = 0.0;
+      double b = 0.0;
+    };
+
+    //! symmetric rule of the given order on the pyramid, consisting of a list of orbits
+    struct SymmetricPyramidRule
+    {
+      template<std::size_t n>
+      constexpr SymmetricPyramidRule (int order, const PyramidOrbit (&orbits)[n])
+        : order(order), numOrbits(n), orbits(orbits)
+      {}
+
+      int order;
+      int numOrbits;
+      const PyramidOrbit* orbits;
+    };
+
+    //! number of points of an orbit
+    constexpr int pyramidOrbitSize (PyramidOrbitType type)
+    {
+      switch (type)
+      {
+      case PyramidOrbitType::Axis :
+        return 1;
+      case PyramidOrbitType::A0 :
+      case PyramidOrbitType::AA :
+        return 4;
+      case PyramidOrbitType::AB :
+        return 8;
+      }
+      return 0;
+    }
+
+    //! number of points of a rule
+    constexpr int symmetricPyramidRuleSize (const SymmetricPyramidRule& rule)
+    {
+      int size = 0;
+      for (int k = 0; k < rule.numOrbits; ++k)
+        size += pyramidOrbitSize(rule.orbits[k].type);
+      return size;
+    }
+
+    //! number of points of a list of rules
+    template<std::size_t n>
+    constexpr int symmetricPyramidRulesSize (const SymmetricPyramidRule (&rules)[n])
+    {
+      int size = 0;
+      for (std::size_t r = 0; r < n; ++r)
+        size += symmetricPyramidRuleSize(rules[r]);
+      return size;
+    }
+
+    //! index of the rule with m points in a list of rules, or -1
+    template<std::size_t n>
+    constexpr int findSymmetricPyramidRule (const SymmetricPyramidRule (&rules)[n], int m, int& offset)
+    {
+      offset = 0;
+      for (std::size_t r = 0; r < n; ++r)
+      {
+        const int size = symmetricPyramidRuleSize(rules[r]);
+        if (size == m)
+          return r;
+        offset += size;
+      }
+      return -1;
+    }
+
+    /** \brief Write the points and weights of an orbit, returns the number of points
+     *
+     * The points are mapped from the pyramid \f$|\xi|, |\eta| \leq 1-z\f$ to the
+     * reference pyramid with the apex (0,0,1).
+     */
+    constexpr int expandPyramidOrbit (const PyramidOrbit& orbit, double (*points)[3], double* weights)
+    {
+      // generators relative to the size of the square at height z
+      double generators[8][2] = {};
+      int n = 0;
+      const double a = orbit.a, b = orbit.b;
+      switch (orbit.type)
+      {
+      case PyramidOrbitType::Axis :
+        n = 1;
+        break;
+      case PyramidOrbitType::A0 :
+        n = 4;
+        generators[0][0] = a; generators[1][0] = -a; generators[2][1] = a; generators[3][1] = -a;
+        break;
+      case PyramidOrbitType::AA :
+        n = 4;
+        for (int i = 0; i < 4; ++i)
+        {
+          generators[i][0] = (i & 1) ? -a : a;
+          generators[i][1] = (i & 2) ? -a : a;
+        }
+        break;
+      case PyramidOrbitType::AB :
+        n = 8;
+        for (int i = 0; i < 4; ++i)
+        {
+          generators[i][0] = (i & 1) ? -a : a;
+          generators[i][1] = (i & 2) ? -b : b;
+          generators[4+i][0] = (i & 1) ? -b : b;
+          generators[4+i][1] = (i & 2) ? -a : a;
+        }
+        break;
+      }
+
+      const double size = 1.0 - orbit.z;
+      for (int i = 0; i < n; ++i)
+      {
+        points[i][0] = 0.5 * size * (1.0 + generators[i][0]);
+        points[i][1] = 0.5 * size * (1.0 + generators[i][1]);
+        points[i][2] = orbit.z;
+        weights[i] = orbit.weight;
+      }
+      return n;
+    }
+
+    /* Symmetric rules for the pyramid.
+     *
+     * The rules are invariant under the symmetries of the pyramid that keep the
+     * apex fixed. All weights are positive and all points are in the interior
+     * of the pyramid. The rules have been computed in the same way as the
+     * symmetric rules for simplices, those of degree 8 and higher by eliminating
+     * orbits from the conical product of the symmetric rules of the square with
+     * a Gauss rule. Up to degree 8 the rules need at most two points more than
+     * those given by F.D. Witherden, P.E. Vincent, On the identification of
+     * symmetric quadrature rules for finite element methods, Comput. Math. Appl.
+     * 69 (2015).
+     */
+
+    // polynomial degree 1, 1 point
+    constexpr PyramidOrbit pyramidOrbits1[] = {
+      { PyramidOrbitType::Axis, 3.3333333333333333333e-1, 2.5000000000000000000e-1 },
+    };
+
+    // polynomial degree 2, 5 points
+    constexpr PyramidOrbit pyramidOrbits2[] = {
+      { PyramidOrbitType::Axis, 1.1005427413386691953e-1, 5.2582661758211035817e-1 },
+      { PyramidOrbitType::AA, 5.5819764799866603450e-2, 1.1404502825461836157e-1, 6.1676358487158295681e-1 },
+    };
+
+    // polynomial degree 3, 6 points
+    constexpr PyramidOrbit pyramidOrbits3[] = {
+      { PyramidOrbitType::Axis, 5.2023137060099446556e-2, 3.1843312362292375510e-2 },
+      { PyramidOrbitType::Axis, 8.7277245806641988844e-2, 5.6530105637616486709e-1 },
+      { PyramidOrbitType::AA, 4.8508237616647974483e-2, 1.6666666666666666667e-1, 7.0339272580737338777e-1 },
+    };
+
+    // polynomial degree 4, 10 points
+    constexpr PyramidOrbit pyramidOrbits4[] = {
+      { PyramidOrbitType::Axis, 6.8961134196517421595e-2, 1.2513695310874644483e-1 },
+      { PyramidOrbitType::Axis, 3.7913961056880646389e-2, 6.7723278888613735861e-1 },
+      { PyramidOrbitType::A0, 3.5441529296441835009e-2, 3.2238414957821365705e-1, 9.6010380511800873883e-1 },
+      { PyramidOrbitType::AA, 2.1173030223541981329e-2, 3.9248283898815347712e-2, 6.8484602847422255583e-1 },
+    };
+
+    // polynomial degree 5, 17 points
+    constexpr PyramidOrbit pyramidOrbits5[] = {
+      { PyramidOrbitType::Axis, 2.3321334031174720655e-2, 7.2465907837563107338e-1 },
+      { PyramidOrbitType::A0, 2.8820031645220199303e-2, 6.3486203988775726148e-2, 6.8253608447177360511e-1 },
+      { PyramidOrbitType::A0, 3.1956650586373269218e-2, 3.1742821377159905624e-1, 6.8619999080774983622e-1 },
+      { PyramidOrbitType::AA, 9.0526710804698604708e-3, 9.5416132304354284316e-2, 8.8221950628892188170e-1 },
+      { PyramidOrbitType::AA, 7.6736465134763241775e-3, 4.9141453636958875572e-1, 8.7171767803622916282e-1 },
+    };
+
+    // polynomial degree 6, 23 points
+    constexpr PyramidOrbit pyramidOrbits6[] = {
+      { PyramidOrbitType::Axis, 3.0730323931795265023e-2, 9.7174865191789396925e-2 },
+      { PyramidOrbitType::Axis, 4.1580960742920894198e-2, 3.3297009683039807229e-1 },
+      { PyramidOrbitType::Axis, 8.3455339098118998396e-3, 8.1033109775053246992e-1 },
+      { PyramidOrbitType::A0, 1.2135606751426018250e-2, 9.6385149561865983918e-2, 9.2598027227638943556e-1 },
+      { PyramidOrbitType::A0, 1.3834206033316230426e-2, 5.4970177518671191281e-1, 9.1619627981723198688e-1 },
+      { PyramidOrbitType::AA, 1.7061769836581085674e-3, 2.5536799321622153859e-2, 9.5576346161153237273e-1 },
+      { PyramidOrbitType::AA, 1.2295159822726694532e-2, 2.8365007864726000948e-2, 5.3932936438556986587e-1 },
+      { PyramidOrbitType::AA, 2.3197979096074266793e-2, 2.4864715596084515673e-1, 6.9824096587187849390e-1 },
+    };
+
+    // polynomial degree 7, 33 points
+    constexpr PyramidOrbit pyramidOrbits7[] = {
+      { PyramidOrbitType::Axis, 2.1806004892668376541e-2, 5.3021497163720652571e-1 },
+      { PyramidOrbitType::A0, 8.8972530976676384840e-3, 6.6666666666666666667e-2, 9.2582009977255146157e-1 },
+      { PyramidOrbitType::A0, 9.5703125000000000000e-3, 3.3333333333333333333e-1, 9.2582009977255146157e-1 },
+      { PyramidOrbitType::AA, 4.9927985259511413307e-3, 3.1262500618493948022e-2, 8.0296852015938445202e-1 },
+      { PyramidOrbitType::AA, 1.3365783884257944375e-2, 4.4262606931027812742e-2, 3.7815825502680370743e-1 },
+      { PyramidOrbitType::AA, 9.2250779282778335023e-3, 2.0223962189860107304e-1, 8.1345672094784347130e-1 },
+      { PyramidOrbitType::AA, 1.9992550620155166395e-2, 2.2862126965176205743e-1, 3.8975927007127705640e-1 },
+      { PyramidOrbitType::AA, 9.4488866436184628561e-3, 5.3570369981195673981e-1, 7.1130647136595914437e-1 },
+      { PyramidOrbitType::AA, 2.3891689102380522553e-3, 8.0099714485917475149e-1, 5.8618344355175649140e-1 },
+    };
+
+    // polynomial degree 8, 47 points
+    constexpr PyramidOrbit pyramidOrbits8[] = {
+      { PyramidOrbitType::Axis, 1.8172954905375014439e-2, 1.5617447860519530728e-1 },
+      { PyramidOrbitType::Axis, 1.4759109003060735980e-2, 5.9639391901093280182e-1 },
+      { PyramidOrbitType::Axis, 3.2978608253331825126e-3, 8.6083333344137085277e-1 },
+      { PyramidOrbitType::A0, 1.0782759816846615143e-2, 3.6706014540373193854e-2, 5.2740490439546452780e-1 },
+      { PyramidOrbitType::A0, 8.3119069287887944528e-3, 1.6597340324046660758e-1, 9.3966748841843360192e-1 },
+      { PyramidOrbitType::AA, 2.1739357528503762713e-3, 7.6498959438010781941e-2, 9.1368677041518499253e-1 },
+      { PyramidOrbitType::AA, 1.3729118366768068641e-2, 1.5033341813478274007e-1, 6.0388938167868463095e-1 },
+      { PyramidOrbitType::AA, 4.0085558782758046033e-3, 2.9645753310774915876e-1, 8.8145044527761487287e-1 },
+      { PyramidOrbitType::AA, 1.1498953290692930017e-2, 3.0748228864349129510e-1, 3.6252028846209604135e-1 },
+      { PyramidOrbitType::AA, 3.9106570926908658888e-3, 6.7998987381535313246e-1, 7.5554376501730665220e-1 },
+      { PyramidOrbitType::AB, 3.4542695843234847410e-3, 2.2514099551729090820e-2, 4.8043201221886754972e-1, 8.9385882325776545338e-1 },
+      { PyramidOrbitType::AB, 6.4757129271653378006e-3, 4.3771805928028209892e-1, 3.3039388100092587923e-1, 8.3950179177772814898e-1 },
+    };
+
+    // polynomial degree 9, 69 points
+    constexpr PyramidOrbit pyramidOrbits9[] = {
+      { PyramidOrbitType::Axis, 5.7099108772932685284e-3, 6.6328155804057314561e-1 },
+      { PyramidOrbitType::A0, 9.3007032018543470998e-3, 3.3620412287495681925e-2, 4.9641901119070819998e-1 },
+      { PyramidOrbitType::A0, 1.2786505528506644107e-2, 1.6966193385826073029e-1, 4.5813402237763964522e-1 },
+      { PyramidOrbitType::A0, 1.3455487696465497783e-2, 3.8453797115687738720e-1, 5.6651901522057025805e-1 },
+      { PyramidOrbitType::A0, 4.6529764715643466169e-3, 6.0423077537945556271e-1, 7.4684500114264083493e-1 },
+      { PyramidOrbitType::AA, 3.7976171499432745581e-3, 2.9672352725359760563e-2, 7.0131383826444070993e-1 },
+      { PyramidOrbitType::AA, 7.4508418646105884652e-4, 3.2560443453201728852e-2, 9.4519154170174982533e-1 },
+      { PyramidOrbitType::AA, 7.1912040905794273324e-3, 1.5746916042708331802e-1, 6.6102911323869218226e-1 },
+      { PyramidOrbitType::AA, 1.8089364111778248606e-3, 1.6831397970039397321e-1, 9.2613086776820678331e-1 },
+      { PyramidOrbitType::AA, 4.2607452214256367014e-3, 3.7263128191089086295e-1, 7.4943598060030699183e-1 },
+      { PyramidOrbitType::AA, 2.3049963995200541648e-3, 6.6095530070623930268e-1, 7.8534716985577329147e-1 },
+      { PyramidOrbitType::AA, 9.7035894014554237027e-4, 8.5356552772718058400e-1, 5.6189504583420727696e-1 },
+      { PyramidOrbitType::AB, 3.1900784894738171826e-3, 3.8396557779409910189e-2, 3.5044434687187472458e-1, 9.2094790803785606120e-1 },
+      { PyramidOrbitType::AB, 4.9086701424037955645e-3, 1.8806066864882616146e-1, 3.1969499251911425523e-1, 9.0835961161267448416e-1 },
+      { PyramidOrbitType::AB, 2.2168715263055681333e-3, 4.0920946978161149151e-1, 5.4318610487355590019e-1, 9.9078274621090014316e-1 },
+    };
+
+    // polynomial degree 10, 99 points
+    constexpr PyramidOrbit pyramidOrbits10[] = {
+      { PyramidOrbitType::Axis, 1.3080976283307895142e-2, 3.5887452779340028429e-1 },
+      { PyramidOrbitType::Axis, 4.8115168167294170559e-3, 6.7725954776871209501e-1 },
+      { PyramidOrbitType::Axis, 1.0405123056357520179e-3, 9.0781620997135354425e-1 },
+      { PyramidOrbitType::A0, 1.4387000027741937712e-3, 2.6639968165285667338e-2, 9.6378082949035123320e-1 },
+      { PyramidOrbitType::A0, 2.4457472322427800585e-3, 1.3674904749483688422e-1, 9.6313957248111991943e-1 },
+      { PyramidOrbitType::A0, 5.9946432618563102447e-3, 3.1539466741504634756e-1, 8.6519917597015911103e-1 },
+      { PyramidOrbitType::AA, 3.6201195691668329010e-3, 2.9081931653938290969e-2, 2.2477495940604075471e-1 },
+      { PyramidOrbitType::AA, 4.8630585502648604202e-4, 3.7722748066220373833e-2, 9.5694966220153922351e-1 },
+      { PyramidOrbitType::AA, 5.8841212079952160257e-3, 1.5135007107078830792e-1, 2.0652676546008729262e-1 },
+      { PyramidOrbitType::AA, 7.0024022566450301305e-4, 1.8735773464122696593e-1, 9.4433607520199221955e-1 },
+      { PyramidOrbitType::AA, 9.0216731700659110345e-3, 3.1863624802541652894e-1, 4.9124328023060943530e-1 },
+      { PyramidOrbitType::AB, 1.7458586555081542577e-3, 2.2998655974059484732e-2, 8.9652406249903867675e-1, 6.2535606793169232852e-1 },
+      { PyramidOrbitType::AB, 3.8934679597923369131e-3, 2.9850785824907063697e-2, 6.7011347784345135210e-1, 2.8548697203120850111e-1 },
+      { PyramidOrbitType::AB, 3.2707598439690677178e-3, 1.2910907008029342496e-1, 9.0596900679051232010e-1, 6.3370427554976583585e-1 },
+      { PyramidOrbitType::AB, 6.3506902421888776306e-3, 1.4402906711495031074e-1, 6.7251740572599222421e-1, 2.9633428808089170416e-1 },
+      { PyramidOrbitType::AB, 2.5435023527554499852e-3, 3.2431042856877229641e-1, 9.3622628368480868679e-1, 6.7668121556417025600e-1 },
+      { PyramidOrbitType::AB, 3.9934782588547186962e-3, 5.3257855221688018762e-1, 6.6468827409091133915e-1, 2.0396702630183684897e-1 },
+      { PyramidOrbitType::AB, 1.5572035455581933708e-3, 5.4273107942770367624e-1, 9.6848649567498689688e-1, 6.3489921231032174050e-1 },
+      { PyramidOrbitType::AB, 1.1493048699346185228e-3, 7.5916242250109802095e-1, 8.2888837248397134169e-1, 4.4835026116405340364e-1 },
+    };
+
+    constexpr SymmetricPyramidRule pyramidRules[] = {
+      { 1, pyramidOrbits1 },
+      { 2, pyramidOrbits2 },
+      { 3, pyramidOrbits3 },
+      { 4, pyramidOrbits4 },
+      { 5, pyramidOrbits5 },
+      { 6, pyramidOrbits6 },
+      { 7, pyramidOrbits7 },
+      { 8, pyramidOrbits8 },
+      { 9, pyramidOrbits9 },
+      { 10, pyramidOrbits10 },
+    };
+
+  } // end namespace Impl
+
+  /** \brief Table of the symmetric quadrature rules for pyramids
+      \ingroup Quadrature
+
+      Like SimplexQuadraturePoints, a rule is identified by its number of points m.
+   */
+  template<int dim>
+  class PyramidQuadraturePoints;
+
+  template<>
+  class PyramidQuadraturePoints<3>
+  {
+    static constexpr const auto& rules_ = Impl::pyramidRules;
+    static constexpr int numRules_ = sizeof(rules_) / sizeof(rules_[0]);
+
+  public:
+    constexpr static int highest_order = rules_[numRules_-1].order;
+
+    //! expand the orbits of all rules
+    constexpr PyramidQuadraturePoints ()
+    {
+      int offset = 0;
+      for (int r = 0; r < numRules_; ++r)
+        for (int k = 0; k < rules_[r].numOrbits; ++k)
+          offset += Impl::expandPyramidOrbit(rules_[r].orbits[k], G + offset, W + offset);
+    }
+
+    //! i-th point of the rule with m points
+    FieldVector<double, 3> point (int m, int i) const
+    {
+      return { coordinate(m,i,0), coordinate(m,i,1), coordinate(m,i,2) };
+    }
+
+    //! j-th coordinate of the i-th point of the rule with m points
+    constexpr double coordinate (int m, int i, int j) const
+    {
+      int offset = 0;
+      Impl::findSymmetricPyramidRule(rules_, m, offset);
+      return G[offset+i][j];
+    }
+
+    //! weight of the i-th point of the rule with m points
+    constexpr double weight (int m, int i) const
+    {
+      int offset = 0;
+      Impl::findSymmetricPyramidRule(rules_, m, offset);
+      return W[offset+i];
+    }
+
+    //! order of the rule with m points
+    constexpr int order (int m) const
+    {
+      int offset = 0;
+      return rules_[Impl::findSymmetricPyramidRule(rules_, m, offset)].order;
+    }
+
+    //! number of points of the rule used for quadrature order p
+    static constexpr int numPoints (int p)
+    {
+      for (int r = 0; r < numRules_; ++r)
+        if (rules_[r].order >= p)
+          return Impl::symmetricPyramidRuleSize(rules_[r]);
+      return 0;
+    }
+
+  private:
+    constexpr static int numPoints_ = Impl::symmetricPyramidRulesSize(rules_);
+    double G[numPoints_][3] = {};
+    double W[numPoints_] = {};
+  };
+
+  /** \brief Singleton holding the pyramid quadrature points
+     \ingroup Quadrature
+   */
+  template<int dim>
+  struct PyramidQuadraturePointsSingleton {};
+
+  /** \brief Singleton holding the pyramid quadrature points
+     \ingroup Quadrature
+   */
+  template<>
+  struct PyramidQuadraturePointsSingleton<3> {
+    static PyramidQuadraturePoints<3> pyqp;
+  };
+
+  /** \brief Symmetric quadrature rules for pyramids
+      \ingroup Quadrature
+   */
+  template<typename ct, int dim>
+  class PyramidQuadratureRule;
+
+  /** \brief Symmetric quadrature rules for pyramids
+      \ingroup Quadrature
+
+      The rules need considerably fewer points than the conical product rules
+      and do not cluster the points at the apex.
+   */
+  template<typename ct>
+  class PyramidQuadratureRule<ct,3> : public QuadratureRule<ct,3>
+  {
+  public:
+    /** \brief The highest quadrature order available */
+    constexpr static int highest_order = PyramidQuadraturePoints<3>::highest_order;
+
+  private:
+    friend class QuadratureRuleFactory<ct,3>;
+    PyramidQuadratureRule (int p);
+  };
+
+  template<typename ct>
+  PyramidQuadratureRule<ct,3>::PyramidQuadratureRule (int p)
+    : QuadratureRule<ct,3>(GeometryTypes::pyramid)
+  {
+    if (p > highest_order)
+      DUNE_THROW(QuadratureOrderOutOfRange,
+                 "QuadratureRule for order " << p << " and GeometryType "
+                                             << this->type() << " not available");
+
+    const int m = PyramidQuadraturePoints<3>::numPoints(p);
+    this->delivered_order = PyramidQuadraturePointsSingleton<3>::pyqp.order(m);
+    for (int i = 0; i < m; ++i)
+    {
+      FieldVector<ct,3> local = PyramidQuadraturePointsSingleton<3>::pyqp.point(m,i);
+      ct weight = PyramidQuadraturePointsSingleton<3>::pyqp.weight(m,i);
+      // put in container
+      this->push_back(QuadraturePoint<ct,3>(local,weight));
+    }
+  }
+
+} // namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURE_PYRAMID_HH
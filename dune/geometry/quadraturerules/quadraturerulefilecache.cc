@@ -0,0 +1,376 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/stdstreams.hh>
+
+#include <dune/geometry/quadraturerules/quadraturerulefilecache.hh>
+
+#if __has_include(<sys/mman.h>) && __has_include(<sys/file.h>) && __has_include(<unistd.h>)
+#define DUNE_GEOMETRY_HAVE_FILE_MAPPING 1
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Dune {
+
+  namespace {
+
+    constexpr char fileMagic[8] = { 'D', 'U', 'N', 'E', 'Q', 'U', 'A', 'D' };
+    constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+    struct FileHeader
+    {
+      char magic[8];
+      std::uint32_t version;
+      std::uint32_t byteOrder;
+      std::uint64_t reserved[2];
+    };
+
+    struct RecordHeader
+    {
+      QuadratureRuleFileCache::Key key;
+      std::int32_t order;
+      std::uint32_t reserved;
+      std::uint64_t dataSize;
+    };
+
+    // records start at multiples of 8 bytes
+    constexpr std::size_t recordSize (std::uint64_t dataSize)
+    {
+      return sizeof(RecordHeader) + (dataSize + 7) / 8 * 8;
+    }
+
+    std::mutex globalMutex;
+    std::shared_ptr<QuadratureRuleFileCache> globalCache;
+    bool globalInitialized = false;
+
+#if DUNE_GEOMETRY_HAVE_FILE_MAPPING
+    // lock the whole file for the lifetime of the object
+    class FileLock
+    {
+    public:
+      FileLock (int fd, int operation)
+        : fd_(fd)
+      {
+        while (::flock(fd_, operation) != 0)
+          if (errno != EINTR)
+            DUNE_THROW(IOError, "Cannot lock quadrature cache file: " << std::strerror(errno));
+      }
+
+      ~FileLock () { ::flock(fd_, LOCK_UN); }
+
+    private:
+      int fd_;
+    };
+
+    std::size_t fileSize (int fd)
+    {
+      struct stat status;
+      if (::fstat(fd, &status) != 0)
+        DUNE_THROW(IOError, "Cannot stat quadrature cache file: " << std::strerror(errno));
+      return status.st_size;
+    }
+
+    void writeAll (int fd, const void* data, std::size_t size, std::size_t offset)
+    {
+      const char* buffer = static_cast<const char*>(data);
+      while (size > 0)
+      {
+        const ssize_t written = ::pwrite(fd, buffer, size, offset);
+        if (written < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          DUNE_THROW(IOError, "Cannot write quadrature cache file: " << std::strerror(errno));
+        }
+        buffer += written;
+        offset += written;
+        size -= written;
+      }
+    }
+
+    void writeHeader (int fd)
+    {
+      FileHeader header = {};
+      std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+      header.version = QuadratureRuleFileCache::formatVersion;
+      header.byteOrder = byteOrderMark;
+      writeAll(fd, &header, sizeof(header), 0);
+    }
+#endif
+
+  } // end empty namespace
+
+  QuadratureRuleFileCache::QuadratureRuleFileCache (const std::string& filename)
+    : filename_(filename)
+  {
+#if DUNE_GEOMETRY_HAVE_FILE_MAPPING
+    // the file is opened again after it has been replaced, by this or by another process
+    while (!open())
+      ;
+    scanned_ = sizeof(FileHeader);
+#else
+    DUNE_THROW(NotImplemented, "QuadratureRuleFileCache needs memory-mapped files");
+#endif
+  }
+
+  QuadratureRuleFileCache::~QuadratureRuleFileCache ()
+  {
+#if DUNE_GEOMETRY_HAVE_FILE_MAPPING
+    if (map_)
+      ::munmap(const_cast<unsigned char*>(map_), mapSize_);
+    ::close(fd_);
+#endif
+  }
+
+  bool QuadratureRuleFileCache::open ()
+  {
+#if DUNE_GEOMETRY_HAVE_FILE_MAPPING
+    fd_ = ::open(filename_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    writable_ = (fd_ >= 0);
+    if (!writable_)
+      fd_ = ::open(filename_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0)
+      DUNE_THROW(IOError, "Cannot open quadrature cache file " << filename_ << ": " << std::strerror(errno));
+
+    bool valid = false;
+    try {
+      FileLock lock(fd_, writable_ ? LOCK_EX : LOCK_SH);
+
+      // another process has replaced the file after it has been opened
+      struct stat opened, named;
+      if (::fstat(fd_, &opened) != 0)
+        DUNE_THROW(IOError, "Cannot stat quadrature cache file " << filename_ << ": " << std::strerror(errno));
+      if (::stat(filename_.c_str(), &named) == 0 && opened.st_dev == named.st_dev && opened.st_ino == named.st_ino)
+      {
+        if (writable_ && fileSize(fd_) == 0)
+          writeHeader(fd_);
+
+        FileHeader header = {};
+        if (::pread(fd_, &header, sizeof(header), 0) != ssize_t(sizeof(header))
+            || std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0)
+          DUNE_THROW(IOError, filename_ << " is not a quadrature cache file");
+        valid = (header.version == formatVersion && header.byteOrder == byteOrderMark);
+        if (!valid && !writable_)
+          DUNE_THROW(IOError, "Quadrature cache file " << filename_ << " has format version " << header.version
+                     << " or a different byte order, expected version " << formatVersion << ", and cannot be replaced");
+        // replace the file while it is locked, such that no other process
+        // validates the old file or replaces it a second time
+        if (!valid)
+          replace();
+      }
+    }
+    catch (...) {
+      ::close(fd_);
+      throw;
+    }
+    if (!valid)
+      ::close(fd_);
+    return valid;
+#else
+    return false;
+#endif
+  }
+
+  void QuadratureRuleFileCache::replace ()
+  {
+#if DUNE_GEOMETRY_HAVE_FILE_MAPPING
+    // the new file is renamed to the name of the old one, such that processes
+    // still using the old file keep a consistent mapping of it
+    const std::string newFilename = filename_ + "." + std::to_string(::getpid()) + ".new";
+    const int fd = ::open(newFilename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+      DUNE_THROW(IOError, "Cannot replace quadrature cache file " << filename_ << ": " << std::strerror(errno));
+    try {
+      writeHeader(fd);
+      if (::rename(newFilename.c_str(), filename_.c_str()) != 0)
+        DUNE_THROW(IOError, "Cannot replace quadrature cache file " << filename_ << ": " << std::strerror(errno));
+    }
+    catch (...) {
+      ::close(fd);
+      ::unlink(newFilename.c_str());
+      throw;
+    }
+    ::close(fd);
+    dwarn << "Quadrature cache file " << filename_ << " of another format version has been replaced" << std::endl;
+#endif
+  }
+
+  void QuadratureRuleFileCache::fail (const std::string& message) const
+  {
+    if (!failed_)
+      dwarn << "Quadrature cache file " << filename_ << " is not used anymore: " << message << std::endl;
+    failed_ = true;
+  }
+
+  std::size_t QuadratureRuleFileCache::size () const
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!failed_)
+    {
+      try {
+        refresh();
+      }
+      catch (const Exception& e) {
+        fail(e.what());
+      }
+    }
+    return index_.size();
+  }
+
+  bool QuadratureRuleFileCache::load (const Key& key, int& order, std::vector<unsigned char>& data) const
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (failed_)
+      return false;
+    auto it = index_.find(key);
+    if (it == index_.end())
+    {
+      // the rule might have been appended by another process
+      try {
+        refresh();
+      }
+      catch (const Exception& e) {
+        fail(e.what());
+        return false;
+      }
+      it = index_.find(key);
+      if (it == index_.end())
+        return false;
+    }
+
+    RecordHeader header;
+    std::memcpy(&header, map_ + it->second, sizeof(header));
+    const unsigned char* begin = map_ + it->second + sizeof(header);
+    order = header.order;
+    data.assign(begin, begin + header.dataSize);
+    return true;
+  }
+
+  void QuadratureRuleFileCache::store (const Key& key, int order, const std::vector<unsigned char>& data)
+  {
+#if DUNE_GEOMETRY_HAVE_FILE_MAPPING
+    if (!writable_)
+      return;
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (failed_)
+      return;
+    try {
+      FileLock lock(fd_, LOCK_EX);
+      scan();
+      if (index_.count(key) > 0)
+        return;
+
+      // drop the incomplete record of a process that died while appending
+      if (fileSize(fd_) > scanned_)
+        if (::ftruncate(fd_, scanned_) != 0)
+          DUNE_THROW(IOError, "Cannot truncate quadrature cache file: " << std::strerror(errno));
+
+      RecordHeader header = {};
+      header.key = key;
+      header.order = order;
+      header.dataSize = data.size();
+      std::vector<unsigned char> record(recordSize(data.size()), 0);
+      std::memcpy(record.data(), &header, sizeof(header));
+      std::memcpy(record.data() + sizeof(header), data.data(), data.size());
+      writeAll(fd_, record.data(), record.size(), scanned_);
+
+      scan();
+    }
+    catch (const Exception& e) {
+      fail(e.what());
+    }
+#endif
+  }
+
+  void QuadratureRuleFileCache::scan () const
+  {
+#if DUNE_GEOMETRY_HAVE_FILE_MAPPING
+    const std::size_t bytes = fileSize(fd_);
+    if (bytes != mapSize_)
+    {
+      if (map_)
+        ::munmap(const_cast<unsigned char*>(map_), mapSize_);
+      map_ = nullptr;
+      mapSize_ = 0;
+      void* map = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd_, 0);
+      if (map == MAP_FAILED)
+        DUNE_THROW(IOError, "Cannot map quadrature cache file " << filename_ << ": " << std::strerror(errno));
+      map_ = static_cast<const unsigned char*>(map);
+      mapSize_ = bytes;
+    }
+
+    while (scanned_ + sizeof(RecordHeader) <= mapSize_)
+    {
+      RecordHeader header;
+      std::memcpy(&header, map_ + scanned_, sizeof(header));
+      if (header.dataSize > mapSize_)
+        break;
+      const std::size_t size = recordSize(header.dataSize);
+      if (mapSize_ - scanned_ < size)
+        break;
+      index_.emplace(header.key, scanned_);
+      scanned_ += size;
+    }
+#endif
+  }
+
+  void QuadratureRuleFileCache::refresh () const
+  {
+#if DUNE_GEOMETRY_HAVE_FILE_MAPPING
+    if (fileSize(fd_) == mapSize_)
+      return;
+    FileLock lock(fd_, LOCK_SH);
+    scan();
+#endif
+  }
+
+  void QuadratureRuleFileCache::enable (const std::string& filename)
+  {
+    auto cache = std::make_shared<QuadratureRuleFileCache>(filename);
+    std::lock_guard<std::mutex> guard(globalMutex);
+    globalInitialized = true;
+    globalCache = std::move(cache);
+  }
+
+  void QuadratureRuleFileCache::disable ()
+  {
+    std::lock_guard<std::mutex> guard(globalMutex);
+    globalInitialized = true;
+    globalCache.reset();
+  }
+
+  std::shared_ptr<QuadratureRuleFileCache> QuadratureRuleFileCache::global ()
+  {
+    std::lock_guard<std::mutex> guard(globalMutex);
+    if (!globalInitialized)
+    {
+      globalInitialized = true;
+      const char* filename = std::getenv("DUNE_QUADRATURE_CACHE");
+      if (filename && *filename)
+      {
+        // a file that cannot be used must not make QuadratureRules fail
+        try {
+          globalCache = std::make_shared<QuadratureRuleFileCache>(filename);
+        }
+        catch (const Exception& e) {
+          dwarn << "Quadrature cache file " << filename << " is not used: " << e.what() << std::endl;
+        }
+      }
+    }
+    return globalCache;
+  }
+
+} // end namespace Dune
@@ -0,0 +1,159 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_QUADRATURERULEFILECACHE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_QUADRATURERULEFILECACHE_HH
+
+/** \file
+ * \brief Persistent on-disk cache of quadrature rules shared between processes
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Dune {
+
+  /** \brief Persistent cache of quadrature rules in a memory-mapped file
+      \ingroup Quadrature
+
+      The file starts with a header holding the format version, followed by
+      one record per rule. A record consists of its Key, the delivered order
+      and the raw numbers of all points and weights. The file is mapped
+      read-only and shared by all processes using it. A rule that is not found
+      is appended by a single write under an exclusive lock of the file, such
+      that it is computed only once, e.g. by one of the ranks of an MPI job on
+      a machine, and no process ever reads an incomplete record.
+
+      The cache is opt-in. QuadratureRules looks up every rule it has to
+      create in the cache returned by global(), which is set by enable() or
+      by the environment variable `DUNE_QUADRATURE_CACHE`. A file that cannot
+      be used never makes QuadratureRules fail: global() warns once and
+      QuadratureRules computes the rules as without a cache.
+
+      Only the file is shared between the processes. load() copies a rule out
+      of the mapping and QuadratureRules keeps it in memory of the process,
+      such that every process still holds its own copy of the rules it uses.
+      The cache saves the time to compute the rules, not their memory.
+
+      \note The file is neither portable between machines of different byte
+      order nor between versions of dune-geometry that change a rule; in
+      the latter case #formatVersion is increased and old files are replaced.
+   */
+  class QuadratureRuleFileCache
+  {
+  public:
+    /** \brief Version of the file format and the rules stored in it */
+    constexpr static std::uint32_t formatVersion = 12;
+
+    /** \brief Identification of a rule in the cache */
+    struct Key
+    {
+      //! sizeof of the number type
+      std::uint32_t ctypeSize;
+      //! std::numeric_limits<ctype>::digits of the number type
+      std::int32_t ctypeDigits;
+      //! dimension of the rule
+      std::uint32_t dim;
+      //! topology id of the geometry type with bit 0 cleared, as in quadratureRuleId()
+      std::uint32_t topologyId;
+      //! requested order
+      std::int32_t order;
+      //! quadrature type
+      std::int32_t quadratureType;
+
+      bool operator< (const Key& other) const
+      {
+        return std::tie(ctypeSize, ctypeDigits, dim, topologyId, order, quadratureType)
+          < std::tie(other.ctypeSize, other.ctypeDigits, other.dim, other.topologyId, other.order, other.quadratureType);
+      }
+    };
+
+    /** \brief Open or create the cache file
+     *
+     * If the file cannot be written, the cache is read-only and store() does
+     * nothing. A cache file of another format version or byte order is
+     * replaced by an empty one. Processes that still use the old file keep
+     * their mapping of it.
+     * \throws IOError if the file cannot be opened, is no quadrature cache file,
+     *         or has another format version and cannot be replaced
+     */
+    explicit QuadratureRuleFileCache (const std::string& filename);
+
+    ~QuadratureRuleFileCache ();
+
+    QuadratureRuleFileCache (const QuadratureRuleFileCache&) = delete;
+    QuadratureRuleFileCache& operator= (const QuadratureRuleFileCache&) = delete;
+
+    //! name of the cache file
+    const std::string& filename () const { return filename_; }
+
+    //! number of rules in the cache, including those appended by other processes
+    std::size_t size () const;
+
+    /** \brief Copy the data of the rule with the given key
+     *
+     * If the file cannot be read anymore, a warning is printed once and the
+     * cache behaves as if it were empty from then on.
+     * \param[out] order delivered order of the rule
+     * \param[out] data  raw numbers of the rule, all coordinates of a point followed by its weight
+     * \returns false if the rule is not in the cache
+     */
+    bool load (const Key& key, int& order, std::vector<unsigned char>& data) const;
+
+    /** \brief Append the data of a rule unless another process has done so already
+     *
+     * Errors are handled like in load(), the rule is then not stored.
+     */
+    void store (const Key& key, int order, const std::vector<unsigned char>& data);
+
+    /** \brief Use the given file for all rules created by QuadratureRules from now on */
+    static void enable (const std::string& filename);
+
+    /** \brief Stop using a cache file */
+    static void disable ();
+
+    /** \brief Cache used by QuadratureRules, or nullptr if there is none
+     *
+     * If the file given by `DUNE_QUADRATURE_CACHE` cannot be used, a warning
+     * is printed on the first call and nullptr is returned.
+     */
+    static std::shared_ptr<QuadratureRuleFileCache> global ();
+
+  private:
+    // index all complete records the mapping does not know yet, the file has to be locked
+    void scan () const;
+    // map the file and scan it, taking a shared lock if it has grown
+    void refresh () const;
+    // open and lock the file and validate its header, returns false if the
+    // file has been replaced in the meantime and has to be opened again
+    bool open ();
+    // replace a file of another format version by an empty cache file, the old file has to be locked
+    void replace ();
+    // warn about an error once and stop using the file
+    void fail (const std::string& message) const;
+
+    std::string filename_;
+    int fd_ = -1;
+    bool writable_ = false;
+
+    mutable std::mutex mutex_;
+    // an error has occurred, the cache is not used anymore
+    mutable bool failed_ = false;
+    mutable const unsigned char* map_ = nullptr;
+    mutable std::size_t mapSize_ = 0;
+    // end of the last complete record
+    mutable std::size_t scanned_ = 0;
+    // offset of the record of each key
+    mutable std::map<Key, std::size_t> index_;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_QUADRATURERULEFILECACHE_HH
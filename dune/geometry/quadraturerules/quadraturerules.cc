@@ -15,18 +15,32 @@ namespace Dune {
   /** Singleton holding the SimplexQuadrature points dim==3 */
   SimplexQuadraturePoints<3> SimplexQuadraturePointsSingleton<3>::sqp;
 
+  /** Singleton holding the symmetric quadrature points of the square */
+  CubeQuadraturePoints<2> CubeQuadraturePointsSingleton<2>::cqp;
+
+  /** Singleton holding the symmetric quadrature points of the cube */
+  CubeQuadraturePoints<3> CubeQuadraturePointsSingleton<3>::cqp;
+
   /** Singleton holding the Prism Quadrature points  */
   PrismQuadraturePoints<3> PrismQuadraturePointsSingleton<3>::prqp;
 
+  /** Singleton holding the symmetric quadrature points of the pyramid */
+  PyramidQuadraturePoints<3> PyramidQuadraturePointsSingleton<3>::pyqp;
+
   // explicit template instantiations
+  template class CubeQuadratureRule<double, 2>;
+  template class CubeQuadratureRule<double, 3>;
   template class GaussLobattoQuadratureRule<double, 1>;
   template class GaussQuadratureRule<double, 1>;
   template class GaussRadauLeftQuadratureRule<double, 1>;
   template class GaussRadauRightQuadratureRule<double, 1>;
+  template class HighOrderGaussQuadratureRule<double, 1>;
   template class Jacobi1QuadratureRule<double, 1>;
   template class Jacobi2QuadratureRule<double, 1>;
   template class JacobiNQuadratureRule<double, 1>;
+  template class NestedQuadratureRule<double, 1>;
   template class PrismQuadratureRule<double, 3>;
+  template class PyramidQuadratureRule<double, 3>;
   template class SimplexQuadratureRule<double, 2>;
   template class SimplexQuadratureRule<double, 3>;
 
@@ -0,0 +1,134 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_RULETABULATIONCACHE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_RULETABULATIONCACHE_HH
+
+/** \file
+ * \brief Thread-safe cache of data tabulated at the points of quadrature rules
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <dune/geometry/quadraturerules.hh>
+
+namespace Dune {
+
+  /** \brief Thread-safe cache of data computed once per quadrature rule
+   *  \ingroup Quadrature
+   *
+   * Typical data are the values of shape functions at the quadrature points
+   * of a rule. The key identifies the rule, usually by its stable identity
+   * QuadratureRules::id(), possibly combined with an identification of the
+   * tabulated functions. Every value is computed only once, on the first
+   * request of its key, and stays at the same address until clear() is called.
+   * \code{.cpp}
+   * static RuleTabulationCache<std::uint64_t, std::vector<double> > cache;
+   * const auto& values = cache(QuadratureRules<double,2>::id(quad), [&]{
+   *   std::vector<double> values;
+   *   for (const auto& qp : quad)
+   *     values.push_back(f(qp.position()));
+   *   return values;
+   * });
+   * \endcode
+   *
+   * \tparam Key   Type of the keys, usually std::uint64_t
+   * \tparam Value Type of the cached data
+   * \tparam Hash  Hash function of the keys
+   */
+  template<class Key, class Value, class Hash = std::hash<Key> >
+  class RuleTabulationCache
+  {
+    struct Entry
+    {
+      std::once_flag once;
+      std::unique_ptr<const Value> value;
+      // set once the value has been computed
+      std::atomic<const Value*> ready{nullptr};
+    };
+
+  public:
+    //! type of the keys
+    typedef Key KeyType;
+
+    //! type of the cached data
+    typedef Value ValueType;
+
+    /** \brief The value of the key, computed by compute() on the first request
+     *
+     * Concurrent requests of the same key wait for a single call of
+     * compute(). If compute() throws, the exception is passed on and the
+     * value is computed again on the next request.
+     */
+    template<class Compute>
+    const Value& operator() (const Key& key, Compute&& compute)
+    {
+      Entry& entry = this->entry(key);
+      if (const Value* value = entry.ready.load(std::memory_order_acquire))
+        return *value;
+      std::call_once(entry.once, [&]{
+        entry.value = std::make_unique<const Value>(compute());
+        entry.ready.store(entry.value.get(), std::memory_order_release);
+      });
+      return *entry.value;
+    }
+
+    /** \brief Cached value of the key, or nullptr if it has not been computed */
+    const Value* find (const Key& key) const
+    {
+      std::shared_lock<std::shared_mutex> guard(mutex_);
+      auto it = entries_.find(key);
+      return it == entries_.end() ? nullptr : it->second->ready.load(std::memory_order_acquire);
+    }
+
+    //! number of keys requested so far
+    std::size_t size () const
+    {
+      std::shared_lock<std::shared_mutex> guard(mutex_);
+      return entries_.size();
+    }
+
+    /** \brief Remove all values
+     *
+     * \note References to the values become invalid, hence clear() must not be
+     *       called while other threads use the cache.
+     */
+    void clear ()
+    {
+      std::unique_lock<std::shared_mutex> guard(mutex_);
+      entries_.clear();
+    }
+
+  private:
+    // entry of the key, inserted if it is missing
+    Entry& entry (const Key& key)
+    {
+      {
+        std::shared_lock<std::shared_mutex> guard(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end())
+          return *it->second;
+      }
+      std::unique_lock<std::shared_mutex> guard(mutex_);
+      auto& entry = entries_[key];
+      if (!entry)
+        entry = std::make_unique<Entry>();
+      return *entry;
+    }
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<Key, std::unique_ptr<Entry>, Hash> entries_;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_RULETABULATIONCACHE_HH
@@ -30,7 +30,7 @@ namespace Dune {
   {
   public:
     /** \brief The highest quadrature order available */
-    constexpr static int highest_order = 12;
+    constexpr static int highest_order = 29;
   private:
     friend class QuadratureRuleFactory<ct,2>;
     SimplexQuadratureRule (int p);
@@ -44,12 +44,209 @@ namespace Dune {
   {
   public:
     /** \brief The highest quadrature order available */
-    constexpr static int highest_order = 5;
+    constexpr static int highest_order = 15;
   private:
     friend class QuadratureRuleFactory<ct,3>;
     SimplexQuadratureRule (int p);
   };
 
+  namespace Impl {
+
+    /** \brief Types of orbits of points under the symmetries of a simplex
+     *
+     * The name lists how often the distinct barycentric coordinates of the points
+     * occur, e.g. the 12 points of an S211 orbit in a tetrahedron are all
+     * permutations of (a, a, b, 1-2a-b).
+     */
+    enum class SimplexOrbitType { S3, S21, S111, S4, S31, S22, S211, S1111 };
+
+    /** \brief Orbit of a fully symmetric rule, given by the weight of each of its points and the parameters a, b, c */
+    struct SimplexOrbit
+    {
+      SimplexOrbitType type;
+      double weight;
+      double a = 0.0;
+      double b = 0.0;
+      double c = 0.0;
+    };
+
+    //! number of points of an orbit
+    constexpr int simplexOrbitSize (SimplexOrbitType type)
+    {
+      switch (type)
+      {
+      case SimplexOrbitType::S3 :
+      case SimplexOrbitType::S4 :
+        return 1;
+      case SimplexOrbitType::S21 :
+        return 3;
+      case SimplexOrbitType::S31 :
+        return 4;
+      case SimplexOrbitType::S111 :
+      case SimplexOrbitType::S22 :
+        return 6;
+      case SimplexOrbitType::S211 :
+        return 12;
+      case SimplexOrbitType::S1111 :
+        return 24;
+      }
+      return 0;
+    }
+
+    //! fully symmetric rule of the given order, consisting of a list of orbits
+    struct SymmetricSimplexRule
+    {
+      template<std::size_t n>
+      constexpr SymmetricSimplexRule (int order, const SimplexOrbit (&orbits)[n])
+        : order(order), numOrbits(n), orbits(orbits)
+      {}
+
+      //! number of points
+      constexpr int size () const
+      {
+        int size = 0;
+        for (int k = 0; k < numOrbits; ++k)
+          size += simplexOrbitSize(orbits[k].type);
+        return size;
+      }
+
+      int order;
+      int numOrbits;
+      const SimplexOrbit* orbits;
+    };
+
+    //! total number of points of a list of rules
+    template<std::size_t n>
+    constexpr int symmetricSimplexRulesSize (const SymmetricSimplexRule (&rules)[n])
+    {
+      int size = 0;
+      for (std::size_t r = 0; r < n; ++r)
+        size += rules[r].size();
+      return size;
+    }
+
+    //! index of the rule with m points in a list of rules, or -1
+    template<std::size_t n>
+    constexpr int findSymmetricSimplexRule (const SymmetricSimplexRule (&rules)[n], int m, int& offset)
+    {
+      offset = 0;
+      for (std::size_t r = 0; r < n; ++r)
+      {
+        if (rules[r].size() == m)
+          return r;
+        offset += rules[r].size();
+      }
+      return -1;
+    }
+
+    // advance to the next permutation in lexicographical order, like std::next_permutation
+    template<int n>
+    constexpr bool nextSimplexPermutation (int (&perm)[n])
+    {
+      int i = n-1;
+      while (i > 0 && perm[i-1] >= perm[i])
+        --i;
+      if (i == 0)
+        return false;
+      int j = n-1;
+      while (perm[j] <= perm[i-1])
+        --j;
+      const int tmp = perm[i-1]; perm[i-1] = perm[j]; perm[j] = tmp;
+      for (int k = i, l = n-1; k < l; ++k, --l)
+      {
+        const int t = perm[k]; perm[k] = perm[l]; perm[l] = t;
+      }
+      return true;
+    }
+
+    /** \brief Write the points and weights of an orbit, returns the number of points
+     *
+     * The points are the distinct permutations of the barycentric coordinates of the
+     * orbit, the Cartesian coordinates of a point are its barycentric coordinates 1,...,dim.
+     */
+    template<int dim>
+    constexpr int expandSimplexOrbit (const SimplexOrbit& orbit, double (*points)[dim], double* weights)
+    {
+      // barycentric coordinates and the pattern of equal coordinates
+      double lambda[dim+1] = {};
+      int label[dim+1] = {};
+      const double a = orbit.a, b = orbit.b, c = orbit.c;
+      switch (orbit.type)
+      {
+      case SimplexOrbitType::S3 :
+      case SimplexOrbitType::S4 :
+        for (int i = 0; i <= dim; ++i)
+          lambda[i] = 1.0 / (dim+1);
+        break;
+      case SimplexOrbitType::S21 :
+        lambda[0] = a; lambda[1] = a; lambda[2] = 1.0 - 2.0*a;
+        label[2] = 1;
+        break;
+      case SimplexOrbitType::S111 :
+        lambda[0] = a; lambda[1] = b; lambda[2] = 1.0 - a - b;
+        label[1] = 1; label[2] = 2;
+        break;
+      case SimplexOrbitType::S31 :
+        lambda[0] = a; lambda[1] = a; lambda[2] = a; lambda[dim] = 1.0 - 3.0*a;
+        label[dim] = 1;
+        break;
+      case SimplexOrbitType::S22 :
+        lambda[0] = a; lambda[1] = a; lambda[2] = 0.5 - a; lambda[dim] = 0.5 - a;
+        label[2] = 1; label[dim] = 1;
+        break;
+      case SimplexOrbitType::S211 :
+        lambda[0] = a; lambda[1] = a; lambda[2] = b; lambda[dim] = 1.0 - 2.0*a - b;
+        label[2] = 1; label[dim] = 2;
+        break;
+      case SimplexOrbitType::S1111 :
+        lambda[0] = a; lambda[1] = b; lambda[2] = c; lambda[dim] = 1.0 - a - b - c;
+        label[1] = 1; label[2] = 2; label[dim] = 3;
+        break;
+      }
+
+      int perm[dim+1] = {};
+      for (int i = 0; i <= dim; ++i)
+        perm[i] = i;
+
+      int labels[24][dim+1] = {};
+      int n = 0;
+      do
+      {
+        // permutations of equal coordinates give the same point
+        bool seen = false;
+        for (int k = 0; k < n && !seen; ++k)
+        {
+          bool same = true;
+          for (int i = 0; i <= dim; ++i)
+            same = same && (labels[k][i] == label[perm[i]]);
+          seen = same;
+        }
+        if (seen)
+          continue;
+
+        for (int i = 0; i <= dim; ++i)
+          labels[n][i] = label[perm[i]];
+        for (int j = 0; j < dim; ++j)
+          points[n][j] = lambda[perm[j+1]];
+        weights[n] = orbit.weight;
+        ++n;
+      } while (nextSimplexPermutation(perm));
+
+      return n;
+    }
+
+    //! write the points and weights of a list of rules one after the other
+    template<int dim, std::size_t n>
+    constexpr void expandSymmetricSimplexRules (const SymmetricSimplexRule (&rules)[n], double (*points)[dim], double* weights)
+    {
+      int offset = 0;
+      for (std::size_t r = 0; r < n; ++r)
+        for (int k = 0; k < rules[r].numOrbits; ++k)
+          offset += expandSimplexOrbit<dim>(rules[r].orbits[k], points + offset, weights + offset);
+    }
+
+  } // end namespace Impl
+
   //!
   template<int dim>
   class SimplexQuadraturePoints;
@@ -68,20 +265,454 @@ namespace Dune {
     static SimplexQuadraturePoints<3> sqp;
   };
 
+  namespace Impl {
+
+    /* Fully symmetric rules for the triangle of degree 13 and higher.
+     *
+     * All weights are positive and all points are in the interior of the
+     * triangle. The rules have been computed by solving the moment equations
+     * for an orthogonal basis by a Levenberg-Marquardt method, followed by the
+     * elimination of orbits as in H. Xiao, Z. Gimbutas, A numerical algorithm
+     * for the construction of efficient quadrature rules in two and higher
+     * dimensions, Comput. Math. Appl. 59 (2010), and a Newton refinement in
+     * quadruple precision. The point counts are close to those given there.
+     */
+
+    // polynomial degree 13, 37 points
+    constexpr SimplexOrbit triangleOrbits13[] = {
+      { SimplexOrbitType::S3, 3.3980018293415822141e-2 },
+      { SimplexOrbitType::S21, 2.9139242559599990702e-2, 2.2137228629183290065e-1 },
+      { SimplexOrbitType::S21, 2.7800983765226664354e-2, 4.2694141425980040602e-1 },
+      { SimplexOrbitType::S21, 1.1997200964447365387e-2, 4.8907694645253934990e-1 },
+      { SimplexOrbitType::S21, 3.0261685517695859209e-3, 2.1509681108843183869e-2 },
+      { SimplexOrbitType::S111, 1.7320638070424185233e-2, 6.8012243554206654526e-2, 6.2354599555367557082e-1 },
+      { SimplexOrbitType::S111, 1.2089519905796909569e-2, 1.6359740106785048023e-1, 8.7895483032197324593e-2 },
+      { SimplexOrbitType::S111, 7.4827005525828336316e-3, 2.4370186901093829285e-2, 1.1092204280346339541e-1 },
+      { SimplexOrbitType::S111, 4.7953405017716313613e-3, 5.1263891023823685593e-3, 2.7251581777342966618e-1 },
+    };
+
+    // polynomial degree 14, 42 points
+    constexpr SimplexOrbit triangleOrbits14[] = {
+      { SimplexOrbitType::S21, 2.5887052253645793157e-2, 2.7347752830883865975e-1 },
+      { SimplexOrbitType::S21, 2.1081294368496508769e-2, 1.7720553241254343696e-1 },
+      { SimplexOrbitType::S21, 1.6394176772062675321e-2, 4.1764471934045392251e-1 },
+      { SimplexOrbitType::S21, 1.0941790684714445320e-2, 4.8896391036217863868e-1 },
+      { SimplexOrbitType::S21, 7.2168498348883338009e-3, 6.1799883090872601267e-2 },
+      { SimplexOrbitType::S21, 2.4617018012000408409e-3, 1.9390961248701048178e-2 },
+      { SimplexOrbitType::S111, 1.9285755393530341614e-2, 9.2916249356971824758e-2, 3.3686145979634500174e-1 },
+      { SimplexOrbitType::S111, 1.2332876606281836981e-2, 1.7226668782135557838e-1, 5.7124757403647939036e-2 },
+      { SimplexOrbitType::S111, 7.2181540567669202480e-3, 1.4646950055654409671e-2, 2.9837288213625775297e-1 },
+      { SimplexOrbitType::S111, 2.5051144192503358849e-3, 1.2683309328720250872e-3, 1.1897449769695684540e-1 },
+    };
+
+    // polynomial degree 15, 49 points
+    constexpr SimplexOrbit triangleOrbits15[] = {
+      { SimplexOrbitType::S3, 2.4777380743035579805e-2 },
+      { SimplexOrbitType::S21, 1.9011381726930579257e-2, 4.0886316907744105975e-1 },
+      { SimplexOrbitType::S21, 9.2433943023307730592e-3, 7.9031013655541635006e-2 },
+      { SimplexOrbitType::S21, 6.7052581900064143761e-3, 4.9250168823249670533e-1 },
+      { SimplexOrbitType::S21, 2.2485768962175402793e-3, 1.8789501810770077611e-2 },
+      { SimplexOrbitType::S111, 1.5630213780078803021e-2, 7.7663767064308164090e-2, 3.6883948374857540384e-1 },
+      { SimplexOrbitType::S111, 1.5087322572773133723e-2, 9.8765911355712115934e-2, 2.0250549804829997693e-1 },
+      { SimplexOrbitType::S111, 1.4605445387471889398e-2, 1.9412620368774630293e-1, 2.6709528567005227261e-1 },
+      { SimplexOrbitType::S111, 6.1808086085778203193e-3, 2.1594628433980258574e-2, 1.9495514589281161783e-1 },
+      { SimplexOrbitType::S111, 5.8747373242569702668e-3, 1.5082654870922784345e-2, 3.2515745241110782863e-1 },
+      { SimplexOrbitType::S111, 3.2209366452594664857e-3, 1.2563596287784997706e-2, 9.2290158424266168196e-2 },
+    };
+
+    // polynomial degree 16, 55 points
+    constexpr SimplexOrbit triangleOrbits16[] = {
+      { SimplexOrbitType::S3, 2.2822064532506629974e-2 },
+      { SimplexOrbitType::S21, 1.4794088000718613838e-2, 4.5784288577778510150e-1 },
+      { SimplexOrbitType::S21, 6.5633257176263694022e-3, 4.9164966410664828265e-1 },
+      { SimplexOrbitType::S21, 5.5998305217933193268e-3, 6.6152987645840422041e-2 },
+      { SimplexOrbitType::S21, 1.6883430316993016114e-3, 1.5990391506587955003e-2 },
+      { SimplexOrbitType::S111, 2.0149366539937084638e-2, 1.9125913712604979561e-1, 4.8535642929217568236e-1 },
+      { SimplexOrbitType::S111, 1.2858898354788906399e-2, 3.0347220386686132648e-1, 7.5194490553874163039e-2 },
+      { SimplexOrbitType::S111, 9.5423967537078503528e-3, 1.6164992070516818586e-1, 7.3400502253923177441e-2 },
+      { SimplexOrbitType::S111, 9.1857270799203058344e-3, 1.5735717180392130003e-1, 2.0294023374885133850e-1 },
+      { SimplexOrbitType::S111, 5.4973493926754084610e-3, 1.4373666994287819843e-2, 3.4009093003826817134e-1 },
+      { SimplexOrbitType::S111, 4.9238545675299058486e-3, 1.4896452463133050087e-2, 1.9884852334633847228e-1 },
+      { SimplexOrbitType::S111, 3.0492695867706313803e-3, 1.2456635066617947192e-2, 8.5301152923929527667e-2 },
+    };
+
+    // polynomial degree 17, 63 points
+    constexpr SimplexOrbit triangleOrbits17[] = {
+      { SimplexOrbitType::S21, 1.5556248492039004131e-2, 3.7273177125824922137e-1 },
+      { SimplexOrbitType::S21, 1.4919415491535366687e-2, 4.3390585094004992680e-1 },
+      { SimplexOrbitType::S21, 1.1680079918318163860e-2, 1.4102163341989357763e-1 },
+      { SimplexOrbitType::S21, 5.6270044171126668954e-3, 4.9345484468799487193e-1 },
+      { SimplexOrbitType::S21, 7.9910698652499190367e-4, 1.0596770129998616431e-2 },
+      { SimplexOrbitType::S111, 1.2659113625779182517e-2, 1.9883473147993872311e-1, 2.8439333135663177667e-1 },
+      { SimplexOrbitType::S111, 1.1489068648396010173e-2, 1.2103849048739158950e-1, 6.2136624134756036039e-1 },
+      { SimplexOrbitType::S111, 1.1076050330067080153e-2, 5.9519018592915305886e-2, 3.7813146273490830460e-1 },
+      { SimplexOrbitType::S111, 8.2617284086686545768e-3, 4.5005952878783551369e-2, 2.2069251378399098293e-1 },
+      { SimplexOrbitType::S111, 6.0387351416237735154e-3, 1.1035092022204978251e-1, 5.2708720715661707712e-2 },
+      { SimplexOrbitType::S111, 4.3299533932011038575e-3, 1.0034021966738056123e-2, 3.2515611082881102617e-1 },
+      { SimplexOrbitType::S111, 2.8170541745737232837e-3, 1.5039302531161251988e-2, 9.2313447063515407899e-1 },
+      { SimplexOrbitType::S111, 2.3707019582587085180e-3, 4.9689573797333115122e-3, 1.6723811405236527486e-1 },
+    };
+
+    // polynomial degree 18, 69 points
+    constexpr SimplexOrbit triangleOrbits18[] = {
+      { SimplexOrbitType::S21, 1.5745136674010571064e-2, 2.4274684065777901882e-1 },
+      { SimplexOrbitType::S21, 1.5442575150146926400e-2, 3.7329926762798172622e-1 },
+      { SimplexOrbitType::S21, 9.5400333738676185034e-3, 1.5760240660241164405e-1 },
+      { SimplexOrbitType::S21, 4.9837697172975156567e-3, 6.2178582213785613635e-2 },
+      { SimplexOrbitType::S21, 1.0268697026128932180e-3, 1.2555610427114823991e-2 },
+      { SimplexOrbitType::S111, 1.1604041979615925932e-2, 1.4636377218502190543e-1, 3.6630145904219687372e-1 },
+      { SimplexOrbitType::S111, 1.0524618974638089928e-2, 1.2287997273231433243e-1, 2.6024579884590442096e-1 },
+      { SimplexOrbitType::S111, 9.1943451037861707169e-3, 6.2155017556792296883e-2, 4.0185035383286171607e-1 },
+      { SimplexOrbitType::S111, 7.8229403704293183041e-3, 6.8996050426528893485e-2, 1.5111439208667192465e-1 },
+      { SimplexOrbitType::S111, 7.6399141334337648631e-3, 4.6099459823065415492e-2, 2.7158319560007901336e-1 },
+      { SimplexOrbitType::S111, 4.6339371703636150804e-3, 1.2039337348725795610e-2, 4.1790172204061402308e-1 },
+      { SimplexOrbitType::S111, 3.6888193757275971162e-3, 1.3738642387300313256e-2, 1.5366804235367634135e-1 },
+      { SimplexOrbitType::S111, 2.7003420864800404337e-3, 7.2323970522885093345e-3, 2.7464118736883364562e-1 },
+      { SimplexOrbitType::S111, 2.1551818298910485380e-3, 1.1710511132421020765e-2, 6.4733447765238887999e-2 },
+    };
+
+    // polynomial degree 19, 78 points
+    constexpr SimplexOrbit triangleOrbits19[] = {
+      { SimplexOrbitType::S21, 1.0593711900267470217e-2, 1.4901204469319280457e-1 },
+      { SimplexOrbitType::S21, 6.6520680933636497174e-3, 8.7540365691658893394e-2 },
+      { SimplexOrbitType::S21, 6.0619414855722647233e-3, 4.8274582322210172284e-1 },
+      { SimplexOrbitType::S21, 3.0493644512541407392e-3, 4.0590526375568415417e-2 },
+      { SimplexOrbitType::S111, 1.3824958444163313514e-2, 1.6958407703965434196e-1, 2.7019618641481920468e-1 },
+      { SimplexOrbitType::S111, 1.1298955991710082704e-2, 3.2872605503259464548e-1, 4.2199532246251335708e-1 },
+      { SimplexOrbitType::S111, 9.5387156164703913368e-3, 6.8219261581556971518e-2, 3.6647245023824012001e-1 },
+      { SimplexOrbitType::S111, 8.8545001697118287325e-3, 8.0392708785366168792e-2, 2.3724663139055864346e-1 },
+      { SimplexOrbitType::S111, 8.1565598867487224225e-3, 1.3579474599239048409e-1, 4.0046673774315008673e-1 },
+      { SimplexOrbitType::S111, 5.8290301359545949976e-3, 3.9297484525751195745e-2, 1.6182577525748841968e-1 },
+      { SimplexOrbitType::S111, 5.2005594503533047886e-3, 1.8732153881890910981e-2, 2.9514778611031503167e-1 },
+      { SimplexOrbitType::S111, 2.8077656448359219499e-3, 7.0785936714337317128e-3, 4.1606348739280741708e-1 },
+      { SimplexOrbitType::S111, 2.4835867025109685817e-3, 1.1589088793567363256e-2, 9.2465833604690762153e-2 },
+      { SimplexOrbitType::S111, 1.5250269109801670649e-3, 2.9713427979900657742e-3, 1.9909126347490383051e-1 },
+      { SimplexOrbitType::S111, 6.3513141466527454210e-4, 3.4659665306592953494e-3, 2.4340546080159556028e-2 },
+    };
+
+    // polynomial degree 20, 81 points
+    constexpr SimplexOrbit triangleOrbits20[] = {
+      { SimplexOrbitType::S21, 1.4425671157915442372e-2, 3.7340626999833777488e-1 },
+      { SimplexOrbitType::S21, 1.1249643804384125982e-2, 2.5537855441338929597e-1 },
+      { SimplexOrbitType::S21, 1.0466404255819807797e-2, 2.0002190896477791270e-1 },
+      { SimplexOrbitType::S21, 8.6400397107928406476e-3, 1.3507910426061986376e-1 },
+      { SimplexOrbitType::S21, 7.7416652619335833208e-3, 4.6025236122777892078e-1 },
+      { SimplexOrbitType::S21, 4.8927687996761701697e-3, 6.8216448105834059344e-2 },
+      { SimplexOrbitType::S21, 4.6820657481557686771e-3, 4.9357028607767973682e-1 },
+      { SimplexOrbitType::S21, 1.7303384733156550829e-3, 3.2767509310699949066e-2 },
+      { SimplexOrbitType::S21, 4.0194554220939661065e-4, 7.3096066568612093187e-3 },
+      { SimplexOrbitType::S111, 1.3192761308476267935e-2, 1.4974369449929915564e-1, 4.9894345995975925349e-1 },
+      { SimplexOrbitType::S111, 1.0360423868256762193e-2, 1.0217915944567104819e-1, 2.5578504747020409533e-1 },
+      { SimplexOrbitType::S111, 7.6673568478920370936e-3, 5.0194557373371885414e-2, 3.7497145996215360754e-1 },
+      { SimplexOrbitType::S111, 6.1998708341188449495e-3, 5.6842018502590340784e-2, 1.5711728446616102143e-1 },
+      { SimplexOrbitType::S111, 5.0952662116530626749e-3, 3.3098418218052466061e-2, 2.5703853897329291116e-1 },
+      { SimplexOrbitType::S111, 2.9093339122482441912e-3, 1.4117026294233749286e-2, 1.1158644177265312210e-1 },
+      { SimplexOrbitType::S111, 2.8566329400994940374e-3, 7.3310643188410841608e-3, 3.5266942902037073162e-1 },
+      { SimplexOrbitType::S111, 2.0443048197463707018e-3, 6.1394393862085646874e-3, 2.0881589530561429466e-1 },
+      { SimplexOrbitType::S111, 8.9211121374085422674e-4, 6.0147394324073504686e-3, 4.7127248036213046632e-2 },
+    };
+
+    // polynomial degree 21, 87 points
+    constexpr SimplexOrbit triangleOrbits21[] = {
+      { SimplexOrbitType::S21, 1.1500352326641931300e-2, 4.0361758654638511639e-1 },
+      { SimplexOrbitType::S21, 1.0725560964566170246e-2, 2.9893623531498257064e-1 },
+      { SimplexOrbitType::S21, 9.8072376139120101372e-3, 4.4981279177536239217e-1 },
+      { SimplexOrbitType::S21, 9.7276209303753552493e-3, 1.9028871809127849773e-1 },
+      { SimplexOrbitType::S21, 6.8280162261150988647e-3, 1.1898857762271940719e-1 },
+      { SimplexOrbitType::S21, 6.1072050816921909669e-3, 4.8159786865321661952e-1 },
+      { SimplexOrbitType::S21, 3.5760425506418256760e-3, 5.3627575546144939338e-2 },
+      { SimplexOrbitType::S21, 2.2189148485329395192e-3, 4.9700787546868558053e-1 },
+      { SimplexOrbitType::S21, 7.5434963618934455695e-4, 1.0742456432828395187e-2 },
+      { SimplexOrbitType::S111, 9.2237424239664167669e-3, 1.2377940040549275351e-1, 3.1886531079482824349e-1 },
+      { SimplexOrbitType::S111, 8.7477080778815615107e-3, 2.0529555933516150504e-1, 2.8918949607859476265e-1 },
+      { SimplexOrbitType::S111, 7.9520183527139864339e-3, 1.0045802007411443233e-1, 2.1659962318998254435e-1 },
+      { SimplexOrbitType::S111, 7.2501529594855099743e-3, 5.3052191701216797925e-2, 3.4680797980991109292e-1 },
+      { SimplexOrbitType::S111, 5.2349520926624222691e-3, 3.8991362623220328367e-2, 2.3187362537040097345e-1 },
+      { SimplexOrbitType::S111, 4.9059859112752053871e-3, 4.9451065568540524908e-2, 1.2882980796205153822e-1 },
+      { SimplexOrbitType::S111, 3.4199424289671529452e-3, 1.0254635872924476042e-2, 3.6095340801892220726e-1 },
+      { SimplexOrbitType::S111, 2.2404065609507376207e-3, 9.5362475297105602089e-3, 1.3316712294137028349e-1 },
+      { SimplexOrbitType::S111, 2.1030601440748645456e-3, 6.9318090314680546434e-3, 2.3787338259799400008e-1 },
+      { SimplexOrbitType::S111, 1.6327142920220426214e-3, 1.0301903643423833683e-2, 5.5719565072371984276e-2 },
+    };
+
+    // polynomial degree 22, 97 points
+    constexpr SimplexOrbit triangleOrbits22[] = {
+      { SimplexOrbitType::S3, 1.2489920884602892705e-2 },
+      { SimplexOrbitType::S21, 1.1431095516903048934e-2, 3.9338770652060980599e-1 },
+      { SimplexOrbitType::S21, 1.1180946726465272159e-2, 2.6712358749765548589e-1 },
+      { SimplexOrbitType::S21, 9.9904276864596289052e-3, 1.8868988139659902047e-1 },
+      { SimplexOrbitType::S21, 8.0276547904907068550e-3, 4.3682095085613281433e-1 },
+      { SimplexOrbitType::S21, 6.6118289917929314480e-3, 4.7830965370265217255e-1 },
+      { SimplexOrbitType::S21, 3.2116381700559462430e-3, 8.8879023116305720786e-2 },
+      { SimplexOrbitType::S21, 3.0150720064569071748e-3, 4.6715343793521291796e-2 },
+      { SimplexOrbitType::S21, 6.8317723376722469772e-5, 2.7424447043758705118e-4 },
+      { SimplexOrbitType::S111, 9.9233807346354184011e-3, 1.6620175006404557187e-1, 3.0049782679157483316e-1 },
+      { SimplexOrbitType::S111, 7.3856172431865894257e-3, 9.5856598788060269190e-2, 2.5496289296396140892e-1 },
+      { SimplexOrbitType::S111, 6.7902565280873852820e-3, 8.9111513115755146703e-2, 3.7060874543931831276e-1 },
+      { SimplexOrbitType::S111, 6.0415048995260809552e-3, 1.6265338198075845616e-1, 1.0185555189881584489e-1 },
+      { SimplexOrbitType::S111, 5.5188678577709084862e-3, 3.8827072147546129130e-2, 3.4130041957435238825e-1 },
+      { SimplexOrbitType::S111, 4.9322258091625836348e-3, 3.8431605852780787275e-2, 2.2223708768774450952e-1 },
+      { SimplexOrbitType::S111, 3.9919474112591855096e-3, 4.3313818087602274111e-2, 1.2542915391752860709e-1 },
+      { SimplexOrbitType::S111, 2.8864430471315362168e-3, 8.3135691299391928158e-3, 4.2744597315463409395e-1 },
+      { SimplexOrbitType::S111, 2.3385883634848567832e-3, 7.0924651521044098773e-3, 6.9867858108503489705e-1 },
+      { SimplexOrbitType::S111, 1.9919911452241653896e-3, 7.3623819452421613527e-3, 1.7706865540695151012e-1 },
+      { SimplexOrbitType::S111, 1.8105891746001726674e-3, 9.7448127486777777658e-3, 8.7879699584864284598e-2 },
+      { SimplexOrbitType::S111, 8.7177683249671970286e-4, 2.9313186192013178723e-2, 9.6308945709599925044e-1 },
+    };
+
+    // polynomial degree 23, 102 points
+    constexpr SimplexOrbit triangleOrbits23[] = {
+      { SimplexOrbitType::S21, 1.1544018243068713008e-2, 2.6458552650547402966e-1 },
+      { SimplexOrbitType::S21, 9.9803497164925077816e-3, 1.9825351517702736114e-1 },
+      { SimplexOrbitType::S21, 9.4849331805888834390e-3, 4.4540453588252973708e-1 },
+      { SimplexOrbitType::S21, 7.4220577649266455156e-3, 1.3620763473842133492e-1 },
+      { SimplexOrbitType::S21, 5.7563280660233673765e-3, 4.8124606623842562611e-1 },
+      { SimplexOrbitType::S21, 5.1713155360341734925e-3, 3.4872361279518734020e-1 },
+      { SimplexOrbitType::S21, 4.6879753031374025960e-3, 8.4108640586047956060e-2 },
+      { SimplexOrbitType::S21, 2.2204806473011040891e-3, 4.2111907908447421846e-2 },
+      { SimplexOrbitType::S21, 1.1823019120740342761e-3, 4.9901490030277319514e-1 },
+      { SimplexOrbitType::S21, 5.1013263039151058252e-4, 8.8286524851224221860e-3 },
+      { SimplexOrbitType::S111, 1.0272215612061480024e-2, 1.5302213601364430489e-1, 3.1576770557002417649e-1 },
+      { SimplexOrbitType::S111, 8.1129200808577854428e-3, 1.0089156886069723833e-1, 2.3979474760826854744e-1 },
+      { SimplexOrbitType::S111, 7.5059928937100530433e-3, 6.7447382411746284948e-2, 3.5930105664821707766e-1 },
+      { SimplexOrbitType::S111, 6.0839167232651356449e-3, 2.0772744646966142093e-1, 3.7977790228396686241e-1 },
+      { SimplexOrbitType::S111, 5.4738351605349707013e-3, 5.6483950211013473574e-2, 1.7068759816284808732e-1 },
+      { SimplexOrbitType::S111, 5.0582759682301037737e-3, 3.2797626040536724345e-2, 2.7779866163606636251e-1 },
+      { SimplexOrbitType::S111, 3.5084868915053591046e-3, 3.9392323642727109762e-1, 5.9227492968290471735e-1 },
+      { SimplexOrbitType::S111, 2.9067691315676235808e-3, 2.6530972563701020151e-2, 8.6844594799846074697e-1 },
+      { SimplexOrbitType::S111, 2.5526105635741571214e-3, 1.0554564894130594272e-2, 1.9465997717387672677e-1 },
+      { SimplexOrbitType::S111, 1.1201624882903826462e-3, 2.1219412355089785611e-3, 3.0040122234876994440e-1 },
+      { SimplexOrbitType::S111, 1.0534689202011495071e-3, 8.0385151316243646021e-3, 4.5935626063403688589e-2 },
+      { SimplexOrbitType::S111, 7.0473239951596166506e-4, 2.2299401341336727715e-3, 1.1134710774511908993e-1 },
+    };
+
+    // polynomial degree 24, 112 points
+    constexpr SimplexOrbit triangleOrbits24[] = {
+      { SimplexOrbitType::S3, 1.1143272013759643772e-2 },
+      { SimplexOrbitType::S21, 1.0701206340275154277e-2, 2.6984237679490675046e-1 },
+      { SimplexOrbitType::S21, 1.0318013153457971865e-2, 3.9033102104281959319e-1 },
+      { SimplexOrbitType::S21, 8.0638984735462819829e-3, 4.4214545797579775005e-1 },
+      { SimplexOrbitType::S21, 6.5987416479139905378e-3, 1.5812788264816500835e-1 },
+      { SimplexOrbitType::S21, 5.7812774368485839269e-3, 4.7675697012378004472e-1 },
+      { SimplexOrbitType::S21, 4.3132199078735560600e-3, 9.3874824655135164204e-2 },
+      { SimplexOrbitType::S21, 2.6686410013447789683e-3, 4.9554944456104510206e-1 },
+      { SimplexOrbitType::S21, 2.1291020592872510117e-3, 4.1496386486136382493e-2 },
+      { SimplexOrbitType::S21, 3.3100135657070381138e-4, 7.0553355906899597097e-3 },
+      { SimplexOrbitType::S111, 8.6237911416962258346e-3, 1.6143262913026705592e-1, 3.3159277345521735950e-1 },
+      { SimplexOrbitType::S111, 6.8604835408462251532e-3, 7.8294557177837534493e-2, 3.5965626516788963910e-1 },
+      { SimplexOrbitType::S111, 6.8183355707197742163e-3, 1.0793952649132285627e-1, 2.5502025180302949093e-1 },
+      { SimplexOrbitType::S111, 6.0871551018705475562e-3, 1.8374170869627185899e-1, 2.3901157396396197303e-1 },
+      { SimplexOrbitType::S111, 5.2423925111437837089e-3, 8.5144703413711480624e-2, 1.6984733643993381886e-1 },
+      { SimplexOrbitType::S111, 4.9574042610527962700e-3, 4.5335182753321130896e-2, 2.6603880487352363700e-1 },
+      { SimplexOrbitType::S111, 4.1680622304490066006e-3, 2.5457323746678635871e-2, 6.0062222140795532473e-1 },
+      { SimplexOrbitType::S111, 3.3489084451870067325e-3, 3.3673156446933649965e-2, 1.7540178172545807138e-1 },
+      { SimplexOrbitType::S111, 2.9268153275670266477e-3, 3.9003544682832442267e-2, 8.6211639843559150481e-1 },
+      { SimplexOrbitType::S111, 2.3105605162751742803e-3, 8.5711232294538657227e-3, 2.6943588626389669699e-1 },
+      { SimplexOrbitType::S111, 1.4342220378795973137e-3, 6.1833500616253983051e-3, 1.7144832725382022976e-1 },
+      { SimplexOrbitType::S111, 1.3115476925475052523e-3, 7.6497334160526221462e-3, 9.3039786304821326064e-2 },
+      { SimplexOrbitType::S111, 1.0542687561803556124e-3, 2.4797085587017236300e-3, 3.8166311113725857341e-1 },
+      { SimplexOrbitType::S111, 8.7962350906589797199e-4, 7.9674676650190014242e-3, 3.7741725861085525801e-2 },
+    };
+
+    // polynomial degree 25, 123 points
+    constexpr SimplexOrbit triangleOrbits25[] = {
+      { SimplexOrbitType::S21, 8.7554716867587413064e-3, 4.1827299152661586575e-1 },
+      { SimplexOrbitType::S21, 6.8127024073419493681e-3, 4.6135203533429871738e-1 },
+      { SimplexOrbitType::S21, 6.1738131336136608925e-3, 2.2564817501850455958e-1 },
+      { SimplexOrbitType::S21, 5.9903749099386736786e-3, 1.6374073250995533650e-1 },
+      { SimplexOrbitType::S21, 4.6583438258395416219e-3, 1.1350439831094262401e-1 },
+      { SimplexOrbitType::S21, 3.9439041068341998501e-3, 4.8864504975779335844e-1 },
+      { SimplexOrbitType::S21, 3.2085730779865980954e-3, 7.6268398887593501105e-2 },
+      { SimplexOrbitType::S21, 1.7333531081409375173e-3, 3.6994490670437686378e-2 },
+      { SimplexOrbitType::S21, 4.0431911533084264464e-4, 7.8555896930870303922e-3 },
+      { SimplexOrbitType::S111, 7.8877727304020246573e-3, 2.0601295325988068834e-1, 3.1009234026088689927e-1 },
+      { SimplexOrbitType::S111, 7.5292706870447477976e-3, 1.1487079266831740162e-1, 3.5155383760302071291e-1 },
+      { SimplexOrbitType::S111, 6.8684738611784028101e-3, 2.5026325999572537367e-1, 1.4416175990664270249e-1 },
+      { SimplexOrbitType::S111, 6.3964451529583808592e-3, 2.6852280769900042368e-1, 3.3337637251649077578e-1 },
+      { SimplexOrbitType::S111, 5.3098161143727855043e-3, 7.0411626482033029474e-2, 2.8332699507237629966e-1 },
+      { SimplexOrbitType::S111, 5.1576601220054062964e-3, 8.8380767726570888820e-2, 1.9449806458840635070e-1 },
+      { SimplexOrbitType::S111, 5.0732555112026399937e-3, 4.5059445770313160743e-2, 3.7950559749253905318e-1 },
+      { SimplexOrbitType::S111, 3.9220562786907500148e-3, 4.6010597126856041905e-2, 1.5447888795651746650e-1 },
+      { SimplexOrbitType::S111, 3.8888300320839531339e-3, 2.7717696983392547668e-2, 2.5086730888697016923e-1 },
+      { SimplexOrbitType::S111, 2.5774891335973571555e-3, 1.2490482361113719807e-2, 3.5024696967612046834e-1 },
+      { SimplexOrbitType::S111, 2.2295945627231292897e-3, 2.9105219035394446983e-2, 9.1326767285820629724e-2 },
+      { SimplexOrbitType::S111, 1.9307172969827916945e-3, 8.8551294491237629293e-3, 1.7497241891330689389e-1 },
+      { SimplexOrbitType::S111, 1.1476097487436581825e-3, 3.3611967224641587120e-3, 4.3642362491656928535e-1 },
+      { SimplexOrbitType::S111, 9.2995347619186810975e-4, 5.1519543414562711572e-3, 9.8972233191210795324e-2 },
+      { SimplexOrbitType::S111, 8.2337694861460483744e-4, 7.0121571096794834369e-3, 4.0985446349643506715e-2 },
+      { SimplexOrbitType::S111, 8.2058399064826050917e-4, 1.4107244856094263529e-3, 2.7054272152760025845e-1 },
+    };
+
+    // polynomial degree 26, 133 points
+    constexpr SimplexOrbit triangleOrbits26[] = {
+      { SimplexOrbitType::S3, 1.0592570447111657464e-2 },
+      { SimplexOrbitType::S21, 7.4816339319276534650e-3, 2.7335910947963056026e-1 },
+      { SimplexOrbitType::S21, 5.5364988677994462283e-3, 1.2046196722039633672e-1 },
+      { SimplexOrbitType::S21, 4.5331909883943638424e-3, 4.5044794418231746700e-1 },
+      { SimplexOrbitType::S21, 3.6122870439544563547e-3, 4.8551972976703680898e-1 },
+      { SimplexOrbitType::S21, 2.8031878569811531009e-3, 6.5871786904664753839e-2 },
+      { SimplexOrbitType::S21, 1.5227861512077330890e-3, 4.9736114805828361443e-1 },
+      { SimplexOrbitType::S21, 8.3971345850766778011e-4, 2.5411716377476074585e-2 },
+      { SimplexOrbitType::S21, 2.9863920281393484616e-4, 6.7353247788894716770e-3 },
+      { SimplexOrbitType::S111, 7.9513495342990547140e-3, 1.8608910783970141176e-1, 2.6308705424584966056e-1 },
+      { SimplexOrbitType::S111, 7.6113822837003959542e-3, 1.4681369448857407376e-1, 3.6740279721339778513e-1 },
+      { SimplexOrbitType::S111, 6.8556977933982156547e-3, 9.9668140197578370770e-2, 6.0086900911952354314e-1 },
+      { SimplexOrbitType::S111, 6.5514297054421710490e-3, 2.2365676047446718086e-1, 4.2343692441677494259e-1 },
+      { SimplexOrbitType::S111, 6.0593060259373015805e-3, 1.4272222271931369211e-1, 2.0197150177662250907e-1 },
+      { SimplexOrbitType::S111, 5.3781878931318847282e-3, 6.5302761409522412593e-2, 3.9943998997676065809e-1 },
+      { SimplexOrbitType::S111, 5.2307472640038271290e-3, 7.7202402199848014991e-2, 2.0412955165893799194e-1 },
+      { SimplexOrbitType::S111, 4.4189206065420178916e-3, 4.2358411294903716167e-2, 2.9244680773246016996e-1 },
+      { SimplexOrbitType::S111, 3.6549768310902405211e-3, 5.5658953112585587264e-2, 1.2763395734702109076e-1 },
+      { SimplexOrbitType::S111, 3.1137320050599197185e-3, 2.6990957950115989797e-2, 2.0221079752400124031e-1 },
+      { SimplexOrbitType::S111, 2.8879897763482956592e-3, 2.4892674661295139540e-2, 3.8117199512808604484e-1 },
+      { SimplexOrbitType::S111, 1.9649700929606863420e-3, 7.5244401854196344085e-3, 2.8115216027982054308e-1 },
+      { SimplexOrbitType::S111, 1.8467599459845747729e-3, 1.5856019031158555261e-2, 1.2287403151595589236e-1 },
+      { SimplexOrbitType::S111, 1.6282999598542076006e-3, 2.2852531309928685535e-2, 6.5151596370681772817e-2 },
+      { SimplexOrbitType::S111, 1.3420601990479435159e-3, 4.8484234251420794266e-3, 6.0783816402687873360e-1 },
+      { SimplexOrbitType::S111, 8.8609459945516075159e-4, 3.0416577434037933025e-3, 1.8365455301972899525e-1 },
+      { SimplexOrbitType::S111, 4.7881782770959225000e-4, 4.4466469358080011970e-3, 3.6386122728314998449e-2 },
+      { SimplexOrbitType::S111, 3.9321383072269623650e-4, 8.9213378221809776739e-2, 9.1014710367178908528e-1 },
+    };
+
+    // polynomial degree 27, 142 points
+    constexpr SimplexOrbit triangleOrbits27[] = {
+      { SimplexOrbitType::S3, 3.1490381859214529356e-3 },
+      { SimplexOrbitType::S21, 7.3605830606942461585e-3, 2.9864360742089780875e-1 },
+      { SimplexOrbitType::S21, 6.0842670223378107477e-3, 2.0547653359742053783e-1 },
+      { SimplexOrbitType::S21, 5.6485936042944744841e-3, 4.6112624659906346518e-1 },
+      { SimplexOrbitType::S21, 4.5256102778476078572e-3, 1.2569416554646760126e-1 },
+      { SimplexOrbitType::S21, 1.7418482766247600335e-3, 4.9691858399683527711e-1 },
+      { SimplexOrbitType::S21, 1.4601250964884873624e-3, 4.8493030204645472988e-2 },
+      { SimplexOrbitType::S21, 9.6303072476633257164e-4, 2.1877408176065914685e-2 },
+      { SimplexOrbitType::S111, 6.7878115678229077077e-3, 1.4046840857416983090e-1, 3.8151037467141401392e-1 },
+      { SimplexOrbitType::S111, 6.6540571028550286504e-3, 2.1294542253327808569e-1, 2.8672038177914385407e-1 },
+      { SimplexOrbitType::S111, 6.2877816504047118211e-3, 1.3747521461878350784e-1, 2.8785598519980293404e-1 },
+      { SimplexOrbitType::S111, 5.4725133305520946490e-3, 7.7236017403720745312e-2, 3.5888660561527837415e-1 },
+      { SimplexOrbitType::S111, 5.4712793877572916927e-3, 1.3251695330370603836e-1, 2.0099543326932922327e-1 },
+      { SimplexOrbitType::S111, 5.3360812972428445569e-3, 2.1786418375815405567e-1, 3.6155440208475387204e-1 },
+      { SimplexOrbitType::S111, 4.9396732944942632769e-3, 7.5273159746064130114e-2, 2.6148750926553336347e-1 },
+      { SimplexOrbitType::S111, 4.0886701848951307252e-3, 7.1525905477932196265e-2, 1.7426325430082483599e-1 },
+      { SimplexOrbitType::S111, 3.8778408865558925922e-3, 3.2140419388465382929e-2, 4.2986697566170968900e-1 },
+      { SimplexOrbitType::S111, 3.6432225116399913509e-3, 3.1785583444217980192e-2, 3.2446041191380150504e-1 },
+      { SimplexOrbitType::S111, 3.1565430293138712040e-3, 3.0591360008280602085e-2, 2.2690567258975329859e-1 },
+      { SimplexOrbitType::S111, 2.9074647934039148514e-3, 1.0304124817039085988e-1, 6.5303863646299691394e-2 },
+      { SimplexOrbitType::S111, 2.4390146813572515672e-3, 2.8295978910682101369e-2, 1.4249089788172370491e-1 },
+      { SimplexOrbitType::S111, 1.6920561163227287196e-3, 6.1423512157214002361e-3, 3.8748275992193467139e-1 },
+      { SimplexOrbitType::S111, 1.5633984364674717558e-3, 7.6055966167328035102e-2, 2.6004965044009620840e-2 },
+      { SimplexOrbitType::S111, 1.5356692021816934258e-3, 6.0242579509100049027e-3, 2.8350912598416162784e-1 },
+      { SimplexOrbitType::S111, 1.2654883385044968863e-3, 5.6673588662672195680e-3, 1.8985353446203997559e-1 },
+      { SimplexOrbitType::S111, 9.3838217614030992754e-4, 5.1994566103954563597e-3, 1.1070105734776256130e-1 },
+      { SimplexOrbitType::S111, 6.8160198717472490584e-4, 9.4391921736864756564e-1, 5.5542173477312641236e-3 },
+      { SimplexOrbitType::S111, 1.7791462906627796999e-4, 1.2953033808552177548e-2, 1.7257674465336223247e-3 },
+    };
+
+    // polynomial degree 28, 150 points
+    constexpr SimplexOrbit triangleOrbits28[] = {
+      { SimplexOrbitType::S21, 7.6012235964008461541e-3, 3.6238664601284525040e-1 },
+      { SimplexOrbitType::S21, 6.8506024741510364463e-3, 4.0352354207295611398e-1 },
+      { SimplexOrbitType::S21, 6.8122436986236956856e-3, 2.7570254573888209736e-1 },
+      { SimplexOrbitType::S21, 4.6172325219986036598e-3, 4.6548239534438478704e-1 },
+      { SimplexOrbitType::S21, 4.4228163346603582765e-3, 1.2829161456296925250e-1 },
+      { SimplexOrbitType::S21, 3.2053436599203998201e-3, 4.8551018575663679885e-1 },
+      { SimplexOrbitType::S21, 2.5946466312798233569e-3, 7.1243805992737844264e-2 },
+      { SimplexOrbitType::S21, 1.4290967168401401917e-3, 4.9718001414386949542e-1 },
+      { SimplexOrbitType::S21, 1.1434222769694444448e-3, 3.0656805099752271808e-2 },
+      { SimplexOrbitType::S21, 2.1826306609734203574e-4, 5.7470457099192816164e-3 },
+      { SimplexOrbitType::S111, 6.5964687062128600902e-3, 1.9716994870170860796e-1, 3.1270738462670968230e-1 },
+      { SimplexOrbitType::S111, 6.2363633713541737949e-3, 1.2441103647854231510e-1, 3.8781398484171895389e-1 },
+      { SimplexOrbitType::S111, 5.8452989693568847345e-3, 1.2877307678918984228e-1, 2.9215388558852128066e-1 },
+      { SimplexOrbitType::S111, 5.5957505783655718200e-3, 1.3704835007023701242e-1, 2.0255126248101114104e-1 },
+      { SimplexOrbitType::S111, 4.5754600223666714952e-3, 6.8135591613588009426e-2, 3.7045845178096332865e-1 },
+      { SimplexOrbitType::S111, 4.3764673455696069128e-3, 1.9768355868113196210e-1, 2.3306677025616395852e-1 },
+      { SimplexOrbitType::S111, 4.2201126597644582975e-3, 7.3540580453264216760e-2, 2.8067911240941187280e-1 },
+      { SimplexOrbitType::S111, 4.0896043925811359777e-3, 7.5575783647723648068e-2, 2.0078354420286492746e-1 },
+      { SimplexOrbitType::S111, 3.2504025867900001242e-3, 7.0053395031991773939e-2, 1.2977220069172562557e-1 },
+      { SimplexOrbitType::S111, 3.1427948177767115702e-3, 3.0812546251209665219e-2, 2.8993791825911330105e-1 },
+      { SimplexOrbitType::S111, 3.1049083658297166831e-3, 2.7637857789735087823e-2, 3.8662870551620518977e-1 },
+      { SimplexOrbitType::S111, 2.7970811578986791008e-3, 3.0997917874749454231e-2, 2.0372260350498951476e-1 },
+      { SimplexOrbitType::S111, 2.1252355293042287285e-3, 1.3090091651850013859e-1, 2.9052195748412545079e-2 },
+      { SimplexOrbitType::S111, 1.6617473325427418550e-3, 2.9002214325907491130e-2, 7.2871041257567938055e-2 },
+      { SimplexOrbitType::S111, 1.4002662093048117734e-3, 5.9169629793009822668e-3, 3.0283104281082440911e-1 },
+      { SimplexOrbitType::S111, 1.3033893312526482541e-3, 5.1775639513754267127e-3, 3.9861462781827961027e-1 },
+      { SimplexOrbitType::S111, 1.2672557851644838688e-3, 5.9267919884594497334e-3, 2.1453201570895540283e-1 },
+      { SimplexOrbitType::S111, 1.0139052690210869928e-3, 5.6242249375945558182e-3, 1.3731111916642774782e-1 },
+      { SimplexOrbitType::S111, 7.5771835639659181602e-4, 5.4678666659446121305e-3, 7.4791175500094164647e-2 },
+      { SimplexOrbitType::S111, 5.2565705800942440797e-4, 3.0425483966373150911e-2, 5.9526822696933708829e-3 },
+    };
+
+    // polynomial degree 29, 160 points
+    constexpr SimplexOrbit triangleOrbits29[] = {
+      { SimplexOrbitType::S3, 3.6812079245196909484e-3 },
+      { SimplexOrbitType::S21, 7.0544386340334400398e-3, 2.5333101578786741264e-1 },
+      { SimplexOrbitType::S21, 5.5300992664721229558e-3, 1.9598174272642177720e-1 },
+      { SimplexOrbitType::S21, 5.0553571525899440073e-3, 4.3440062579800201295e-1 },
+      { SimplexOrbitType::S21, 4.9730348141773061811e-3, 4.6462678956627659110e-1 },
+      { SimplexOrbitType::S21, 4.3092441940408516626e-3, 1.3034351454233334402e-1 },
+      { SimplexOrbitType::S21, 2.3548748169940471100e-3, 6.6755285223759642514e-2 },
+      { SimplexOrbitType::S21, 1.3670199343836020315e-3, 4.9730072964390159124e-1 },
+      { SimplexOrbitType::S21, 1.1064608183834806263e-3, 2.9519150116857974473e-2 },
+      { SimplexOrbitType::S21, 2.4312376290047239264e-4, 6.0893573427930366539e-3 },
+      { SimplexOrbitType::S111, 6.7006050047493318791e-3, 1.9367703982530723829e-1, 3.5503496000630986232e-1 },
+      { SimplexOrbitType::S111, 6.0929074427267363167e-3, 1.7000901793519765526e-1, 2.7850851448719995781e-1 },
+      { SimplexOrbitType::S111, 5.2512394534804595412e-3, 2.6628748185421994932e-1, 3.3180081154443365923e-1 },
+      { SimplexOrbitType::S111, 5.1976280349598764040e-3, 1.1751684792144775633e-1, 3.6122882666693242483e-1 },
+      { SimplexOrbitType::S111, 4.7149709927963917381e-3, 1.2735214746783391089e-1, 2.0147403566809809303e-1 },
+      { SimplexOrbitType::S111, 4.7072516147098798810e-3, 1.0367110541828542314e-1, 2.7854052466990539374e-1 },
+      { SimplexOrbitType::S111, 4.3014468950848630526e-3, 6.3640067815287798354e-2, 3.7004005428682209658e-1 },
+      { SimplexOrbitType::S111, 3.9088146103570024823e-3, 7.0992897668914631349e-2, 1.9419985863927560281e-1 },
+      { SimplexOrbitType::S111, 3.7060670969714854805e-3, 5.4785730433833936600e-2, 2.7847069049734660022e-1 },
+      { SimplexOrbitType::S111, 3.1991987523207255381e-3, 7.1961276892319030019e-2, 1.2329051258792022793e-1 },
+      { SimplexOrbitType::S111, 2.6012701345940928338e-3, 2.8683649434441006386e-2, 2.0194504748877712002e-1 },
+      { SimplexOrbitType::S111, 2.4622161702934953823e-3, 2.6243171439428809579e-2, 3.7046679059393260199e-1 },
+      { SimplexOrbitType::S111, 2.3655614709848725181e-3, 2.8556701382140229107e-2, 4.5087286463818558711e-1 },
+      { SimplexOrbitType::S111, 2.1855810960762279140e-3, 3.0370320477341691785e-2, 1.2920706421429072639e-1 },
+      { SimplexOrbitType::S111, 2.1555267976973533819e-3, 2.0812847392704440202e-2, 2.8785123422894609486e-1 },
+      { SimplexOrbitType::S111, 1.5553706100799466001e-3, 2.7005942681306450139e-2, 7.1890032899005422673e-2 },
+      { SimplexOrbitType::S111, 1.3083410512388569220e-3, 5.3384844944245246008e-3, 3.9963770025866290896e-1 },
+      { SimplexOrbitType::S111, 1.1254233628655928484e-3, 5.2308964196977915268e-3, 2.1584164317958373009e-1 },
+      { SimplexOrbitType::S111, 1.0535549715830890899e-3, 5.9092146719782291710e-3, 1.3894161695447809264e-1 },
+      { SimplexOrbitType::S111, 9.0633109031542611298e-4, 3.6944566286053668375e-3, 3.0606329289060761240e-1 },
+      { SimplexOrbitType::S111, 7.1123335792630713562e-4, 5.1179148283297300740e-3, 7.6945498437011694387e-2 },
+      { SimplexOrbitType::S111, 5.1243197044707161886e-4, 5.6039180777828818267e-3, 3.1809312640092279021e-2 },
+    };
+
+    constexpr SymmetricSimplexRule triangleRules[] = {
+      { 13, triangleOrbits13 },
+      { 14, triangleOrbits14 },
+      { 15, triangleOrbits15 },
+      { 16, triangleOrbits16 },
+      { 17, triangleOrbits17 },
+      { 18, triangleOrbits18 },
+      { 19, triangleOrbits19 },
+      { 20, triangleOrbits20 },
+      { 21, triangleOrbits21 },
+      { 22, triangleOrbits22 },
+      { 23, triangleOrbits23 },
+      { 24, triangleOrbits24 },
+      { 25, triangleOrbits25 },
+      { 26, triangleOrbits26 },
+      { 27, triangleOrbits27 },
+      { 28, triangleOrbits28 },
+      { 29, triangleOrbits29 },
+    };
+
+  } // end namespace Impl
+
   template<>
   class SimplexQuadraturePoints<2>
   {
   public:
     constexpr static int MAXP = 33;
-    constexpr static int highest_order = 12;
+    constexpr static int highest_order = 29;
 
     //! initialize quadrature points on the interval for all orders
-    SimplexQuadraturePoints ()
+    constexpr SimplexQuadraturePoints ()
     {
       init();
+      Impl::expandSymmetricSimplexRules<2>(Impl::triangleRules, SG, SW);
     }
 
-    void init()
+    constexpr void init()
     {
       int m = 0;
       O[m] = 0;
@@ -744,80 +1375,97 @@ namespace Dune {
       O[m] = 12;
     }
 
-    FieldVector<double, 2> point(int m, int i)
+    FieldVector<double, 2> point(int m, int i) const
     {
-      return G[m][i];
+      return { coordinate(m,i,0), coordinate(m,i,1) };
     }
 
-    double weight (int m, int i)
+    constexpr double coordinate (int m, int i, int j) const
     {
-      return W[m][i];
+      if (m <= MAXP)
+        return G[m][i][j];
+      int offset = 0;
+      Impl::findSymmetricSimplexRule(Impl::triangleRules, m, offset);
+      return SG[offset+i][j];
     }
 
-    int order (int m)
+    constexpr double weight (int m, int i) const
     {
-      return O[m];
+      if (m <= MAXP)
+        return W[m][i];
+      int offset = 0;
+      Impl::findSymmetricSimplexRule(Impl::triangleRules, m, offset);
+      return SW[offset+i];
+    }
+
+    constexpr int order (int m) const
+    {
+      if (m <= MAXP)
+        return O[m];
+      int offset = 0;
+      return Impl::triangleRules[Impl::findSymmetricSimplexRule(Impl::triangleRules, m, offset)].order;
+    }
+
+    //! number of points of the rule used for quadrature order p
+    static constexpr int numPoints (int p)
+    {
+      switch(p)
+      {
+      case 0 : // to be verified
+        return 1; // to be verified
+      case 1 :
+        return 1;
+      case 2 :
+        return 3;
+      case 3 :
+        return 4;
+      case 4 :
+        return 6;
+      case 5 :
+        return 7;
+      case 6 :
+        return 12;
+      case 7 :
+        return 12;
+      case 8 :
+        return 16;
+      case 9 :
+        return 19;
+      case 10 :
+        return 25;
+      case 11 :
+        return 28;
+      case 12 :
+        return 33;
+      }
+      // the symmetric rule with fewest points
+      for (const auto& rule : Impl::triangleRules)
+        if (rule.order >= p)
+          return rule.size();
+      return 33;
     }
 
   private:
-    FieldVector<double, 2> G[MAXP+1][MAXP];
+    double G[MAXP+1][MAXP][2] = {};
 
-    double W[MAXP+1][MAXP];     // weights associated with points
-    int O[MAXP+1];              // order of the rule
+    double W[MAXP+1][MAXP] = {};     // weights associated with points
+    int O[MAXP+1] = {};              // order of the rule
+
+    // the symmetric rules of Impl::triangleRules one after the other
+    constexpr static int numSymmetricPoints = Impl::symmetricSimplexRulesSize(Impl::triangleRules);
+    double SG[numSymmetricPoints][2] = {};
+    double SW[numSymmetricPoints] = {};
   };
 
   template<typename ct>
   SimplexQuadratureRule<ct,2>::SimplexQuadratureRule(int p) : QuadratureRule<ct,2>(GeometryTypes::triangle)
   {
-    int m;
     if (p>SimplexQuadraturePoints<2>::highest_order)
       DUNE_THROW(QuadratureOrderOutOfRange,
                  "QuadratureRule for order " << p << " and GeometryType "
                                              << this->type() << " not available");
 
-    switch(p)
-    {
-    case 0 : // to be verified
-      m=1; // to be verified
-      break;
-    case 1 :
-      m=1;
-      break;
-    case 2 :
-      m=3;
-      break;
-    case 3 :
-      m=4;
-      break;
-    case 4 :
-      m=6;
-      break;
-    case 5 :
-      m=7;
-      break;
-    case 6 :
-      m=12;
-      break;
-    case 7 :
-      m=12;
-      break;
-    case 8 :
-      m=16;
-      break;
-    case 9 :
-      m=19;
-      break;
-    case 10 :
-      m=25;
-      break;
-    case 11 :
-      m=28;
-      break;
-    case 12 :
-      m=33;
-      break;
-    default : m=33;
-    }
+    const int m = SimplexQuadraturePoints<2>::numPoints(p);
 
     this->delivered_order = SimplexQuadraturePointsSingleton<2>::sqp.order(m);
 
@@ -830,21 +1478,192 @@ namespace Dune {
     }
   }
 
+  namespace Impl {
+
+    /* Fully symmetric rules for the tetrahedron of degree 6 and higher.
+     *
+     * All weights are positive and all points are in the interior of the
+     * tetrahedron. The rules have been computed in the same way as the rules
+     * for the triangle. The point counts are close to those of the rules given
+     * by F.D. Witherden, P.E. Vincent, On the identification of symmetric
+     * quadrature rules for finite element methods, Comput. Math. Appl. 69 (2015)
+     * and J. Jaśkowiec, N. Sukumar, High-order symmetric cubature rules for
+     * tetrahedra and pyramids, Int. J. Numer. Meth. Eng. 122 (2021).
+     */
+
+    // polynomial degree 6, 24 points
+    constexpr SimplexOrbit tetrahedronOrbits6[] = {
+      { SimplexOrbitType::S31, 9.2261969239424531704e-3, 3.2233789014227551034e-1 },
+      { SimplexOrbitType::S31, 6.6537917096945816473e-3, 2.1460287125915202929e-1 },
+      { SimplexOrbitType::S31, 1.6795351758867737314e-3, 4.0673958534611353116e-2 },
+      { SimplexOrbitType::S211, 8.0357142857142852682e-3, 6.3661001875017525299e-2, 2.6967233145831580803e-1 },
+    };
+
+    // polynomial degree 7, 35 points
+    constexpr SimplexOrbit tetrahedronOrbits7[] = {
+      { SimplexOrbitType::S4, 1.5914214910688473927e-2 },
+      { SimplexOrbitType::S31, 7.0549302016611711211e-3, 3.1570114977820279942e-1 },
+      { SimplexOrbitType::S22, 5.3161546388095963606e-3, 5.0489822598396368763e-2 },
+      { SimplexOrbitType::S211, 6.2011884547224365507e-3, 1.8883383102600104774e-1, 5.7517163758700002348e-1 },
+      { SimplexOrbitType::S211, 1.3517951383172235193e-3, 2.1265472541483245989e-2, 1.4663881381848494690e-1 },
+    };
+
+    // polynomial degree 8, 48 points
+    constexpr SimplexOrbit tetrahedronOrbits8[] = {
+      { SimplexOrbitType::S31, 9.4257635875858227603e-3, 1.8926038890520105872e-1 },
+      { SimplexOrbitType::S31, 5.7749462224421796865e-3, 3.1982339131354124104e-1 },
+      { SimplexOrbitType::S31, 1.6257821752900214564e-3, 4.6021999319028678244e-2 },
+      { SimplexOrbitType::S211, 3.8276515189817511117e-3, 1.6479604826571659169e-1, 6.3806141798757625106e-1 },
+      { SimplexOrbitType::S211, 3.5333071800154893394e-3, 4.2841241395851659754e-1, 1.0619113370573871729e-1 },
+      { SimplexOrbitType::S211, 9.1909952811897303238e-4, 1.4824780973448042005e-2, 7.0154588374357505083e-1 },
+    };
+
+    // polynomial degree 9, 65 points
+    constexpr SimplexOrbit tetrahedronOrbits9[] = {
+      { SimplexOrbitType::S4, 8.4532549075598441940e-3 },
+      { SimplexOrbitType::S31, 1.3053010324396937032e-3, 4.3119198410113575833e-2 },
+      { SimplexOrbitType::S211, 4.4393794730038668359e-3, 1.2410324443950734094e-1, 2.9865259344725306264e-1 },
+      { SimplexOrbitType::S211, 3.2446584041848275952e-3, 1.6765110427663275689e-1, 3.6031817533467532862e-2 },
+      { SimplexOrbitType::S211, 2.0078463357801239666e-3, 2.8442299513360972045e-1, 4.0043985335198325843e-1 },
+      { SimplexOrbitType::S211, 1.7151235262268397106e-3, 4.5411994361758091274e-1, 8.8622840919858284504e-3 },
+      { SimplexOrbitType::S211, 1.3423428965833450923e-3, 2.8618086676055766849e-2, 2.2183160806104040802e-1 },
+    };
+
+    // polynomial degree 10, 85 points
+    constexpr SimplexOrbit tetrahedronOrbits10[] = {
+      { SimplexOrbitType::S4, 3.8742194903924470264e-3 },
+      { SimplexOrbitType::S31, 4.7038490125470061376e-3, 1.4985396511914126432e-1 },
+      { SimplexOrbitType::S31, 1.8759649679257481317e-3, 3.2948591016764574348e-1 },
+      { SimplexOrbitType::S31, 1.8512153363143213591e-4, 1.8710817356329537437e-2 },
+      { SimplexOrbitType::S211, 3.4032103667131565906e-3, 3.5128304352124946332e-1, 1.0350053496661216007e-1 },
+      { SimplexOrbitType::S211, 1.5904357804491179239e-3, 1.5407655410560992296e-1, 2.7844347070541237406e-2 },
+      { SimplexOrbitType::S211, 1.1054192965070067947e-3, 3.1815397892225144433e-2, 1.3756969624463405323e-1 },
+      { SimplexOrbitType::S211, 1.0701398733278522146e-3, 2.6101490518772053732e-2, 3.5132728788722421037e-1 },
+      { SimplexOrbitType::S1111, 2.0709267214954942701e-3, 2.9637400324415302774e-2, 1.3361817394046675594e-1, 3.1843480243915957361e-1 },
+    };
+
+    // polynomial degree 11, 109 points
+    constexpr SimplexOrbit tetrahedronOrbits11[] = {
+      { SimplexOrbitType::S4, 1.6053926815505659386e-3 },
+      { SimplexOrbitType::S31, 2.6463989175986231799e-3, 1.2051666177580561733e-1 },
+      { SimplexOrbitType::S31, 1.3208117030228842464e-3, 3.2598940213616297177e-1 },
+      { SimplexOrbitType::S31, 5.0178816512082163710e-4, 3.1292728353410021185e-2 },
+      { SimplexOrbitType::S211, 3.3537167186779465577e-3, 2.4020243015672734075e-1, 1.1712449741738980725e-1 },
+      { SimplexOrbitType::S211, 2.6532605328914459900e-3, 8.7997259298171045783e-2, 5.1536931730490615003e-1 },
+      { SimplexOrbitType::S211, 1.3348610290143098415e-3, 1.4534754896335603229e-1, 2.0891854650586311448e-2 },
+      { SimplexOrbitType::S211, 8.7407467637956482017e-4, 2.8161035506196082161e-2, 7.8550983697762178200e-1 },
+      { SimplexOrbitType::S1111, 1.3993415747609982604e-3, 2.2536018784627081310e-2, 1.7548995714261936591e-1, 3.1434710075871556248e-1 },
+      { SimplexOrbitType::S1111, 6.2542189851348376922e-4, 8.1228297756224673603e-3, 5.0707687878882063768e-2, 3.5784211704688002777e-1 },
+    };
+
+    // polynomial degree 12, 145 points
+    constexpr SimplexOrbit tetrahedronOrbits12[] = {
+      { SimplexOrbitType::S4, 4.6546543768724899772e-3 },
+      { SimplexOrbitType::S31, 2.0081096571229189253e-3, 3.2465782021894215026e-1 },
+      { SimplexOrbitType::S31, 1.6044447691641696050e-3, 8.9306785109790805113e-2 },
+      { SimplexOrbitType::S31, 3.3320926218167912418e-4, 2.7175929274925452887e-2 },
+      { SimplexOrbitType::S22, 1.3234132389055226416e-3, 7.4870363087687392185e-2 },
+      { SimplexOrbitType::S22, 6.2040452048279847641e-4, 2.4180772769985145226e-2 },
+      { SimplexOrbitType::S211, 2.4991325072625424223e-3, 2.0204609641078303734e-1, 5.0086138045701431944e-1 },
+      { SimplexOrbitType::S211, 2.3480439349666005247e-3, 3.4893565103822678999e-1, 1.0814982774689434963e-1 },
+      { SimplexOrbitType::S211, 1.4054442943263675148e-3, 4.1868299339833044396e-1, 1.4151293172135144969e-1 },
+      { SimplexOrbitType::S211, 9.3930233380163425853e-4, 2.2435893878313682383e-1, 5.4067402148147926110e-1 },
+      { SimplexOrbitType::S211, 5.0431455121803768406e-4, 1.1187155545233252794e-1, 7.6720894275144960065e-1 },
+      { SimplexOrbitType::S211, 4.0447076219234289324e-4, 1.9689789679265099755e-2, 8.1781235564789555162e-1 },
+      { SimplexOrbitType::S1111, 1.2638252492443445442e-3, 4.1073085648848594306e-2, 9.5830571034682895092e-2, 2.4461618835520290188e-1 },
+      { SimplexOrbitType::S1111, 2.9273934968810822830e-4, 2.7747605697574843248e-4, 4.5425322048615737735e-2, 3.1241978870827033362e-1 },
+    };
+
+    // polynomial degree 13, 164 points
+    constexpr SimplexOrbit tetrahedronOrbits13[] = {
+      { SimplexOrbitType::S31, 3.2330573244733039876e-3, 1.8006120810694446685e-1 },
+      { SimplexOrbitType::S31, 2.7949278530414293891e-3, 2.8378831466978862897e-1 },
+      { SimplexOrbitType::S31, 1.2638863669266260860e-3, 7.9370167796877813891e-2 },
+      { SimplexOrbitType::S31, 9.3575657110401401401e-4, 3.3094117799510473342e-1 },
+      { SimplexOrbitType::S31, 2.1128533778381753197e-4, 2.3189878159146518728e-2 },
+      { SimplexOrbitType::S22, 1.6972186049932244465e-3, 5.3649273040221661517e-2 },
+      { SimplexOrbitType::S22, 2.0174129000356791978e-4, 8.2804150625687281447e-3 },
+      { SimplexOrbitType::S211, 2.3045619574093813058e-3, 3.6667402553646075136e-1, 8.3823172226452499804e-2 },
+      { SimplexOrbitType::S211, 2.1073101014655163602e-3, 9.2301441132139623509e-2, 2.3306588264652398641e-1 },
+      { SimplexOrbitType::S211, 6.8366733138091389462e-4, 2.4561267266384500251e-2, 6.6853076606102517845e-1 },
+      { SimplexOrbitType::S1111, 1.1882538288564483976e-3, 3.2286809321511059455e-2, 2.8704918217314412469e-1, 1.9355373244271590774e-1 },
+      { SimplexOrbitType::S1111, 6.2995901621746892192e-4, 1.1465375699479012893e-1, 1.9536235310122337336e-2, 1.8099669089709694048e-1 },
+      { SimplexOrbitType::S1111, 4.4996830257029544990e-4, 2.1285003954689834897e-3, 1.1214136423487669355e-1, 3.4655498248860531308e-1 },
+      { SimplexOrbitType::S1111, 2.4726805236826224954e-4, 8.3598034344042244869e-3, 3.8860738512870505491e-2, 1.2254847772831290773e-1 },
+    };
+
+    // polynomial degree 14, 212 points
+    constexpr SimplexOrbit tetrahedronOrbits14[] = {
+      { SimplexOrbitType::S31, 9.6252500896374885143e-4, 7.9069368193835806158e-2 },
+      { SimplexOrbitType::S31, 1.6527029692606233713e-5, 4.3448144747741336409e-3 },
+      { SimplexOrbitType::S22, 1.3560799681385805988e-3, 9.4468802991261989432e-2 },
+      { SimplexOrbitType::S22, 1.0056313439495653179e-3, 1.1768453133704246173e-1 },
+      { SimplexOrbitType::S211, 1.9530692886959026553e-3, 1.0020181380492288436e-1, 5.8315524030516948998e-1 },
+      { SimplexOrbitType::S211, 1.6002188844096558968e-3, 2.3810749339996364132e-1, 3.6828204100547019390e-1 },
+      { SimplexOrbitType::S211, 1.5763795933344404887e-3, 2.2970606163366019854e-1, 4.5770325797365818927e-1 },
+      { SimplexOrbitType::S211, 1.1502471488054593625e-3, 3.6305309938413354914e-1, 5.5290944741297794025e-2 },
+      { SimplexOrbitType::S211, 1.0410553667420831835e-3, 2.0621727955827633624e-1, 5.7030063778283565141e-1 },
+      { SimplexOrbitType::S211, 8.3842119778856353248e-4, 3.8476258372017690413e-1, 1.1213435835648551860e-2 },
+      { SimplexOrbitType::S211, 2.1810466903908383490e-4, 4.8209063315373583499e-1, 1.1641221885633266922e-2 },
+      { SimplexOrbitType::S211, 1.4475712227054092491e-4, 4.5738126877683595795e-2, 1.6180190898227548089e-2 },
+      { SimplexOrbitType::S1111, 1.0061695927060249840e-3, 2.0520465433457490587e-2, 9.1233059453270375909e-2, 3.4416863491575290938e-1 },
+      { SimplexOrbitType::S1111, 6.5323883598830433738e-4, 1.9689022179553471480e-2, 7.9993694561656681410e-2, 1.7264024587866570528e-1 },
+      { SimplexOrbitType::S1111, 1.7105534022731392660e-4, 2.0234816537706463390e-2, 1.2608940809654495392e-2, 2.8208434614616082254e-1 },
+      { SimplexOrbitType::S1111, 9.9250872181840211398e-5, 1.9531898623257933323e-3, 2.8653106776867320218e-2, 1.1580766508236156030e-1 },
+    };
+
+    // polynomial degree 15, 258 points
+    constexpr SimplexOrbit tetrahedronOrbits15[] = {
+      { SimplexOrbitType::S31, 1.7770069642548725603e-3, 1.4330530458135485396e-1 },
+      { SimplexOrbitType::S31, 7.7289792547831203704e-4, 7.4979019118913058172e-2 },
+      { SimplexOrbitType::S31, 8.1106974498310864891e-5, 1.6716792427392542950e-2 },
+      { SimplexOrbitType::S22, 6.0275591653408615739e-4, 1.3692183494032550013e-1 },
+      { SimplexOrbitType::S211, 1.3029320059546170200e-3, 2.2986946165581044480e-1, 1.7007372525486649211e-1 },
+      { SimplexOrbitType::S211, 8.9265985487967513330e-4, 3.2949612729843886414e-1, 8.2257552075259093967e-2 },
+      { SimplexOrbitType::S211, 8.5847740098867655083e-4, 4.2481053834873971434e-1, 1.6038970030032833061e-2 },
+      { SimplexOrbitType::S211, 8.3662813643929063018e-4, 1.7747931427641558581e-1, 5.9218192232299232375e-1 },
+      { SimplexOrbitType::S211, 3.5519508104178076261e-4, 1.0308046830276957965e-1, 9.1734378218209285998e-3 },
+      { SimplexOrbitType::S211, 2.4993462807878506970e-4, 1.9060582944655200172e-2, 9.0751809611854076381e-2 },
+      { SimplexOrbitType::S1111, 1.5632619847523479648e-3, 7.7091393821170682183e-2, 1.5696823278758640923e-1, 4.6858307582454842924e-1 },
+      { SimplexOrbitType::S1111, 5.9485508904892490452e-4, 4.4175669671000389399e-2, 8.1238420353445688770e-2, 1.9353736186413849257e-1 },
+      { SimplexOrbitType::S1111, 5.3339656559223098878e-4, 5.4867011231940548020e-2, 4.5772399449793696484e-2, 3.5968889923842941234e-1 },
+      { SimplexOrbitType::S1111, 5.2609428734807402101e-4, 1.6115747374944907902e-2, 2.8454412181975898189e-1, 4.3884460667653862728e-1 },
+      { SimplexOrbitType::S1111, 5.2238569712868937792e-4, 9.4614286091142497306e-3, 1.2882727657908096023e-1, 2.5605406933291424344e-1 },
+      { SimplexOrbitType::S1111, 1.9586237797022679982e-4, 7.4134128862662412764e-3, 3.1597190015570226095e-2, 2.2356288457656852407e-1 },
+      { SimplexOrbitType::S1111, 1.7148393240709996908e-4, 9.6131829469448595719e-4, 3.3690056400441854260e-2, 3.9414727740416809796e-1 },
+    };
+
+    constexpr SymmetricSimplexRule tetrahedronRules[] = {
+      { 6, tetrahedronOrbits6 },
+      { 7, tetrahedronOrbits7 },
+      { 8, tetrahedronOrbits8 },
+      { 9, tetrahedronOrbits9 },
+      { 10, tetrahedronOrbits10 },
+      { 11, tetrahedronOrbits11 },
+      { 12, tetrahedronOrbits12 },
+      { 13, tetrahedronOrbits13 },
+      { 14, tetrahedronOrbits14 },
+      { 15, tetrahedronOrbits15 },
+    };
+
+  } // end namespace Impl
+
   //!
   template<>
   class SimplexQuadraturePoints<3>
   {
   public:
     constexpr static int MAXP = 15;
-    constexpr static int highest_order = 5;
+    constexpr static int highest_order = 15;
 
     //! initialize quadrature points on the interval for all orders
-    SimplexQuadraturePoints()
+    constexpr SimplexQuadraturePoints ()
     {
       init();
+      Impl::expandSymmetricSimplexRules<3>(Impl::tetrahedronRules, SG, SW);
     }
 
-    void init()
+    constexpr void init()
     {
       int m = 0;
       O[m] = 0;
@@ -875,12 +1694,11 @@ namespace Dune {
       // For further reference: Rule 2-1, P. 307, A.H. Stroud, Approximate Calculation of Multiple Integrals
 
       m = 4;
-      static const double m_4_a = 0.585410196624968500;
-      static const double m_4_b = 0.138196601125010500;
-      G[m][0] = m_4_b;
-      G[m][1] = m_4_b;
-      G[m][2] = m_4_b;
-      G[m][3] = m_4_b;
+      constexpr double m_4_a = 0.585410196624968500;
+      constexpr double m_4_b = 0.138196601125010500;
+      for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 3; ++j)
+          G[m][i][j] = m_4_b;
       G[m][0][0] = m_4_a;
       G[m][1][1] = m_4_a;
       G[m][2][2] = m_4_a;
@@ -945,16 +1763,16 @@ namespace Dune {
 
       // For further reference: Rule 5-1, P. 315, A.H. Stroud, Approximate Calculation of Multiple Integrals
 
-      static const double s_1=0.09197107805272303279;     /* (7 - sqrt(15) ) / 34 */
-      static const double s_2=0.31979362782962990839;     /* (7 + sqrt(15) ) / 34 */
-      static const double t_1=0.72408676584183090164;     /* (13 + 3*sqrt(15) ) / 34 */
-      static const double t_2=0.04061911651111027484;     /* (13 - 3*sqrt(15) ) / 34 */
-      static const double u  =0.05635083268962915574;     /* (10 - 2*sqrt(15) ) / 40 */
-      static const double v  =0.44364916731037084426;     /* (10 + 2*sqrt(15) ) / 40 */
-      static const double A  =0.019753086419753086420;    /* 16 / 135 / vol */
-      static const double B_1=0.011989513963169770001;    /* (2665 + 14*sqrt(15) ) / 37800 / vol */
-      static const double B_2=0.011511367871045397547;    /* (2665 - 14*sqrt(15) ) / 37800 / vol */
-      static const double C  =0.0088183421516754850088;   /* 20 / 378 / vol */
+      constexpr double s_1=0.09197107805272303279;     /* (7 - sqrt(15) ) / 34 */
+      constexpr double s_2=0.31979362782962990839;     /* (7 + sqrt(15) ) / 34 */
+      constexpr double t_1=0.72408676584183090164;     /* (13 + 3*sqrt(15) ) / 34 */
+      constexpr double t_2=0.04061911651111027484;     /* (13 - 3*sqrt(15) ) / 34 */
+      constexpr double u  =0.05635083268962915574;     /* (10 - 2*sqrt(15) ) / 40 */
+      constexpr double v  =0.44364916731037084426;     /* (10 + 2*sqrt(15) ) / 40 */
+      constexpr double A  =0.019753086419753086420;    /* 16 / 135 / vol */
+      constexpr double B_1=0.011989513963169770001;    /* (2665 + 14*sqrt(15) ) / 37800 / vol */
+      constexpr double B_2=0.011511367871045397547;    /* (2665 - 14*sqrt(15) ) / 37800 / vol */
+      constexpr double C  =0.0088183421516754850088;   /* 20 / 378 / vol */
 
       m=15;
       G[m][0][0] = 0.25;
@@ -1022,55 +1840,82 @@ namespace Dune {
 
     }
 
-    FieldVector<double, 3> point(int m, int i)
+    FieldVector<double, 3> point(int m, int i) const
+    {
+      return { coordinate(m,i,0), coordinate(m,i,1), coordinate(m,i,2) };
+    }
+
+    constexpr double coordinate (int m, int i, int j) const
+    {
+      if (m <= MAXP)
+        return G[m][i][j];
+      int offset = 0;
+      Impl::findSymmetricSimplexRule(Impl::tetrahedronRules, m, offset);
+      return SG[offset+i][j];
+    }
+
+    constexpr double weight (int m, int i) const
     {
-      return G[m][i];
+      if (m <= MAXP)
+        return W[m][i];
+      int offset = 0;
+      Impl::findSymmetricSimplexRule(Impl::tetrahedronRules, m, offset);
+      return SW[offset+i];
     }
 
-    double weight (int m, int i)
+    constexpr int order (int m) const
     {
-      return W[m][i];
+      if (m <= MAXP)
+        return O[m];
+      int offset = 0;
+      return Impl::tetrahedronRules[Impl::findSymmetricSimplexRule(Impl::tetrahedronRules, m, offset)].order;
     }
 
-    int order (int m)
+    //! number of points of the rule used for quadrature order p
+    static constexpr int numPoints (int p)
     {
-      return O[m];
+      switch(p)
+      {
+      case 0 :
+        return 1;
+      case 1 :
+        return 1;
+      case 2 :
+        return 4;
+      case 3 :
+        return 8;
+      case 4 :
+      case 5 :
+        return 15;
+      }
+      // the symmetric rule with fewest points
+      for (const auto& rule : Impl::tetrahedronRules)
+        if (rule.order >= p)
+          return rule.size();
+      return 15;
     }
 
   private:
-    FieldVector<double, 3> G[MAXP+1][MAXP];
-    double W[MAXP+1][MAXP];     // weights associated with points
-    int O[MAXP+1];              // order of the rule
+    double G[MAXP+1][MAXP][3] = {};
+    double W[MAXP+1][MAXP] = {};     // weights associated with points
+    int O[MAXP+1] = {};              // order of the rule
+
+    // the symmetric rules of Impl::tetrahedronRules one after the other
+    constexpr static int numSymmetricPoints = Impl::symmetricSimplexRulesSize(Impl::tetrahedronRules);
+    double SG[numSymmetricPoints][3] = {};
+    double SW[numSymmetricPoints] = {};
   };
 
   template<typename ct>
   SimplexQuadratureRule<ct,3>::SimplexQuadratureRule(int p) : QuadratureRule<ct,3>(GeometryTypes::tetrahedron)
   {
-    int m;
     if (p>SimplexQuadraturePoints<3>::highest_order)
       DUNE_THROW(QuadratureOrderOutOfRange,
                  "QuadratureRule for order " << p << " and GeometryType "
                                              << this->type() << " not available");
-    switch(p)
-    {
-    case 0 :
-      m=1;
-      break;
-    case 1 :
-      m=1;
-      break;
-    case 2 :
-      m=4;
-      break;
-    case 3 :
-      m=8;
-      break;
-    case 4 :
-    case 5 :
-      m=15;
-      break;
-    default : m=15;
-    }
+
+    const int m = SimplexQuadraturePoints<3>::numPoints(p);
+
     this->delivered_order = SimplexQuadraturePointsSingleton<3>::sqp.order(m);
 
     for(int i=0; i<m; ++i)
@@ -0,0 +1,214 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_SINGULARQUADRATURERULE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_SINGULARQUADRATURERULE_HH
+
+/** \file
+ * \brief Quadrature rules for integrands with a singularity at a vertex or edge of the reference element
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/quadraturerules/lazytable.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+#include <dune/geometry/typeindex.hh>
+
+namespace Dune {
+
+  namespace Impl {
+
+    /** \brief Append the points of the rule on the reference element of type t, singular at the given vertices
+     *
+     * The reference element is split into the cones from the first singular
+     * vertex over the faces that do not contain it. A cone is parametrized by
+     * \f$x = a + s(F(\eta) - a)\f$ with the face point \f$F(\eta)\f$, and its
+     * Jacobian contains the factor \f$s^{dim-1}\f$ vanishing at the apex a. The
+     * faces are integrated by the same construction, singular at the remaining
+     * singular vertices on them, and regular by QuadratureRules otherwise.
+     */
+    template<class ctype, int dim>
+    void singularQuadraturePoints (const GeometryType& t, const std::vector<int>& singularVertices, int p,
+                                   QuadratureType::Enum qt, std::vector<QuadraturePoint<ctype,dim> >& points)
+    {
+      if constexpr (dim > 0)
+      {
+        if (!singularVertices.empty())
+        {
+          const auto refElement = referenceElement<ctype,dim>(t);
+          const int apex = singularVertices.front();
+          const FieldVector<ctype,dim> a = refElement.position(apex, dim);
+          // exact for polynomials of order p times the Jacobian of the cone
+          const QuadratureRule<ctype,1>& radialRule = QuadratureRules<ctype,1>::rule(GeometryTypes::line, p + dim - 1, qt);
+
+          for (int f = 0; f < refElement.size(1); ++f)
+          {
+            std::vector<int> faceSingularVertices;
+            bool containsApex = false;
+            for (int k = 0; k < refElement.size(f, 1, dim); ++k)
+            {
+              const int vertex = refElement.subEntity(f, 1, k, dim);
+              containsApex = containsApex || vertex == apex;
+              if (std::find(singularVertices.begin(), singularVertices.end(), vertex) != singularVertices.end())
+                faceSingularVertices.push_back(k);
+            }
+            if (containsApex)
+              continue;
+
+            std::vector<QuadraturePoint<ctype,dim-1> > facePoints;
+            singularQuadraturePoints<ctype,dim-1>(refElement.type(f, 1), faceSingularVertices, p, qt, facePoints);
+
+            const auto geometry = refElement.template geometry<1>(f);
+            for (const auto& fp : facePoints)
+            {
+              FieldVector<ctype,dim> direction = geometry.global(fp.position());
+              direction -= a;
+
+              FieldMatrix<ctype,dim,dim> jacobianTransposed;
+              jacobianTransposed[0] = direction;
+              const auto faceJacobianTransposed = geometry.jacobianTransposed(fp.position());
+              for (int i = 1; i < dim; ++i)
+                jacobianTransposed[i] = faceJacobianTransposed[i-1];
+              const ctype weight = fp.weight() * std::abs(jacobianTransposed.determinant());
+
+              for (const auto& rp : radialRule)
+              {
+                const ctype s = rp.position()[0];
+                FieldVector<ctype,dim> x = a;
+                x.axpy(s, direction);
+                ctype radialWeight = rp.weight();
+                for (int i = 1; i < dim; ++i)
+                  radialWeight *= s;
+                points.emplace_back(x, weight * radialWeight);
+              }
+            }
+          }
+          return;
+        }
+      }
+
+      const QuadratureRule<ctype,dim>& rule = QuadratureRules<ctype,dim>::rule(t, p, qt);
+      points.insert(points.end(), rule.begin(), rule.end());
+    }
+
+  } // end namespace Impl
+
+  /** \brief Quadrature rule for integrands that are singular at a vertex or edge of the reference element
+   *  \ingroup Quadrature
+   *
+   * Boundary element and near-field integrals behave like \f$r^{-\alpha}\f$ in the
+   * distance r to a vertex or edge, on which plain rules of any order converge
+   * slowly. This rule splits the reference element into cones with apex at the
+   * singular sub-entity, by Duffy transformations, see
+   * Impl::singularQuadraturePoints(). The Jacobian of the cones vanishes like
+   * \f$s^{c-1}\f$ in the radial coordinate s, where c is the codimension of the
+   * singular sub-entity. For integer \f$\alpha \le c-1\f$, e.g. \f$1/r\f$ at a
+   * vertex of a triangle or quadrilateral and \f$1/r\f$ or \f$1/r^2\f$ at a
+   * vertex or \f$1/r\f$ at an edge of a tetrahedron or hexahedron, the
+   * transformed integrand is smooth and the rule converges exponentially in p.
+   *
+   * Polynomials of order p are integrated exactly. The face rules have type qt
+   * and order p, the radial rules type qt and order p+dim-1.
+   * \code{.cpp}
+   * // 1/r at vertex 0 of the triangle
+   * const auto& quad = SingularQuadratureRule<double,2>::rule(GeometryTypes::triangle, 2, 0, 10);
+   * for (const auto& [x, w] : quad)
+   *   integral += w / x.two_norm();
+   * \endcode
+   *
+   * \tparam ctype Type used for coordinates and quadrature weights
+   * \tparam dim Dimension of the reference element
+   */
+  template<class ctype, int dim>
+  class SingularQuadratureRule
+    : public QuadratureRule<ctype,dim>
+  {
+  public:
+    /** \brief Rule of order p singular at the sub-entity of the reference element of type t
+     *
+     * \param t         type of the reference element
+     * \param codim     codimension of the singular sub-entity, dim for a vertex, dim-1 for an edge
+     * \param subEntity index of the singular sub-entity in the reference element
+     * \param p         order of the rule
+     * \param qt        type of the underlying face and radial rules
+     */
+    SingularQuadratureRule (const GeometryType& t, int codim, int subEntity, int p,
+                            QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+      : QuadratureRule<ctype,dim>(t, p), codim_(codim), subEntity_(subEntity)
+    {
+      assert(t.dim() == dim && codim > 0 && codim <= dim);
+
+      const auto refElement = referenceElement<ctype,dim>(t);
+      std::vector<int> singularVertices;
+      for (int k = 0; k < refElement.size(subEntity, codim, dim); ++k)
+        singularVertices.push_back(refElement.subEntity(subEntity, codim, k, dim));
+
+      std::vector<QuadraturePoint<ctype,dim> > points;
+      Impl::singularQuadraturePoints<ctype,dim>(t, singularVertices, p, qt, points);
+      this->assign(points.begin(), points.end());
+    }
+
+    //! codimension of the singular sub-entity
+    int codim () const { return codim_; }
+
+    //! index of the singular sub-entity in the reference element
+    int subEntity () const { return subEntity_; }
+
+    /** \brief Cached rule of order p of type qt singular at the sub-entity
+     *
+     * Every rule is constructed only once and lives until the end of the program.
+     * The rules are kept in a table like the rules of QuadratureRules, later
+     * calls take two atomic loads.
+     * \note This method is thread-safe.
+     */
+    static const SingularQuadratureRule& rule (const GeometryType& t, int codim, int subEntity, int p,
+                                               QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+    {
+      constexpr std::size_t numGeometryTypes = LocalGeometryTypeIndex::size(dim);
+      static const Impl::LazyObjectTable<SubEntityTable> table(std::size_t(QuadratureType::size) * numGeometryTypes * (dim+1));
+
+      assert(t.dim() == dim && codim >= 0 && codim <= dim);
+      if (std::size_t(qt) >= std::size_t(QuadratureType::size))
+        DUNE_THROW(QuadratureOrderOutOfRange, "QuadratureType " << qt << " not available");
+      const std::size_t r = (std::size_t(qt) * numGeometryTypes + LocalGeometryTypeIndex::index(t)) * (dim+1) + codim;
+      const auto& row = table.row(r, [&]{
+        // an upper bound, the radial rules limit the order
+        std::size_t numOrders = 0;
+        if (!t.isNone())
+          numOrders = dim == 0 ? 1 : QuadratureRules<ctype,1>::maxOrder(GeometryTypes::line, qt)+1;
+        return numOrders;
+      });
+      const std::size_t order = dim == 0 ? 0 : std::size_t(p);
+      if (p < 0 || order >= row.size)
+        DUNE_THROW(QuadratureOrderOutOfRange, "Singular QuadratureRule for order " << p << " and GeometryType " << t << " not available");
+
+      const SubEntityTable& rules = table.object(row, order, []{ return SubEntityTable(1); });
+      const auto& subEntityRow = rules.row(0, [&]{ return std::size_t(referenceElement<ctype,dim>(t).size(codim)); });
+      if (subEntity < 0 || std::size_t(subEntity) >= subEntityRow.size)
+        DUNE_THROW(RangeError, "GeometryType " << t << " has no sub-entity " << subEntity << " of codimension " << codim);
+      return rules.object(subEntityRow, subEntity, [&]{
+        return SingularQuadratureRule(t, codim, subEntity, p, qt);
+      });
+    }
+
+  private:
+    // rules of one order on the sub-entities of one codimension, in a single row
+    typedef Impl::LazyObjectTable<SingularQuadratureRule> SubEntityTable;
+
+    int codim_;
+    int subEntity_;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_SINGULARQUADRATURERULE_HH
@@ -0,0 +1,312 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_SPARSEGRIDQUADRATURE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_SPARSEGRIDQUADRATURE_HH
+
+#ifndef DUNE_INCLUDING_IMPLEMENTATION
+#error This is a private header that should not be included directly.
+#error Use #include <dune/geometry/quadraturerules.hh> instead.
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/math.hh>
+#include <dune/geometry/type.hh>
+
+namespace Dune {
+
+  namespace Impl {
+
+    inline bool isSmolyakQuadratureType (QuadratureType::Enum qt)
+    {
+      return qt == QuadratureType::SmolyakClenshawCurtis || qt == QuadratureType::SmolyakGaussPatterson;
+    }
+
+    // the nested 1d family the sparse grids of a Smolyak quadrature type are built from
+    inline QuadratureType::Enum smolyakLineType (QuadratureType::Enum qt)
+    {
+      switch (qt) {
+      case QuadratureType::SmolyakClenshawCurtis :
+        return QuadratureType::ClenshawCurtis;
+      case QuadratureType::SmolyakGaussPatterson :
+        return QuadratureType::GaussPatterson;
+      default :
+        DUNE_THROW(Exception, "QuadratureType " << qt << " is not a Smolyak type");
+      }
+    }
+
+    // highest level of the 1d rules, 129 Clenshaw-Curtis and 31 Gauss-Patterson points
+    inline int smolyakMaxLevel (QuadratureType::Enum qt)
+    {
+      return smolyakLineType(qt) == QuadratureType::ClenshawCurtis ? 7 : 4;
+    }
+
+    // order of the 1d rule of the given level, level 0 is the midpoint rule
+    inline int smolyakLineOrder (int level, QuadratureType::Enum qt)
+    {
+      if (level == 0)
+        return 1;
+      if (smolyakLineType(qt) == QuadratureType::ClenshawCurtis)
+        return (1 << level) + 1;
+      return 3 * (1 << level) - 1;
+    }
+
+    // number of points the 1d rule of the given level adds to the one of the level below
+    inline std::size_t smolyakNewLinePoints (int level, QuadratureType::Enum qt)
+    {
+      if (level == 0)
+        return 1;
+      if (smolyakLineType(qt) == QuadratureType::ClenshawCurtis)
+        return (level == 1) ? 2 : (std::size_t(1) << (level-1));
+      return std::size_t(1) << level;
+    }
+
+  } // end namespace Impl
+
+  /** \brief Smolyak sparse-grid quadrature rules on the cube in any dimension
+   *
+   * The rule of level k is the combination
+   * \f[
+   *   A_k = \sum_{k-dim+1 \le |i| \le k} (-1)^{k-|i|} \binom{dim-1}{k-|i|} U_{i_0} \otimes \cdots \otimes U_{i_{dim-1}}
+   * \f]
+   * of tensor products of the nested 1d rules \f$U_l\f$ of level l,
+   * Clenshaw-Curtis rules with 1, 3, 5, 9, ... points for SmolyakClenshawCurtis and
+   * Gauss-Patterson rules with 1, 3, 7, 15, 31 points for SmolyakGaussPatterson.
+   * Since the 1d rules are nested, the products share their points, which are
+   * merged. The number of points grows like \f$2^k k^{dim-1}\f$ in the level and
+   * only polynomially in the dimension for a fixed level, instead of
+   * \f$n^{dim}\f$ for tensor products. Some of the weights are negative. Where
+   * the weights of a point cancel, e.g., at the center of the rule of level 1
+   * for SmolyakClenshawCurtis in 3 dimensions, the point is kept with weight
+   * zero, such that numPoints() gives the number of points in closed form.
+   *
+   * The rule of level k integrates all polynomials of total degree exactness(k)
+   * exactly, at least 2k+1. The rule of order p is the one of the lowest level
+   * with exactness(k) >= p, see T. Gerstner, M. Griebel, "Numerical integration
+   * using sparse grids", Numer. Algorithms 18 (1998). The finest 1d rules limit
+   * the order, e.g., to 15 for SmolyakClenshawCurtis and 9 for SmolyakGaussPatterson
+   * in 5 and more dimensions, see maxOrder().
+   *
+   * \tparam ct Number type used for quadrature point coordinates and weights
+   * \tparam dim Dimension of the cube
+   */
+  template<typename ct, int dim>
+  class SparseGridQuadratureRule
+    : public QuadratureRule<ct,dim>
+  {
+    friend class QuadratureRuleFactory<ct,dim>;
+
+    SparseGridQuadratureRule (int p, QuadratureType::Enum qt)
+      : QuadratureRule<ct,dim>(GeometryTypes::cube(dim))
+    {
+      if (p < 0 || p > int(maxOrder(qt)))
+        DUNE_THROW(QuadratureOrderOutOfRange, "Quadrature rule " << p << " not supported!");
+
+      level_ = 0;
+      while (exactness(level_, qt) < p)
+        ++level_;
+      this->delivered_order = exactness(level_, qt);
+      build(qt);
+    }
+
+  public:
+    /** \brief Construct the sparse-grid rule of order p for the cube
+     *
+     * \throws QuadratureOrderOutOfRange if the order is not available
+     */
+    SparseGridQuadratureRule (const GeometryType& t, int p, QuadratureType::Enum qt)
+      : SparseGridQuadratureRule(p, qt)
+    {
+      assert(t.isCube() && t.dim() == dim);
+    }
+
+    //! level of the Smolyak combination
+    int level () const { return level_; }
+
+    //! The highest quadrature order available for the quadrature type
+    static unsigned maxOrder (QuadratureType::Enum qt)
+    {
+      return exactness(Impl::smolyakMaxLevel(qt), qt);
+    }
+
+    /** \brief Number of points of the rule of order p, computed without building it
+     *
+     * Since the 1d rules are nested, the points of the rule of level k are the
+     * products of the points that the 1d rules add on the levels \f$i_j\f$,
+     * for all multi-indices with \f$|i| \le k\f$.
+     * \throws QuadratureOrderOutOfRange if the order is not available
+     */
+    static std::size_t numPoints (int p, QuadratureType::Enum qt)
+    {
+      if (p < 0 || p > int(maxOrder(qt)))
+        DUNE_THROW(QuadratureOrderOutOfRange, "Quadrature rule " << p << " not supported!");
+      int level = 0;
+      while (exactness(level, qt) < p)
+        ++level;
+
+      // count[s]: number of points of the multi-indices with |i| = s in the directions so far
+      std::vector<std::size_t> count(level+1, 0);
+      count[0] = 1;
+      for (int j = 0; j < dim; ++j)
+      {
+        std::vector<std::size_t> next(level+1, 0);
+        for (int s = 0; s <= level; ++s)
+          for (int l = 0; s + l <= level; ++l)
+            next[s+l] += count[s] * Impl::smolyakNewLinePoints(l, qt);
+        count = std::move(next);
+      }
+
+      std::size_t size = 0;
+      for (std::size_t c : count)
+        size += c;
+      return size;
+    }
+
+    /** \brief Highest total degree of polynomials the rule of level k integrates exactly
+     *
+     * The combination is exact for the monomial \f$x^\alpha\f$ if the product
+     * rule of some multi-index i with \f$|i| \le k\f$ is, i.e., if the sum of the
+     * lowest levels whose 1d rules integrate \f$x^{\alpha_j}\f$ does not exceed k.
+     */
+    static int exactness (int level, QuadratureType::Enum qt)
+    {
+      const int maxDegree = Impl::smolyakLineOrder(level, qt);
+      // lowest level of the 1d rule integrating x^a
+      std::vector<int> lineLevel(maxDegree+1);
+      for (int a = 0, l = 0; a <= maxDegree; ++a)
+      {
+        while (Impl::smolyakLineOrder(l, qt) < a)
+          ++l;
+        lineLevel[a] = l;
+      }
+
+      // worst[D]: highest sum of these levels over the exponents of total degree D
+      std::vector<int> worst(lineLevel);
+      for (int j = 1; j < dim; ++j)
+      {
+        std::vector<int> next(maxDegree+1, 0);
+        for (int degree = 0; degree <= maxDegree; ++degree)
+          for (int a = 0; a <= degree; ++a)
+            next[degree] = std::max(next[degree], lineLevel[a] + worst[degree-a]);
+        worst = std::move(next);
+      }
+
+      int degree = 0;
+      while (degree < maxDegree && worst[degree+1] <= level)
+        ++degree;
+      return degree;
+    }
+
+  private:
+    void build (QuadratureType::Enum qt)
+    {
+      using std::abs;
+      const QuadratureType::Enum lineType = Impl::smolyakLineType(qt);
+
+      // the 1d rules of all levels, their points as indices into the points of the finest level
+      std::vector<Impl::NestedLineRule<ct> > lineRules;
+      for (int l = 0; l <= level_; ++l)
+        lineRules.push_back(Impl::nestedLineRule<ct>(Impl::smolyakLineOrder(l, qt), lineType));
+      const std::vector<ct>& finest = lineRules.back().points;
+      std::vector<std::vector<int> > indices(level_+1);
+      for (int l = 0; l <= level_; ++l)
+        for (const ct& point : lineRules[l].points)
+        {
+          const auto it = std::lower_bound(finest.begin(), finest.end(), point);
+          int index = it - finest.begin();
+          if (it == finest.end() || (index > 0 && abs(finest[index-1] - point) < abs(*it - point)))
+            --index;
+          indices[l].push_back(index);
+        }
+
+      // weight and largest contribution per point
+      std::map<std::array<int,dim>, std::pair<ct,ct> > points;
+
+      std::array<int,dim> multiIndex{};
+      multiIndex[0] = -1;
+      while (nextMultiIndex(multiIndex))
+      {
+        int norm = 0;
+        for (int l : multiIndex)
+          norm += l;
+        if (norm < level_ - dim + 1)
+          continue;
+        const ct coefficient = ((level_ - norm) % 2 == 0 ? ct(1) : ct(-1)) * ct(binomial(dim-1, level_ - norm));
+
+        // all points of the product rule of the multi-index
+        std::array<std::size_t,dim> point{};
+        do
+        {
+          std::array<int,dim> key;
+          ct weight = coefficient;
+          for (int j = 0; j < dim; ++j)
+          {
+            key[j] = indices[multiIndex[j]][point[j]];
+            weight *= lineRules[multiIndex[j]].weights[point[j]];
+          }
+          auto& entry = points[key];
+          entry.first += weight;
+          entry.second = std::max(entry.second, abs(weight));
+        } while (nextProductPoint(point, multiIndex, lineRules));
+      }
+
+      this->reserve(points.size());
+      for (const auto& [key, entry] : points)
+      {
+        // points of the coarser rules whose weights cancel are kept with weight zero,
+        // such that the rule has numPoints() points
+        const bool cancelled = (abs(entry.first) <= 8 * std::numeric_limits<ct>::epsilon() * entry.second);
+        FieldVector<ct,dim> position;
+        for (int j = 0; j < dim; ++j)
+          position[j] = finest[key[j]];
+        this->push_back(QuadraturePoint<ct,dim>(position, cancelled ? ct(0) : entry.first));
+      }
+    }
+
+    // next multi-index with |i| <= level_, in lexicographic order
+    bool nextMultiIndex (std::array<int,dim>& multiIndex) const
+    {
+      int norm = 0;
+      for (int l : multiIndex)
+        norm += l;
+      for (int j = 0; j < dim; ++j)
+      {
+        ++multiIndex[j];
+        if (++norm <= level_)
+          return true;
+        norm -= multiIndex[j];
+        multiIndex[j] = 0;
+      }
+      return false;
+    }
+
+    // next point of the product of the 1d rules of the multi-index
+    static bool nextProductPoint (std::array<std::size_t,dim>& point, const std::array<int,dim>& multiIndex,
+                                  const std::vector<Impl::NestedLineRule<ct> >& lineRules)
+    {
+      for (int j = 0; j < dim; ++j)
+      {
+        if (++point[j] < lineRules[multiIndex[j]].points.size())
+          return true;
+        point[j] = 0;
+      }
+      return false;
+    }
+
+    int level_;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_SPARSEGRIDQUADRATURE_HH
@@ -0,0 +1,385 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_STATICQUADRATURERULE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_STATICQUADRATURERULE_HH
+
+/** \file
+ * \brief Quadrature rules for a geometry type and an order known at compile time
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+namespace Dune {
+
+  namespace Impl {
+
+    // Fixed-size replacement of std::vector for the constexpr evaluation
+    // of the 1d quadrature init helpers
+    template<class T, std::size_t capacity>
+    struct StaticQuadratureBuffer
+    {
+      constexpr void resize (std::size_t n)
+      {
+        if (n != capacity)
+          throwQuadratureOrderOutOfRange(int(n));
+      }
+
+      constexpr T& operator[] (std::size_t i) { return data[i]; }
+      constexpr const T& operator[] (std::size_t i) const { return data[i]; }
+
+      T data[capacity] = {};
+    };
+
+    // Sink for the 1d quadrature init helpers that only records the number of points
+    template<class T>
+    struct StaticQuadratureCounter
+    {
+      constexpr void resize (std::size_t n) { size = n; }
+      constexpr T& operator[] (std::size_t) { return value; }
+
+      T value = {};
+      std::size_t size = 0;
+    };
+
+    // Points, weights and delivered order of a static quadrature rule
+    template<class ct, int dim, std::size_t n>
+    struct StaticQuadratureData
+    {
+      std::array<std::array<ct, dim>, n> points = {};
+      std::array<ct, n> weights = {};
+      int order = 0;
+    };
+
+    // Orders below this bound are served by the tabulated rules in JacobiNQuadratureRule
+    template<class ct>
+    constexpr int staticJacobiNMaxOrder ()
+    {
+      return std::min(GaussQuadratureRule1D<ct>::highest_order,
+                      std::min(Jacobi1QuadratureRule1D<ct>::highest_order,
+                               Jacobi2QuadratureRule1D<ct>::highest_order));
+    }
+
+    // Fill points and weights of the 1d rule of type qt and order p, see QuadratureRuleFactory<ct,1>
+    template<class ct, class Points, class Weights>
+    constexpr int staticLineQuadrature (int p, QuadratureType::Enum qt, Points& points, Weights& weights)
+    {
+      int order = 0;
+      switch (qt)
+      {
+      case QuadratureType::GaussLegendre :
+      case QuadratureType::FullySymmetric :
+        GaussQuadratureInitHelper<ct>::init(p, points, weights, order);
+        break;
+      case QuadratureType::GaussJacobi_1_0 :
+        Jacobi1QuadratureInitHelper<ct>::init(p, points, weights, order);
+        break;
+      case QuadratureType::GaussJacobi_2_0 :
+        Jacobi2QuadratureInitHelper<ct>::init(p, points, weights, order);
+        break;
+      case QuadratureType::GaussJacobi_n_0 :
+        // rules of higher order are computed by LAPACK at run time
+        if (p >= staticJacobiNMaxOrder<ct>())
+          throwQuadratureOrderOutOfRange(p);
+        GaussQuadratureInitHelper<ct>::init(p, points, weights, order);
+        break;
+      case QuadratureType::GaussLobatto :
+        GaussLobattoQuadratureInitHelper<ct>::init(p, points, weights, order);
+        break;
+      case QuadratureType::GaussRadauLeft :
+        GaussRadauLeftQuadratureInitHelper<ct>::init(p, points, weights, order);
+        break;
+      case QuadratureType::GaussRadauRight :
+        GaussRadauRightQuadratureInitHelper<ct>::init(p, points, weights, order);
+        break;
+      default :
+        throwQuadratureOrderOutOfRange(p);
+      }
+      return order;
+    }
+
+    // Fill points and weights of the 1d rule used by the conical product onto a base
+    // of dimension dim-1, see TensorProductQuadratureRule::conicalProduct
+    template<class ct, class Points, class Weights>
+    constexpr void staticConicalLineQuadrature (int p, int dim, QuadratureType::Enum qt, Points& points, Weights& weights)
+    {
+      if (qt != QuadratureType::GaussJacobi_n_0)
+      {
+        staticLineQuadrature<ct>(p + dim-1, qt, points, weights);
+        return;
+      }
+
+      // rules of higher order or for higher exponents are computed by LAPACK at run time
+      int order = 0;
+      if (p >= staticJacobiNMaxOrder<ct>())
+        throwQuadratureOrderOutOfRange(p);
+      switch (dim-1)
+      {
+      case 0 :
+        GaussQuadratureInitHelper<ct>::init(p, points, weights, order);
+        break;
+      case 1 :
+        Jacobi1QuadratureInitHelper<ct>::init(p, points, weights, order);
+        break;
+      case 2 :
+        Jacobi2QuadratureInitHelper<ct>::init(p, points, weights, order);
+        break;
+      default :
+        throwQuadratureOrderOutOfRange(p);
+      }
+    }
+
+    // The symmetric rules of QuadratureRuleFactory<ct,2> and QuadratureRuleFactory<ct,3>
+    template<class ct>
+    constexpr bool useSimplexTable (const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      if (!t.isSimplex() || (qt != QuadratureType::GaussLegendre && qt != QuadratureType::GaussJacobi_n_0))
+        return false;
+      if (t.dim() == 2)
+        return p <= SimplexQuadratureRule<ct,2>::highest_order;
+      if (t.dim() == 3)
+        return p <= SimplexQuadratureRule<ct,3>::highest_order;
+      return false;
+    }
+
+    template<class ct>
+    constexpr bool useCubeTable (const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      if (!t.isCube() || qt != QuadratureType::FullySymmetric)
+        return false;
+      if (t.dim() == 2)
+        return p <= CubeQuadratureRule<ct,2>::highest_order && CubeQuadraturePoints<2>::numPoints(p) > 0;
+      if (t.dim() == 3)
+        return p <= CubeQuadratureRule<ct,3>::highest_order && CubeQuadraturePoints<3>::numPoints(p) > 0;
+      return false;
+    }
+
+    template<class ct>
+    constexpr bool usePrismTable (const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      return t.isPrism() && qt == QuadratureType::FullySymmetric
+        && p <= PrismQuadratureRule<ct,3>::highest_order && PrismQuadraturePoints<3>::numPoints(p) > 0;
+    }
+
+    template<class ct>
+    constexpr bool usePyramidTable (const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      return t.isPyramid() && qt == QuadratureType::GaussLegendre
+        && p <= PyramidQuadratureRule<ct,3>::highest_order;
+    }
+
+    // Number of points of the rule handed out by QuadratureRules<ct,dim>::rule(t, p, qt)
+    template<class ct>
+    constexpr std::size_t staticQuadratureSize (const GeometryType& t, int p, QuadratureType::Enum qt)
+    {
+      const int dim = t.dim();
+      if (dim == 0)
+        return 1;
+
+      StaticQuadratureCounter<ct> points, weights;
+      if (dim == 1)
+      {
+        staticLineQuadrature<ct>(p, qt, points, weights);
+        return points.size;
+      }
+
+      if (useCubeTable<ct>(t, p, qt))
+        return (dim == 2) ? CubeQuadraturePoints<2>::numPoints(p) : CubeQuadraturePoints<3>::numPoints(p);
+      if (usePrismTable<ct>(t, p, qt))
+        return PrismQuadraturePoints<3>::numPoints(p);
+      if (qt == QuadratureType::FullySymmetric)
+        return staticQuadratureSize<ct>(t, p, QuadratureType::GaussLegendre);
+      if (useSimplexTable<ct>(t, p, qt))
+        return (dim == 2) ? SimplexQuadraturePoints<2>::numPoints(p) : SimplexQuadraturePoints<3>::numPoints(p);
+      if (usePyramidTable<ct>(t, p, qt))
+        return PyramidQuadraturePoints<3>::numPoints(p);
+
+      const GeometryType baseType(t.id() & ~(1u << (dim-1)), dim-1);
+      if (t.isPrismatic())
+        staticLineQuadrature<ct>(p, qt, points, weights);
+      else
+        staticConicalLineQuadrature<ct>(p, dim, qt, points, weights);
+      return staticQuadratureSize<ct>(baseType, p, qt) * points.size;
+    }
+
+    // Copy the symmetric rule m from one of the tables CubeQuadraturePoints, SimplexQuadraturePoints,
+    // PrismQuadraturePoints or PyramidQuadraturePoints
+    template<class ct, int dim, std::size_t n, class Table>
+    constexpr void copyStaticQuadratureTable (const Table& table, int m, StaticQuadratureData<ct, dim, n>& rule)
+    {
+      rule.order = table.order(m);
+      for (int i = 0; i < m; ++i)
+      {
+        for (int j = 0; j < dim; ++j)
+          rule.points[i][j] = table.coordinate(m, i, j);
+        rule.weights[i] = table.weight(m, i);
+      }
+    }
+
+    // Build the rule of QuadratureRules<ct,dim>::rule(t, p, qt) at compile time
+    template<class ct, GeometryType::Id geometryId, int p, QuadratureType::Enum qt>
+    constexpr auto staticQuadrature ()
+    {
+      constexpr GeometryType t = geometryId;
+      constexpr int dim = t.dim();
+      constexpr std::size_t n = staticQuadratureSize<ct>(t, p, qt);
+      StaticQuadratureData<ct, dim, n> rule;
+
+      if constexpr (dim == 0)
+      {
+        // Any function is integrated exactly, hence the order is infinite
+        rule.weights[0] = ct(1);
+        rule.order = std::numeric_limits<int>::max();
+      }
+      else if constexpr (dim == 1)
+      {
+        StaticQuadratureBuffer<ct, n> points, weights;
+        rule.order = staticLineQuadrature<ct>(p, qt, points, weights);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          rule.points[i][0] = points[i];
+          rule.weights[i] = weights[i];
+        }
+      }
+      else if constexpr (useCubeTable<ct>(t, p, qt))
+      {
+        constexpr CubeQuadraturePoints<dim> table{};
+        copyStaticQuadratureTable(table, CubeQuadraturePoints<dim>::numPoints(p), rule);
+      }
+      else if constexpr (usePrismTable<ct>(t, p, qt))
+      {
+        constexpr PrismQuadraturePoints<3> table{};
+        copyStaticQuadratureTable(table, PrismQuadraturePoints<3>::numPoints(p), rule);
+      }
+      else if constexpr (qt == QuadratureType::FullySymmetric)
+        return staticQuadrature<ct, geometryId, p, QuadratureType::GaussLegendre>();
+      else if constexpr (useSimplexTable<ct>(t, p, qt))
+      {
+        constexpr SimplexQuadraturePoints<dim> table{};
+        copyStaticQuadratureTable(table, SimplexQuadraturePoints<dim>::numPoints(p), rule);
+      }
+      else if constexpr (usePyramidTable<ct>(t, p, qt))
+      {
+        constexpr PyramidQuadraturePoints<3> table{};
+        copyStaticQuadratureTable(table, PyramidQuadraturePoints<3>::numPoints(p), rule);
+      }
+      else
+      {
+        // tensor or conical product as in TensorProductQuadratureRule
+        constexpr GeometryType baseType(t.id() & ~(1u << (dim-1)), dim-1);
+        constexpr auto base = staticQuadrature<ct, baseType.toId(), p, qt>();
+        constexpr std::size_t nBase = base.weights.size();
+        constexpr std::size_t nLine = n / nBase;
+
+        StaticQuadratureBuffer<ct, nLine> linePoints, lineWeights;
+        if constexpr (t.isPrismatic())
+          staticLineQuadrature<ct>(p, qt, linePoints, lineWeights);
+        else
+          staticConicalLineQuadrature<ct>(p, dim, qt, linePoints, lineWeights);
+
+        for (std::size_t bqi = 0; bqi < nBase; ++bqi)
+          for (std::size_t oqi = 0; oqi < nLine; ++oqi)
+          {
+            auto& point = rule.points[bqi*nLine + oqi];
+            auto& weight = rule.weights[bqi*nLine + oqi];
+            point[dim-1] = linePoints[oqi];
+            weight = base.weights[bqi] * lineWeights[oqi];
+            if constexpr (t.isPrismatic())
+            {
+              for (int i = 0; i < dim-1; ++i)
+                point[i] = base.points[bqi][i];
+            }
+            else
+            {
+              const ct scale = ct(1) - point[dim-1];
+              for (int i = 0; i < dim-1; ++i)
+                point[i] = scale * base.points[bqi][i];
+
+              if constexpr (qt == QuadratureType::GaussJacobi_n_0)
+              {
+                // weights of the Gauss-Jacobi rules are scaled as in JacobiNQuadratureRule
+                weight = base.weights[bqi] * (lineWeights[oqi] * ct(dim == 2 ? 0.5 : dim == 3 ? 0.25 : 1.0));
+              }
+              else
+              {
+                for (int i = 0; i < dim-1; ++i)
+                  weight *= scale;
+              }
+            }
+          }
+
+        // the product rules report the requested order
+        rule.order = p;
+      }
+
+      return rule;
+    }
+
+  } // end namespace Impl
+
+  /** \brief Quadrature rule for a geometry type and order known at compile time
+      \details The rule is generated from the same tables as the rule
+      handed out by QuadratureRules<ct,dim>::rule(type, order, qt) and has the
+      same points and weights. All data is available in `constexpr` context:
+      \code{.cpp}
+      using Rule = StaticQuadratureRule<double, GeometryTypes::triangle, 4>;
+      static_assert(Rule::size() == 6);
+      double integral = 0;
+      for (std::size_t q = 0; q < Rule::size(); ++q)
+        integral += f(Rule::position(q)) * Rule::weight(q);
+      \endcode
+      Rules whose 1d factors are computed by LAPACK at run time are not available.
+      \ingroup Quadrature
+      \tparam ct Number type used for coordinates and weights, must be a literal type
+      \tparam geometryId Id of the GeometryType of the integration domain
+      \tparam p Requested order of the rule
+      \tparam qt Type of the 1d rules the rule is built from
+   */
+  template<class ct, GeometryType::Id geometryId, int p, QuadratureType::Enum qt = QuadratureType::GaussLegendre>
+  class StaticQuadratureRule
+  {
+    static constexpr GeometryType geometryType_ = geometryId;
+    static constexpr auto data_ = Impl::staticQuadrature<ct, geometryId, p, qt>();
+
+  public:
+    /** \brief The space dimension */
+    constexpr static int d = geometryType_.dim();
+
+    /** \brief The type used for coordinates */
+    typedef ct CoordType;
+
+    /** \brief Type used for the position of a quadrature point */
+    typedef std::array<ct, d> Position;
+
+    //! number of quadrature points
+    static constexpr std::size_t size () { return data_.weights.size(); }
+
+    //! return order
+    static constexpr int order () { return data_.order; }
+
+    //! return type of element
+    static constexpr GeometryType type () { return geometryType_; }
+
+    //! return the positions of all quadrature points
+    static constexpr const auto& positions () { return data_.points; }
+
+    //! return the weights of all quadrature points
+    static constexpr const auto& weights () { return data_.weights; }
+
+    //! return local coordinates of integration point i
+    static constexpr const Position& position (std::size_t i) { return data_.points[i]; }
+
+    //! return weight associated with integration point i
+    static constexpr const ct& weight (std::size_t i) { return data_.weights[i]; }
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_STATICQUADRATURERULE_HH
@@ -0,0 +1,215 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_SUBENTITYQUADRATURERULE_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_SUBENTITYQUADRATURERULE_HH
+
+/** \file
+ * \brief Quadrature rules on the faces and other sub-entities of reference elements in element coordinates
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/quadraturerules/lazytable.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+#include <dune/geometry/typeindex.hh>
+
+namespace Dune {
+
+  /** \brief Quadrature rule on a sub-entity of a reference element, mapped into the element
+   *  \ingroup Quadrature
+   *
+   * The rule of QuadratureRules on the reference element of the sub-entity is
+   * mapped by the geometry of the sub-entity in the reference element,
+   * `referenceElement.template geometry<codim>(subEntity)`. The positions are
+   * stored in the local coordinates of the element, the weights are those of
+   * the rule on the sub-entity. For faces, the integration outer normal of the
+   * reference element is stored as well.
+   *
+   * All sub-entities of a codimension are set up at once and cached by rules().
+   * Fetching the rules once per element type and order avoids mapping the same
+   * points on every intersection:
+   * \code{.cpp}
+   * const auto& faceRules = SubEntityQuadratureRule<double,3>::rules(element.type(), 1, order);
+   * for (const auto& intersection : intersections(gridView, element))
+   * {
+   *   const auto& faceRule = faceRules[intersection.indexInInside()];
+   *   for (std::size_t q = 0; q < faceRule.size(); ++q)
+   *     ... faceRule.positions()[q] ... faceRule.weights()[q] ...
+   * }
+   * \endcode
+   *
+   * \tparam ctype Type used for coordinates and quadrature weights
+   * \tparam dim Dimension of the reference element
+   */
+  template<class ctype, int dim>
+  class SubEntityQuadratureRule
+  {
+  public:
+    //! type of the positions in element coordinates
+    typedef FieldVector<ctype,dim> Coordinate;
+
+    /** \brief Map the rule of order p of type qt to the sub-entity of the reference element of type t
+     *
+     * \throws QuadratureOrderOutOfRange if the order is not available for the sub-entity
+     */
+    SubEntityQuadratureRule (const GeometryType& t, int codim, int subEntity, int p,
+                             QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+      : type_(t), codim_(codim), subEntity_(subEntity)
+    {
+      assert(t.dim() == dim && codim >= 0 && codim <= dim);
+      build<0>(p, qt);
+    }
+
+    //! type of the reference element
+    GeometryType type () const { return type_; }
+
+    //! type of the sub-entity
+    GeometryType subEntityType () const { return subEntityType_; }
+
+    //! codimension of the sub-entity
+    int codim () const { return codim_; }
+
+    //! index of the sub-entity in the reference element
+    int subEntity () const { return subEntity_; }
+
+    //! order of the rule on the sub-entity
+    int order () const { return order_; }
+
+    //! number of quadrature points
+    std::size_t size () const { return weights_.size(); }
+
+    //! positions of the quadrature points in the local coordinates of the element
+    const std::vector<Coordinate>& positions () const { return positions_; }
+
+    //! weights of the rule on the reference element of the sub-entity
+    const std::vector<ctype>& weights () const { return weights_; }
+
+    //! integration element of the geometry of the sub-entity in the reference element
+    ctype integrationElement () const { return integrationElement_; }
+
+    //! integration outer normal of the face in the reference element, only for codim 1
+    const Coordinate& integrationOuterNormal () const
+    {
+      assert(codim_ == 1);
+      return integrationOuterNormal_;
+    }
+
+    /** \brief Cached rules of order p of type qt on all sub-entities of the given codimension
+     *
+     * The rule of sub-entity i is at index i. Every set of rules is constructed
+     * only once and lives until the end of the program. The sets are kept in a
+     * table like the rules of QuadratureRules, later calls take two atomic loads.
+     * \note This method is thread-safe.
+     *
+     * \throws QuadratureOrderOutOfRange if the order is not available for the sub-entities
+     */
+    static const std::vector<SubEntityQuadratureRule>& rules (const GeometryType& t, int codim, int p,
+                                                              QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+    {
+      constexpr std::size_t numGeometryTypes = LocalGeometryTypeIndex::size(dim);
+      static const Impl::LazyObjectTable<std::vector<SubEntityQuadratureRule> > table(std::size_t(QuadratureType::size) * numGeometryTypes * (dim+1));
+
+      assert(t.dim() == dim && codim >= 0 && codim <= dim);
+      if (std::size_t(qt) >= std::size_t(QuadratureType::size))
+        DUNE_THROW(QuadratureOrderOutOfRange, "QuadratureType " << qt << " not available");
+      const std::size_t r = (std::size_t(qt) * numGeometryTypes + LocalGeometryTypeIndex::index(t)) * (dim+1) + codim;
+      const auto& row = table.row(r, [&]{ return numOrders<0>(t, codim, qt); });
+      // the rules on vertices do not depend on the order
+      const std::size_t order = codim == dim ? 0 : std::size_t(p);
+      if (p < 0 || order >= row.size)
+        DUNE_THROW(QuadratureOrderOutOfRange, "QuadratureRule for order " << p << " on the sub-entities of codimension "
+                   << codim << " of GeometryType " << t << " not available");
+
+      return table.object(row, order, [&]{
+        const auto refElement = ReferenceElements<ctype,dim>::general(t);
+        std::vector<SubEntityQuadratureRule> subEntityRules;
+        subEntityRules.reserve(refElement.size(codim));
+        for (int i = 0; i < refElement.size(codim); ++i)
+          subEntityRules.emplace_back(t, codim, i, p, qt);
+        return subEntityRules;
+      });
+    }
+
+    //! Cached rule of order p of type qt on a sub-entity, see rules()
+    static const SubEntityQuadratureRule& rule (const GeometryType& t, int codim, int subEntity, int p,
+                                                QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+    {
+      return rules(t, codim, p, qt)[subEntity];
+    }
+
+  private:
+    // number of orders available on all sub-entities of the codimension, 1 for vertices
+    template<int c>
+    static std::size_t numOrders (const GeometryType& t, int codim, QuadratureType::Enum qt)
+    {
+      if (codim != c)
+      {
+        if constexpr (c < dim)
+          return numOrders<c+1>(t, codim, qt);
+        return 0;
+      }
+      if (t.isNone())
+        return 0;
+      if (c == dim)
+        return 1;
+
+      const auto refElement = ReferenceElements<ctype,dim>::general(t);
+      std::size_t size = std::numeric_limits<std::size_t>::max();
+      for (int i = 0; i < refElement.size(c); ++i)
+        size = std::min<std::size_t>(size, std::size_t(QuadratureRules<ctype,dim-c>::maxOrder(refElement.type(i, c), qt)) + 1);
+      return size;
+    }
+
+    // the sub-entity geometry is only available for a codimension known at compile time
+    template<int c>
+    void build (int p, QuadratureType::Enum qt)
+    {
+      if (codim_ != c)
+      {
+        if constexpr (c < dim)
+          build<c+1>(p, qt);
+        return;
+      }
+
+      const auto refElement = ReferenceElements<ctype,dim>::general(type_);
+      const auto geometry = refElement.template geometry<c>(subEntity_);
+      const QuadratureRule<ctype,dim-c>& quad = QuadratureRules<ctype,dim-c>::rule(geometry.type(), p, qt);
+
+      subEntityType_ = geometry.type();
+      order_ = quad.order();
+      integrationElement_ = geometry.integrationElement(FieldVector<ctype,dim-c>(ctype(0)));
+      positions_.reserve(quad.size());
+      weights_.reserve(quad.size());
+      for (const auto& qp : quad)
+      {
+        positions_.push_back(geometry.global(qp.position()));
+        weights_.push_back(qp.weight());
+      }
+      if (c == 1)
+        integrationOuterNormal_ = refElement.integrationOuterNormal(subEntity_);
+    }
+
+    GeometryType type_;
+    GeometryType subEntityType_;
+    int codim_;
+    int subEntity_;
+    int order_ = -1;
+    ctype integrationElement_ = 0;
+    Coordinate integrationOuterNormal_ = Coordinate(ctype(0));
+    std::vector<Coordinate> positions_;
+    std::vector<ctype> weights_;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_SUBENTITYQUADRATURERULE_HH
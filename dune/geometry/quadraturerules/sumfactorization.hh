@@ -0,0 +1,281 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_GEOMETRY_QUADRATURERULES_SUMFACTORIZATION_HH
+#define DUNE_GEOMETRY_QUADRATURERULES_SUMFACTORIZATION_HH
+
+/** \file
+ * \brief Sum-factorized evaluation and integration of tensor-product functions on cubes
+ */
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/geometry/quadraturerules.hh>
+
+namespace Dune {
+
+  /** \brief Sum-factorization kernels for tensor-product bases and quadrature rules on the cube
+   *  \ingroup Quadrature
+   *
+   * The basis on the cube consists of the products
+   * \f$\phi_i(x) = \prod_e \varphi_{i_e}(x_e)\f$ of a 1d basis, and the quadrature
+   * points are those of the TensorProductQuadratureFactors of a rule on the cube,
+   * the products of the points of one 1d rule. Given the values and derivatives
+   * of the \f$n_b\f$ 1d basis functions at the \f$n_q\f$ 1d points, the kernels
+   * apply these 1d matrices to one direction after the other, which takes
+   * \f$O(dim\, n^{dim+1})\f$ operations instead of the \f$O(n^{2dim})\f$ of
+   * evaluating every basis function at every point.
+   *
+   * The quadrature points are numbered as by the factors, the point q is
+   * factors[q], and so is the point q of the cached rule of QuadratureRules whose
+   * factors() they are. The basis function with the 1d indices
+   * \f$(i_0,\dots,i_{dim-1})\f$ has the index \f$\sum_e i_e n_b^{dim-1-e}\f$, the
+   * last direction runs fastest as for the points. All kernels work on the
+   * reference cube, geometric factors at the quadrature points, e.g., from
+   * Geometry::integrationElement(), are applied by the caller between the
+   * evaluation and the integration.
+   *
+   * The kernels keep their intermediate results in buffers of the object, such
+   * that they do not allocate memory once they have been called. An object must
+   * therefore not be used by several threads at the same time.
+   *
+   * \code{.cpp}
+   * // apply the mass matrix of Q_k on a geometry
+   * const auto* factors = QuadratureRules<double,3>::factors(GeometryTypes::hexahedron, 2*k+1);
+   * const auto kernel = SumFactorizationKernel<double,3>::lagrange(*factors, nodes);
+   * kernel.interpolate(u, values);
+   * for (std::size_t q = 0; q < kernel.size(); ++q)
+   *   values[q] *= geometry.integrationElement(kernel.position(q));
+   * kernel.integrate(values, Mu);
+   * \endcode
+   *
+   * \tparam ctype Type used for coordinates, quadrature weights and function values
+   * \tparam dim Dimension of the cube
+   */
+  template<class ctype, int dim>
+  class SumFactorizationKernel
+  {
+    typedef std::array<std::size_t, dim> Shape;
+
+  public:
+    //! type of the reference coordinates
+    typedef FieldVector<ctype, dim> Coordinate;
+
+    //! type of the gradients
+    typedef FieldVector<ctype, dim> Gradient;
+
+    /** \brief Construct the kernels from the 1d basis tabulated at the 1d points of the factors
+     *
+     * \param factors     1d factors of a product rule on the cube, the 1d rules of all directions agree
+     * \param basisSize   number of 1d basis functions
+     * \param values      values of the 1d basis functions at the 1d points of factors.lineRule(0),
+     *                    the value of function i at point q is values[q*basisSize + i]
+     * \param derivatives derivatives of the 1d basis functions at the 1d points, stored as values
+     */
+    SumFactorizationKernel (const TensorProductQuadratureFactors<ctype,dim>& factors, std::size_t basisSize,
+                            std::vector<ctype> values, std::vector<ctype> derivatives)
+      : nq_(factors.lineRule(0).size()), nb_(basisSize), values_(std::move(values)), derivatives_(std::move(derivatives))
+    {
+      assert(factors.type().isCube());
+      assert(values_.size() == nq_*nb_ && derivatives_.size() == nq_*nb_);
+      for (const auto& qp : factors.lineRule(0))
+        points_.push_back(qp.position()[0]);
+
+      size_ = factors.size();
+      basisSize_ = 1;
+      for (int e = 0; e < dim; ++e)
+      {
+        assert(factors.lineRule(e).size() == nq_ && !factors.isConical(e));
+        basisSize_ *= nb_;
+      }
+
+      weights_.resize(size_);
+      for (std::size_t q = 0; q < size_; ++q)
+        weights_[q] = factors[q].weight();
+    }
+
+    /** \brief Kernels for the Lagrange basis of the given 1d nodes
+     *
+     * The basis spans the polynomials of degree nodes.size()-1 in every direction,
+     * e.g., \f$Q_k\f$ for the sorted 1d Gauss-Lobatto points of a
+     * GaussLobattoCollocationRule with k+1 points.
+     */
+    static SumFactorizationKernel lagrange (const TensorProductQuadratureFactors<ctype,dim>& factors,
+                                            const std::vector<ctype>& nodes)
+    {
+      const QuadratureRule<ctype,1>& lineRule = factors.lineRule(0);
+      const std::size_t nb = nodes.size();
+      std::vector<ctype> values(lineRule.size()*nb), derivatives(lineRule.size()*nb);
+      for (std::size_t q = 0; q < lineRule.size(); ++q)
+      {
+        const ctype x = lineRule[q].position()[0];
+        for (std::size_t i = 0; i < nb; ++i)
+        {
+          ctype value = ctype(1);
+          ctype derivative = ctype(0);
+          for (std::size_t m = 0; m < nb; ++m)
+          {
+            if (m == i)
+              continue;
+            const ctype factor = (x - nodes[m]) / (nodes[i] - nodes[m]);
+            derivative = derivative * factor + value / (nodes[i] - nodes[m]);
+            value *= factor;
+          }
+          values[q*nb + i] = value;
+          derivatives[q*nb + i] = derivative;
+        }
+      }
+      return SumFactorizationKernel(factors, nb, std::move(values), std::move(derivatives));
+    }
+
+    //! number of quadrature points on the cube
+    std::size_t size () const { return size_; }
+
+    //! number of basis functions on the cube
+    std::size_t basisSize () const { return basisSize_; }
+
+    //! position of the quadrature point q
+    Coordinate position (std::size_t q) const
+    {
+      Coordinate x;
+      for (int e = dim-1; e >= 0; --e, q /= nq_)
+        x[e] = points_[q % nq_];
+      return x;
+    }
+
+    //! weights of all quadrature points
+    const std::vector<ctype>& weights () const { return weights_; }
+
+    //! values of the 1d basis functions at the 1d points, function i at point q is entry q*n_b + i
+    const std::vector<ctype>& lineValues () const { return values_; }
+
+    //! derivatives of the 1d basis functions at the 1d points, stored as lineValues()
+    const std::vector<ctype>& lineDerivatives () const { return derivatives_; }
+
+    //! values of the function with the given coefficients at all quadrature points
+    void interpolate (const std::vector<ctype>& coefficients, std::vector<ctype>& values) const
+    {
+      assert(coefficients.size() == basisSize_);
+      tensor_.assign(coefficients.begin(), coefficients.end());
+      Shape shape = uniformShape(nb_);
+      for (int e = 0; e < dim; ++e)
+        apply(shape, e, values_, false);
+      values.assign(tensor_.begin(), tensor_.end());
+    }
+
+    //! reference gradients of the function with the given coefficients at all quadrature points
+    void gradient (const std::vector<ctype>& coefficients, std::vector<Gradient>& gradients) const
+    {
+      assert(coefficients.size() == basisSize_);
+      gradients.resize(size_);
+      for (int d = 0; d < dim; ++d)
+      {
+        tensor_.assign(coefficients.begin(), coefficients.end());
+        Shape shape = uniformShape(nb_);
+        for (int e = 0; e < dim; ++e)
+          apply(shape, e, (e == d) ? derivatives_ : values_, false);
+        for (std::size_t q = 0; q < size_; ++q)
+          gradients[q][d] = tensor_[q];
+      }
+    }
+
+    /** \brief Integrate the values at the quadrature points against all basis functions
+     *
+     * result[i] is the sum of weights()[q] * values[q] * phi_i(x_q) over all points q.
+     */
+    void integrate (const std::vector<ctype>& values, std::vector<ctype>& result) const
+    {
+      assert(values.size() == size_);
+      tensor_.resize(size_);
+      for (std::size_t q = 0; q < size_; ++q)
+        tensor_[q] = weights_[q] * values[q];
+      Shape shape = uniformShape(nq_);
+      for (int e = 0; e < dim; ++e)
+        apply(shape, e, values_, true);
+      result.assign(tensor_.begin(), tensor_.end());
+    }
+
+    /** \brief Integrate the vectors at the quadrature points against the reference gradients of all basis functions
+     *
+     * result[i] is the sum of weights()[q] * (values[q] * grad phi_i(x_q)) over all points q.
+     */
+    void integrateGradient (const std::vector<Gradient>& values, std::vector<ctype>& result) const
+    {
+      assert(values.size() == size_);
+      result.assign(basisSize_, ctype(0));
+      for (int d = 0; d < dim; ++d)
+      {
+        tensor_.resize(size_);
+        for (std::size_t q = 0; q < size_; ++q)
+          tensor_[q] = weights_[q] * values[q][d];
+        Shape shape = uniformShape(nq_);
+        for (int e = 0; e < dim; ++e)
+          apply(shape, e, (e == d) ? derivatives_ : values_, true);
+        for (std::size_t i = 0; i < basisSize_; ++i)
+          result[i] += tensor_[i];
+      }
+    }
+
+  private:
+    static Shape uniformShape (std::size_t n)
+    {
+      Shape shape;
+      shape.fill(n);
+      return shape;
+    }
+
+    // Apply the 1d matrix, or its transpose, to the axis a of the tensor, which
+    // maps the extent nb to nq, resp. nq to nb. The result replaces the tensor,
+    // the two buffers are swapped.
+    void apply (Shape& shape, int a, const std::vector<ctype>& matrix, bool transpose) const
+    {
+      std::size_t inner = 1, outer = 1;
+      for (int e = 0; e < a; ++e)
+        outer *= shape[e];
+      for (int e = a+1; e < dim; ++e)
+        inner *= shape[e];
+
+      const std::size_t from = transpose ? nq_ : nb_;
+      const std::size_t to = transpose ? nb_ : nq_;
+      assert(shape[a] == from);
+
+      scratch_.assign(outer * to * inner, ctype(0));
+      for (std::size_t o = 0; o < outer; ++o)
+        for (std::size_t i = 0; i < to; ++i)
+        {
+          ctype* out = &scratch_[(o*to + i)*inner];
+          for (std::size_t j = 0; j < from; ++j)
+          {
+            const ctype entry = transpose ? matrix[j*nb_ + i] : matrix[i*nb_ + j];
+            const ctype* in = &tensor_[(o*from + j)*inner];
+            for (std::size_t k = 0; k < inner; ++k)
+              out[k] += entry * in[k];
+          }
+        }
+
+      shape[a] = to;
+      std::swap(tensor_, scratch_);
+    }
+
+    std::size_t nq_;
+    std::size_t nb_;
+    std::size_t size_;
+    std::size_t basisSize_;
+    std::vector<ctype> points_;
+    std::vector<ctype> weights_;
+    std::vector<ctype> values_;
+    std::vector<ctype> derivatives_;
+    // intermediate results of the kernels
+    mutable std::vector<ctype> tensor_;
+    mutable std::vector<ctype> scratch_;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_GEOMETRY_QUADRATURERULES_SUMFACTORIZATION_HH
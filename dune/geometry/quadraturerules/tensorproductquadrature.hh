@@ -11,9 +11,17 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
 
 #include <dune/geometry/type.hh>
+#include <dune/geometry/quadraturerules/gausslobattoquadrature.hh>
+#include <dune/geometry/quadraturerules/gaussquadrature.hh>
+#include <dune/geometry/quadraturerules/gaussradauleftquadrature.hh>
+#include <dune/geometry/quadraturerules/gaussradaurightquadrature.hh>
 #include <dune/geometry/quadraturerules/jacobiNquadrature.hh>
 
 namespace Dune
@@ -22,6 +30,12 @@ namespace Dune
   /**
    * \brief Quadrature rules constructed by tensor and conical multiplication
    *
+   * The rule is the product of the rule of QuadratureRules on the base of
+   * the reference element and a 1d rule in direction dim-1. Both factors and
+   * the conical weight function are kept, see baseRule(), lineRule() and
+   * conicalWeight(). TensorProductQuadratureFactors generates the product of
+   * 1d rules in all directions on the fly instead.
+   *
    * \tparam ctype Number type used for quadrature point coordinates and weights
    * \tparam dim Dimension of the domain of integration
    */
@@ -45,12 +59,49 @@ namespace Dune
       baseId.reset(dim-1);
       GeometryType baseType(baseId.to_ulong(), dim-1);
       const BaseQuadrature & baseQuad = QuadratureRules<ctype,dim-1>::rule(baseType, order, qt);
+      baseRule_ = &baseQuad;
       if (isPrism)
         tensorProduct(baseQuad, order, qt);
       else
         conicalProduct(baseQuad, order, qt);
     }
 
+  public:
+    /** \brief Construct the product rule of order p for the reference element of type t
+     *
+     * This is the rule QuadratureRules returns beyond the orders of the
+     * rules tabulated for t.
+     * \throws QuadratureOrderOutOfRange if the order is not available
+     */
+    TensorProductQuadratureRule (const GeometryType& t, int p, QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+      : TensorProductQuadratureRule(t.id(), p, qt)
+    {
+      assert(t.dim() == dim);
+    }
+
+    //! the rule on the base of the reference element, of dimension dim-1
+    const BaseQuadrature& baseRule () const { return *baseRule_; }
+
+    //! the 1d rule in direction dim-1
+    const QuadratureRule<ctype,1>& lineRule () const { return lineRule_; }
+
+    //! whether the rule is a conical product, otherwise it is a tensor product
+    bool isConical () const { return conical_; }
+
+    /** \brief Factor of the product weights at the coordinate z in direction dim-1
+     *
+     * This is \f$(1-z)^{dim-1}\f$ for conical products, and 1 for tensor products
+     * and for the GaussJacobi_n_0 rules, whose 1d weights contain it already.
+     */
+    ctype conicalWeight (ctype z) const
+    {
+      ctype weight = ctype(1);
+      for (int i = 0; i < conicalExponent_; ++i)
+        weight *= ctype(1) - z;
+      return weight;
+    }
+
+  private:
     /**
      * \brief Creates quadrature rule by tensor multiplication of an arbitrary rule with a rule for a one-dimensional domain
      *
@@ -61,8 +112,8 @@ namespace Dune
     void tensorProduct(const BaseQuadrature & baseQuad, unsigned int order, QuadratureType::Enum qt)
     {
       typedef QuadratureRule<ctype,1> OneDQuadrature;
-      const OneDQuadrature & onedQuad =
-        QuadratureRules<ctype,1>::rule(GeometryTypes::line, order, qt);
+      lineRule_ = QuadratureRules<ctype,1>::rule(GeometryTypes::line, order, qt);
+      const OneDQuadrature & onedQuad = lineRule_;
 
       const unsigned int baseQuadSize = baseQuad.size();
       for( unsigned int bqi = 0; bqi < baseQuadSize; ++bqi )
@@ -117,10 +168,14 @@ namespace Dune
     {
       typedef QuadratureRule<ctype,1> OneDQuadrature;
 
-      OneDQuadrature onedQuad;
+      OneDQuadrature & onedQuad = lineRule_;
+      conical_ = true;
       bool respectWeightFunction = false;
       if( qt != QuadratureType::GaussJacobi_n_0)
+      {
         onedQuad = QuadratureRules<ctype,1>::rule(GeometryTypes::line, order + dim-1, qt);
+        conicalExponent_ = dim-1;
+      }
       else
       {
         onedQuad = JacobiNQuadratureRule1D<ctype>(order,dim-1);
@@ -162,19 +217,236 @@ namespace Dune
       bool isPrism = baseId[dim-1];
       baseId.reset(dim-1);
       GeometryType baseType(baseId.to_ulong(), dim-1);
-      unsigned order = QuadratureRules<ctype,dim-1>::maxOrder(baseType, qt);
+      unsigned order = dim == 2 ? lineMaxOrder(qt) : QuadratureRules<ctype,dim-1>::maxOrder(baseType, qt);
       if (isPrism)
         order = std::min
-          (order, QuadratureRules<ctype,1>::maxOrder(GeometryTypes::line, qt));
+          (order, lineMaxOrder(qt));
       else if (qt != QuadratureType::GaussJacobi_n_0)
         order = std::min
-          (order, QuadratureRules<ctype,1>::maxOrder(GeometryTypes::line, qt)-(dim-1));
+          (order, lineMaxOrder(qt)-(dim-1));
       else
         order = std::min
-          (order, QuadratureRules<ctype,1>::maxOrder(GeometryTypes::line, qt));
+          (order, lineMaxOrder(qt));
       return order;
     }
 
+    /* The highest order of the 1d factors
+     *
+     * The Gauss rules beyond the tabulated orders, see HighOrderGaussQuadratureRule,
+     * are only offered on lines. Their products would have far too many points.
+     */
+    static unsigned lineMaxOrder(QuadratureType::Enum qt)
+    {
+      switch (qt) {
+      case QuadratureType::GaussLegendre :
+      case QuadratureType::FullySymmetric :
+        return GaussQuadratureRule1D<ctype>::highest_order;
+      case QuadratureType::GaussLobatto :
+        return GaussLobattoQuadratureRule1D<ctype>::highest_order;
+      case QuadratureType::GaussRadauLeft :
+        return GaussRadauLeftQuadratureRule1D<ctype>::highest_order;
+      case QuadratureType::GaussRadauRight :
+        return GaussRadauRightQuadratureRule1D<ctype>::highest_order;
+      default :
+        return QuadratureRules<ctype,1>::maxOrder(GeometryTypes::line, qt);
+      }
+    }
+
+    //! number of points of the product rule, computed from the numbers of points of its factors
+    static std::size_t numPoints(unsigned int topologyId, unsigned int order, QuadratureType::Enum qt)
+    {
+      constexpr static int bitSize = sizeof(unsigned int)*8;
+      std::bitset<bitSize> baseId(topologyId);
+      bool isPrism = baseId[dim-1];
+      baseId.reset(dim-1);
+      GeometryType baseType(baseId.to_ulong(), dim-1);
+      const std::size_t baseSize = QuadratureRules<ctype,dim-1>::size(baseType, order, qt);
+      if (isPrism)
+        return baseSize * QuadratureRules<ctype,1>::size(GeometryTypes::line, order, qt);
+      else if (qt != QuadratureType::GaussJacobi_n_0)
+        return baseSize * QuadratureRules<ctype,1>::size(GeometryTypes::line, order + dim-1, qt);
+      else
+        return baseSize * JacobiNQuadratureRule1D<ctype>::numPoints(order, dim-1);
+    }
+
+    const BaseQuadrature* baseRule_ = nullptr;
+    QuadratureRule<ctype,1> lineRule_;
+    bool conical_ = false;
+    int conicalExponent_ = 0;
+  };
+
+  /**
+   * \brief Product of 1d quadrature rules whose points are generated on the fly
+   *
+   * The rule on the reference element of type t is the tensor or conical
+   * product of a 1d rule in every direction, built recursively over the
+   * dimensions of t as by TensorProductQuadratureRule, but without storing any
+   * point of dimension dim. Iterating over the rule or accessing a point by
+   * its index computes the point from the 1d factors, such that rules far too
+   * large to be stored can be used in the same way as a QuadratureRule.
+   * The 1d rules are those of QuadratureRules on lines, so the orders are not
+   * restricted to the maxOrder() of the stored products.
+   *
+   * The point with the indices \f$(i_0,\dots,i_{dim-1})\f$ of the 1d points has
+   * the index \f$\sum_e i_e \prod_{e < k < dim} n_k\f$, with the last direction
+   * running fastest. Where the rule of QuadratureRules for t is a product of
+   * 1d rules in all directions, e.g., for the Gauss-Lobatto and Gauss-Radau
+   * types, both rules agree point by point.
+   *
+   * \tparam ctype Number type used for quadrature point coordinates and weights
+   * \tparam dim Dimension of the domain of integration
+   */
+  template< class ctype, int dim >
+  class TensorProductQuadratureFactors
+  {
+    typedef QuadratureRule<ctype,1> LineQuadrature;
+
+  public:
+    //! The space dimension
+    constexpr static int d = dim;
+
+    //! The type used for coordinates
+    typedef ctype CoordType;
+
+    //! The type of the generated quadrature points
+    typedef QuadraturePoint<ctype, dim> value_type;
+
+    //! Forward iterator generating the quadrature points
+    class iterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef QuadraturePoint<ctype, dim> value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const value_type* pointer;
+      typedef const value_type& reference;
+
+      iterator (const TensorProductQuadratureFactors* factors, std::size_t index)
+        : factors_(factors), index_(index),
+          point_(index < factors->size() ? (*factors)[index] : value_type(typename value_type::Vector(ctype(0)), ctype(0)))
+      {}
+
+      reference operator* () const { return point_; }
+      pointer operator-> () const { return &point_; }
+
+      iterator& operator++ ()
+      {
+        if (++index_ < factors_->size())
+          point_ = (*factors_)[index_];
+        return *this;
+      }
+
+      iterator operator++ (int)
+      {
+        iterator copy = *this;
+        ++*this;
+        return copy;
+      }
+
+      bool operator== (const iterator& other) const { return index_ == other.index_; }
+      bool operator!= (const iterator& other) const { return index_ != other.index_; }
+
+    private:
+      const TensorProductQuadratureFactors* factors_;
+      std::size_t index_;
+      value_type point_;
+    };
+
+    typedef iterator const_iterator;
+
+    /** \brief Set up the product rule of order p for the reference element of type t
+     *
+     * \throws QuadratureOrderOutOfRange if one of the 1d rules is not available
+     */
+    TensorProductQuadratureFactors (const GeometryType& t, int p, QuadratureType::Enum qt = QuadratureType::GaussLegendre)
+      : type_(t), order_(p)
+    {
+      assert(t.dim() == dim);
+      for (int e = 0; e < dim; ++e)
+      {
+        // the first direction is a line, any other one is conical if the topology id has no bit for it
+        conical_[e] = (e > 0) && !(t.id() & (1u << e));
+        conicalExponent_[e] = 0;
+        if (!conical_[e])
+          lineRules_[e] = QuadratureRules<ctype,1>::rule(GeometryTypes::line, p, qt);
+        else if (qt != QuadratureType::GaussJacobi_n_0)
+        {
+          lineRules_[e] = QuadratureRules<ctype,1>::rule(GeometryTypes::line, p + e, qt);
+          conicalExponent_[e] = e;
+        }
+        else
+          lineRules_[e] = JacobiNQuadratureRule1D<ctype>(p, e);
+        size_ *= lineRules_[e].size();
+      }
+    }
+
+    //! the requested order, which every point of the product integrates exactly
+    int order () const { return order_; }
+
+    //! the type of the reference element
+    GeometryType type () const { return type_; }
+
+    //! the number of points of the product
+    std::size_t size () const { return size_; }
+
+    //! the 1d rule in the given direction
+    const LineQuadrature& lineRule (int direction) const { return lineRules_[direction]; }
+
+    //! whether the product in the given direction is conical, otherwise it is a tensor product
+    bool isConical (int direction) const { return conical_[direction]; }
+
+    /** \brief Factor of the product weights at the coordinate z in the given direction
+     *
+     * This is \f$(1-z)^{direction}\f$ for conical products, and 1 for tensor products
+     * and for the GaussJacobi_n_0 rules, whose 1d weights contain it already.
+     */
+    ctype conicalWeight (int direction, ctype z) const
+    {
+      ctype weight = ctype(1);
+      for (int i = 0; i < conicalExponent_[direction]; ++i)
+        weight *= ctype(1) - z;
+      return weight;
+    }
+
+    //! compute the quadrature point with the given index
+    value_type operator[] (std::size_t index) const
+    {
+      assert(index < size_);
+      std::array<std::size_t, dim> indices;
+      for (int e = dim-1; e >= 0; --e)
+      {
+        indices[e] = index % lineRules_[e].size();
+        index /= lineRules_[e].size();
+      }
+
+      // same operations as TensorProductQuadratureRule, such that the points agree exactly
+      typename value_type::Vector point;
+      ctype weight = ctype(1);
+      for (int e = 0; e < dim; ++e)
+      {
+        const auto& linePoint = lineRules_[e][indices[e]];
+        point[e] = linePoint.position()[0];
+        const ctype scale = ctype(1) - point[e];
+        if (conical_[e])
+          for (int i = 0; i < e; ++i)
+            point[i] = scale * point[i];
+        weight = weight * linePoint.weight();
+        for (int i = 0; i < conicalExponent_[e]; ++i)
+          weight *= scale;
+      }
+      return value_type(point, weight);
+    }
+
+    iterator begin () const { return iterator(this, 0); }
+    iterator end () const { return iterator(this, size_); }
+
+  private:
+    GeometryType type_;
+    int order_;
+    std::size_t size_ = 1;
+    std::array<LineQuadrature, dim> lineRules_;
+    std::array<bool, dim> conical_;
+    std::array<int, dim> conicalExponent_;
   };
 
 } // end namspace Dune
@@ -0,0 +1,187 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/timer.hh>
+#include <dune/geometry/multilineargeometry.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/quadraturerules/gausslobattocollocation.hh>
+#include <dune/geometry/quadraturerules/sumfactorization.hh>
+#include <dune/geometry/type.hh>
+
+
+// the operator u -> (M + K) u of Q_k on a multilinear cube, geometric factors given at the quadrature points
+template <class Kernel, class ctype, int dim>
+void applySumFactorized (const Kernel& kernel, const std::vector<ctype>& integrationElements,
+                         const std::vector<Dune::FieldMatrix<ctype,dim,dim>>& metrics,
+                         const std::vector<ctype>& u, std::vector<ctype>& result)
+{
+  std::vector<ctype> values, gradientResult;
+  std::vector<Dune::FieldVector<ctype,dim>> gradients, fluxes(kernel.size());
+  kernel.interpolate(u, values);
+  kernel.gradient(u, gradients);
+  for (std::size_t q = 0; q < kernel.size(); ++q)
+  {
+    values[q] *= integrationElements[q];
+    metrics[q].mv(gradients[q], fluxes[q]);
+  }
+  kernel.integrate(values, result);
+  kernel.integrateGradient(fluxes, gradientResult);
+  for (std::size_t i = 0; i < result.size(); ++i)
+    result[i] += gradientResult[i];
+}
+
+// the same operator, evaluating every basis function at every quadrature point
+template <class Kernel, class ctype, int dim>
+void applyPointwise (const Kernel& kernel, std::size_t nb, const std::vector<ctype>& integrationElements,
+                     const std::vector<Dune::FieldMatrix<ctype,dim,dim>>& metrics,
+                     const std::vector<ctype>& u, std::vector<ctype>& result)
+{
+  const std::size_t nq = kernel.lineValues().size() / nb;
+  std::vector<ctype> phi(kernel.basisSize());
+  std::vector<Dune::FieldVector<ctype,dim>> gradPhi(kernel.basisSize());
+  result.assign(kernel.basisSize(), ctype(0));
+  for (std::size_t q = 0; q < kernel.size(); ++q)
+  {
+    for (std::size_t i = 0; i < kernel.basisSize(); ++i)
+    {
+      phi[i] = ctype(1);
+      gradPhi[i] = ctype(1);
+      // the last direction runs fastest
+      std::size_t qIndex = q, iIndex = i;
+      for (int e = dim-1; e >= 0; --e, qIndex /= nq, iIndex /= nb)
+      {
+        const ctype value = kernel.lineValues()[(qIndex % nq)*nb + iIndex % nb];
+        const ctype derivative = kernel.lineDerivatives()[(qIndex % nq)*nb + iIndex % nb];
+        phi[i] *= value;
+        for (int d = 0; d < dim; ++d)
+          gradPhi[i][d] *= (d == e) ? derivative : value;
+      }
+    }
+
+    ctype value = 0;
+    Dune::FieldVector<ctype,dim> gradient(0), flux;
+    for (std::size_t i = 0; i < kernel.basisSize(); ++i)
+    {
+      value += u[i] * phi[i];
+      gradient.axpy(u[i], gradPhi[i]);
+    }
+    metrics[q].mv(gradient, flux);
+    for (std::size_t i = 0; i < kernel.basisSize(); ++i)
+      result[i] += kernel.weights()[q] * (value * integrationElements[q] * phi[i] + flux * gradPhi[i]);
+  }
+}
+
+
+template <class ctype, int dim>
+bool benchmarkSumFactorization (int k, int nIter)
+{
+  using std::abs;
+  bool pass = true;
+
+  // Q_k on the Gauss-Lobatto nodes with the Gauss rule of order 2k+1
+  const auto& nodes = Dune::GaussLobattoCollocationRule<ctype,1>::rule(2*k-1).points1d();
+  const auto* factors = Dune::QuadratureRules<ctype,dim>::factors(Dune::GeometryTypes::cube(dim), 2*k+1);
+  if (!factors)
+  {
+    std::cerr << "Error: Gauss rule on the cube for dim = " << dim << ", k = " << k << " has no 1d factors" << std::endl;
+    return false;
+  }
+  const auto kernel = Dune::SumFactorizationKernel<ctype,dim>::lagrange(*factors, nodes);
+
+  // the kernel uses the points of the cached rule in its order
+  const auto& rule = Dune::QuadratureRules<ctype,dim>::rule(Dune::GeometryTypes::cube(dim), 2*k+1);
+  for (std::size_t q = 0; q < kernel.size(); ++q)
+    if (kernel.position(q) != rule[q].position() || kernel.weights()[q] != rule[q].weight())
+    {
+      std::cerr << "Error: point " << q << " of the kernel for dim = " << dim << ", k = " << k
+                << " differs from the quadrature rule" << std::endl;
+      return false;
+    }
+
+  std::vector<Dune::FieldVector<ctype,dim>> corners(1 << dim);
+  for (int c = 0; c < (1 << dim); ++c)
+    for (int d = 0; d < dim; ++d)
+      corners[c][d] = ((c >> d) & 1) + ctype(0.1) * ((c + d) % 3);
+  const Dune::MultiLinearGeometry<ctype,dim,dim> geometry(Dune::GeometryTypes::cube(dim), corners);
+
+  std::vector<ctype> integrationElements(kernel.size());
+  std::vector<Dune::FieldMatrix<ctype,dim,dim>> metrics(kernel.size());
+  for (std::size_t q = 0; q < kernel.size(); ++q)
+  {
+    const auto x = kernel.position(q);
+    const auto jit = geometry.jacobianInverseTransposed(x);
+    integrationElements[q] = geometry.integrationElement(x);
+    for (int i = 0; i < dim; ++i)
+      for (int j = 0; j < dim; ++j)
+      {
+        metrics[q][i][j] = 0;
+        for (int l = 0; l < dim; ++l)
+          metrics[q][i][j] += jit[l][i] * jit[l][j] * integrationElements[q];
+      }
+  }
+
+  std::vector<ctype> u(kernel.basisSize());
+  for (std::size_t i = 0; i < u.size(); ++i)
+    u[i] = std::sin(ctype(i));
+
+  std::vector<ctype> sumFactorized, pointwise;
+  Dune::Timer t;
+  for (int i = 0; i < nIter; ++i)
+    applySumFactorized(kernel, integrationElements, metrics, u, sumFactorized);
+  const double timeSumFactorized = t.elapsed();
+
+  t.reset();
+  for (int i = 0; i < nIter; ++i)
+    applyPointwise(kernel, nodes.size(), integrationElements, metrics, u, pointwise);
+  const double timePointwise = t.elapsed();
+
+  std::cout << "  dim = " << dim << ", k = " << k << ": sum factorization = " << timeSumFactorized
+            << "sec, pointwise = " << timePointwise << "sec" << std::endl;
+
+  ctype scale = 0;
+  for (std::size_t i = 0; i < pointwise.size(); ++i)
+    scale = std::max(scale, abs(pointwise[i]));
+  for (std::size_t i = 0; i < pointwise.size(); ++i)
+    if (abs(sumFactorized[i] - pointwise[i]) > 1e3 * std::numeric_limits<ctype>::epsilon() * scale)
+    {
+      std::cerr << "Error: sum factorization differs from pointwise evaluation for dim = " << dim
+                << ", k = " << k << " in entry " << i << std::endl;
+      pass = false;
+      break;
+    }
+
+  return pass;
+}
+
+int main ( int argc, char **argv )
+{
+  bool pass = true;
+
+  int nIter = 10;
+  if (argc > 1)
+    nIter = std::atoi(argv[1]);
+
+  std::cout << ">>> Checking ctype = double" << std::endl;
+  for (int k = 1; k <= 8; ++k)
+    pass &= benchmarkSumFactorization<double,2>(k, nIter);
+  for (int k = 1; k <= 6; ++k)
+    pass &= benchmarkSumFactorization<double,3>(k, nIter);
+
+  if (!pass)
+    std::cerr << "test failed!" << std::endl;
+
+  return (pass ? 0 : 1);
+}
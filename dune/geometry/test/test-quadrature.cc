@@ -4,17 +4,45 @@
 // SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
 
 #include <algorithm>
+#include <array>
+#include <bitset>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <iostream>
+#include <numeric>
+#include <set>
+#include <string>
+#include <thread>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <dune-common-config.hh> // HAVE_LAPACK
 #include <dune/common/math.hh>
 #include <dune/common/quadmath.hh>
 #include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/affinegeometry.hh>
+#include <dune/geometry/axisalignedcubegeometry.hh>
+#include <dune/geometry/localfiniteelementgeometry.hh>
+#include <dune/geometry/mappedgeometry.hh>
+#include <dune/geometry/multilineargeometry.hh>
 #include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/quadraturerules/adaptivequadrature.hh>
 #include <dune/geometry/quadraturerules/compositequadraturerule.hh>
+#include <dune/geometry/quadraturerules/cutcellquadrature.hh>
+#include <dune/geometry/quadraturerules/embeddedquadraturerule.hh>
+#include <dune/geometry/quadraturerules/gausslobattocollocation.hh>
+#include <dune/geometry/quadraturerules/mapquadrature.hh>
+#include <dune/geometry/quadraturerules/permutedquadraturerule.hh>
+#include <dune/geometry/quadraturerules/ruletabulationcache.hh>
+#include <dune/geometry/quadraturerules/singularquadraturerule.hh>
+#include <dune/geometry/quadraturerules/staticquadraturerule.hh>
+#include <dune/geometry/quadraturerules/subentityquadraturerule.hh>
 #include <dune/geometry/refinement.hh>
+#include <dune/geometry/test/localfiniteelements.hh>
 
 bool success = true;
 
@@ -196,6 +224,12 @@ void check(Dune::GeometryType type,
     case Dune::QuadratureType::GaussLobatto: qt_str = "GaussLobatto"; break;
     case Dune::QuadratureType::GaussRadauLeft: qt_str = "GaussRadauLeft"; break;
     case Dune::QuadratureType::GaussRadauRight: qt_str = "GaussRadauRight"; break;
+    case Dune::QuadratureType::GaussKronrod: qt_str = "GaussKronrod"; break;
+    case Dune::QuadratureType::GaussPatterson: qt_str = "GaussPatterson"; break;
+    case Dune::QuadratureType::ClenshawCurtis: qt_str = "ClenshawCurtis"; break;
+    case Dune::QuadratureType::SmolyakClenshawCurtis: qt_str = "SmolyakClenshawCurtis"; break;
+    case Dune::QuadratureType::SmolyakGaussPatterson: qt_str = "SmolyakGaussPatterson"; break;
+    case Dune::QuadratureType::FullySymmetric: qt_str = "FullySymmetric"; break;
     default: qt_str = "unknown";
   }
   std::cout << "check(Quadrature of type " << qt_str << ")" << std::endl;
@@ -232,10 +266,33 @@ void checkCompositeRule(Dune::GeometryType type,
   for (unsigned int p=0; p<=maxOrder; ++p)
   {
     const BaseQuad& baseQuad = Dune::QuadratureRules<ctype,dim>::rule(type, p, qt);
-    Quad quad = Quad(baseQuad, Dune::refinementLevels(maxRefinement));
+    Quad quad = Quad(baseQuad, Dune::refinementLevels(maxRefinement), qt);
 
     checkWeights(quad);
     checkQuadrature(quad);
+
+    // prisms and pyramids are split into simplices, integrated by the simplex rule of the same type
+    if (!type.isSimplex() && !type.isCube())
+    {
+      const auto& refinement = Dune::buildRefinement<dim,ctype>(type, Dune::GeometryTypes::simplex(dim));
+      const auto& subQuad = Dune::QuadratureRules<ctype,dim>::rule(Dune::GeometryTypes::simplex(dim), baseQuad.order(), qt);
+      if (quad.size() != refinement.nElements(Dune::refinementLevels(maxRefinement)) * subQuad.size())
+      {
+        std::cerr << "Error: Composite quadrature for " << type << " and order=" << p
+                  << " does not use the simplex rule of type " << qt << std::endl;
+        success = false;
+      }
+    }
+
+    // the cached composite rule is built only once and equals the constructed one
+    const Quad& cached = Quad::rule(type, p, Dune::refinementLevels(maxRefinement), qt);
+    if (&cached != &Quad::rule(type, p, Dune::refinementLevels(maxRefinement), qt)
+        || cached.size() != quad.size() || cached.order() != quad.order())
+    {
+      std::cerr << "Error: Cached composite quadrature for " << type << " and order=" << p
+                << " differs from the constructed rule" << std::endl;
+      success = false;
+    }
   }
   if (dim>0 && (dim>3 || type.isCube() || type.isSimplex()))
   {
@@ -244,6 +301,1227 @@ void checkCompositeRule(Dune::GeometryType type,
   }
 }
 
+// integrate the Legendre polynomials up to the order of the rule, the rules
+// beyond the tabulated orders are computed at run time
+template<class ctype>
+void checkHighOrderRule(unsigned int order, Dune::QuadratureType::Enum qt)
+{
+  using std::abs;
+  const Dune::QuadratureRule<ctype, 1>& quad = Dune::QuadratureRules<ctype, 1>::rule(Dune::GeometryTypes::line, order, qt);
+  if (static_cast<unsigned>(quad.order()) < order)
+  {
+    std::cerr << "Error: Quadrature of type " << qt << " and order=" << order << " has order " << quad.order() << std::endl;
+    success = false;
+    return;
+  }
+
+  std::vector<ctype> integrals(quad.order()+1, ctype(0));
+  for (std::size_t q = 0; q < quad.size(); ++q)
+  {
+    const ctype x = ctype(2)*quad[q].position()[0] - ctype(1);
+    if (quad[q].weight() <= 0 || quad[q].position()[0] < 0 || quad[q].position()[0] > 1)
+    {
+      std::cerr << "Error: Quadrature of type " << qt << " and order=" << order
+                << " has points outside of the interval or non-positive weights" << std::endl;
+      success = false;
+      return;
+    }
+
+    ctype p0 = ctype(1), p1 = x;
+    integrals[0] += quad[q].weight();
+    for (int k = 1; k <= quad.order(); ++k)
+    {
+      integrals[k] += quad[q].weight() * p1;
+      const ctype p2 = (ctype(2*k+1)*x*p1 - ctype(k)*p0) / ctype(k+1);
+      p0 = p1;
+      p1 = p2;
+    }
+  }
+
+  for (int k = 0; k <= quad.order(); ++k)
+    if (abs(integrals[k] - ctype(k == 0 ? 1 : 0)) > 10*eps<ctype>())
+    {
+      std::cerr << "Error: Quadrature of type " << qt << " and order=" << order
+                << " integrates P_" << k << " to " << integrals[k] << std::endl;
+      success = false;
+      return;
+    }
+}
+
+// the embedded rule of an EmbeddedQuadratureRule as a quadrature rule of its own
+template<class ctype, int dim>
+struct EmbeddedRule : public Dune::QuadratureRule<ctype, dim>
+{
+  EmbeddedRule (const Dune::EmbeddedQuadratureRule<ctype, dim>& quad)
+    : Dune::QuadratureRule<ctype, dim>(quad.type(), quad.embeddedOrder())
+  {
+    for (std::size_t i = 0; i < quad.size(); ++i)
+      if (quad.embeddedWeights()[i] != 0)
+        this->push_back(Dune::QuadraturePoint<ctype, dim>(quad[i].position(), quad.embeddedWeights()[i]));
+  }
+};
+
+template<class ctype, int dim>
+void checkEmbeddedRules(Dune::GeometryType type, unsigned int maxOrder, Dune::QuadratureType::Enum qt)
+{
+  typedef Dune::EmbeddedQuadratureRule<ctype, dim> Quad;
+  for (unsigned int p=0; p<=maxOrder; ++p)
+  {
+    const Quad& quad = Quad::rule(type, p, qt);
+    if (static_cast<unsigned>(quad.order()) < p || quad.embeddedOrder() >= quad.order())
+    {
+      std::cerr << "Error: Embedded quadrature for " << type << " and order=" << p << " has order "
+                << quad.order() << " and embedded order " << quad.embeddedOrder() << std::endl;
+      success = false;
+    }
+    checkWeights(quad);
+    checkQuadrature(quad);
+
+    // the embedded rule uses a subset of the points and has its own order
+    if (quad.embeddedOrder() >= 0)
+    {
+      const EmbeddedRule<ctype, dim> embedded(quad);
+      if (embedded.size() >= quad.size())
+      {
+        std::cerr << "Error: Embedded quadrature for " << type << " and order=" << p << " uses all points" << std::endl;
+        success = false;
+      }
+      checkWeights(embedded);
+      checkQuadrature(embedded);
+    }
+  }
+}
+
+// integrate functions whose derivatives are singular at a vertex of the reference element
+template<int dim>
+void checkAdaptiveQuadrature(Dune::GeometryType type, Dune::QuadratureType::Enum qt, int order, double tolerance)
+{
+  using std::sqrt; using std::abs;
+  double exact;
+  std::function<double(const Dune::FieldVector<double, dim>&)> f = [](const auto& x) {
+    double s = 0;
+    for (int i = 0; i < dim; ++i)
+      s += x[i];
+    return sqrt(s);
+  };
+
+  if (type.isLine())
+    exact = 2.0/3;
+  else if (type.isTriangle())
+    exact = 2.0/5;
+  else if (type.isQuadrilateral())
+    exact = 2.0/5 + 4.0/3*(2*sqrt(2.0) - 1) - 2.0/5*(4*sqrt(2.0) - 1);
+  else if (type.isTetrahedron())
+    exact = 1.0/7;
+  else if (type.isPrism())
+    exact = 1.0/7 + 2.0/5*(4*sqrt(2.0) - 1) - 1.0/7*(8*sqrt(2.0) - 1);
+  else if (type.isHexahedron())
+    exact = 1.0/7
+      - 2.0/7*(8*sqrt(2.0) - 1) + 6.0/5*(4*sqrt(2.0) - 1) - (2*sqrt(2.0) - 1)
+      + 3*(3*sqrt(3.0) - 2*sqrt(2.0)) - 6.0/5*(9*sqrt(3.0) - 4*sqrt(2.0)) + 1.0/7*(27*sqrt(3.0) - 8*sqrt(2.0));
+  else
+  {
+    // singular integrand at the apex of the pyramid
+    exact = 2.0/5;
+    f = [](const auto& x) { return 1.0 / sqrt(1.0 - x[dim-1]); };
+  }
+
+  const Dune::AdaptiveQuadrature<double, dim> adaptive(tolerance, 0.0, 10000000, order, qt);
+  const auto result = adaptive.integrate(type, f);
+  if (!result.converged || abs(result.value - exact) > tolerance || result.error < abs(result.value - exact))
+  {
+    std::cerr << "Error: Adaptive quadrature for " << type << " and QuadratureType " << qt << " gives "
+              << result.value << " with estimated error " << result.error << " instead of " << exact
+              << " (" << result.evaluations << " evaluations on " << result.elements << " elements)" << std::endl;
+    success = false;
+  }
+}
+
+// the area of a bilinear quadrilateral computed from its integration element
+void checkAdaptiveVolume()
+{
+  using std::abs;
+  const Dune::MultiLinearGeometry<double, 2, 2> geometry(Dune::GeometryTypes::quadrilateral,
+    std::vector<Dune::FieldVector<double, 2>>{ {0.0, 0.0}, {2.0, 0.0}, {0.0, 1.0}, {3.0, 3.0} });
+  const Dune::AdaptiveQuadrature<double, 2> adaptive(1e-12, 1e-12);
+  const auto result = adaptive.integrate(geometry, [](const auto&) { return 1.0; });
+  if (abs(result.value - 4.5) > 1e-12 || result.elements != 1)
+  {
+    std::cerr << "Error: Adaptive volume of a bilinear quadrilateral is " << result.value
+              << " instead of 4.5 (" << result.elements << " elements)" << std::endl;
+    success = false;
+  }
+}
+
+// the cached rules on sub-entities agree with the rules mapped by the sub-entity geometries
+template<int dim, int codim = 1>
+void checkSubEntityRules(Dune::GeometryType type, int order)
+{
+  using std::abs;
+  const auto refElement = Dune::ReferenceElements<double, dim>::general(type);
+  const auto& rules = Dune::SubEntityQuadratureRule<double, dim>::rules(type, codim, order);
+  if (int(rules.size()) != refElement.size(codim) || &rules != &Dune::SubEntityQuadratureRule<double, dim>::rules(type, codim, order))
+  {
+    std::cerr << "Error: Sub-entity rules of codim " << codim << " for " << type << " are not cached" << std::endl;
+    success = false;
+  }
+
+  for (int i = 0; i < refElement.size(codim); ++i)
+  {
+    const auto& rule = rules[i];
+    const auto geometry = refElement.template geometry<codim>(i);
+    const auto& quad = Dune::QuadratureRules<double, dim-codim>::rule(geometry.type(), order);
+    bool match = (rule.size() == quad.size() && rule.subEntityType() == geometry.type() && rule.order() == quad.order());
+    double volume = 0;
+    for (std::size_t q = 0; match && q < quad.size(); ++q)
+    {
+      match = (rule.positions()[q] == geometry.global(quad[q].position()) && rule.weights()[q] == quad[q].weight());
+      volume += rule.weights()[q] * rule.integrationElement();
+    }
+    if (!match || abs(volume - refElement.template geometry<codim>(i).volume()) > 10 * eps<double>())
+    {
+      std::cerr << "Error: Rule on sub-entity " << i << " of codim " << codim << " of " << type
+                << " does not match the sub-entity geometry" << std::endl;
+      success = false;
+    }
+    if constexpr (codim == 1)
+      if (rule.integrationOuterNormal() != refElement.integrationOuterNormal(i))
+      {
+        std::cerr << "Error: Normal of face " << i << " of " << type << " does not match the reference element" << std::endl;
+        success = false;
+      }
+  }
+
+  if constexpr (codim < dim)
+    checkSubEntityRules<dim, codim+1>(type, order);
+}
+
+// the points of a symmetric rule mapped by every symmetry of the reference element are points of the rule
+template<int dim>
+void checkPermutedRules(Dune::GeometryType type, int order, std::size_t numSymmetries)
+{
+  using std::abs;
+  using Permuted = Dune::PermutedQuadratureRule<double, dim>;
+  const auto symmetries = Permuted::symmetries(type);
+  if (symmetries.size() != numSymmetries)
+  {
+    std::cerr << "Error: Found " << symmetries.size() << " symmetries of " << type
+              << " instead of " << numSymmetries << std::endl;
+    success = false;
+  }
+
+  const auto& quad = Dune::QuadratureRules<double, dim>::rule(type, order);
+  const auto& allPermuted = Permuted::rules(type, order);
+  if (allPermuted.size() != symmetries.size())
+  {
+    std::cerr << "Error: Rules of order " << order << " on " << type << " are not cached for all symmetries" << std::endl;
+    success = false;
+  }
+  for (const auto& vertexPermutation : symmetries)
+  {
+    const int symmetry = Permuted::symmetryIndex(type, vertexPermutation);
+    const auto& permuted = Permuted::rule(type, vertexPermutation, order);
+    bool match = (permuted.isPermutation() && permuted.size() == quad.size()
+                  && permuted.vertexPermutation() == vertexPermutation
+                  && &permuted == &Permuted::rule(type, symmetry, order) && &permuted == &allPermuted[symmetry]);
+    for (std::size_t q = 0; match && q < quad.size(); ++q)
+    {
+      const auto& image = quad[permuted.permutation()[q]];
+      match = ((image.position() - permuted.positions()[q]).infinity_norm() < 100 * eps<double>() && abs(image.weight() - quad[q].weight()) < 100 * eps<double>() * abs(quad[q].weight()));
+    }
+    if (!match)
+    {
+      std::cerr << "Error: Rule of order " << order << " on " << type << " is not mapped onto itself by a vertex permutation" << std::endl;
+      success = false;
+    }
+  }
+
+  // the vertex permutation between two reduced vertex orders
+  std::vector<int> first(symmetries.back().size()), second(first.size());
+  std::iota(first.begin(), first.end(), 0);
+  std::reverse_copy(first.begin(), first.end(), second.begin());
+  const auto vertexPermutation = Permuted::vertexPermutation(first, second);
+  for (std::size_t i = 0; i < first.size(); ++i)
+    if (second[vertexPermutation[i]] != first[i])
+    {
+      std::cerr << "Error: Wrong vertex permutation between two vertex orders" << std::endl;
+      success = false;
+    }
+
+  // a permutation that does not map edges onto edges is rejected
+  if (type.isQuadrilateral() && (Permuted::isSymmetry(type, {0, 3, 2, 1}) || Permuted::symmetryIndex(type, {0, 3, 2, 1}) >= 0))
+  {
+    std::cerr << "Error: Vertex permutation not mapping edges onto edges accepted as symmetry" << std::endl;
+    success = false;
+  }
+}
+
+// the factors of product rules and the rules generated from them on the fly
+template<class ctype, int dim>
+void checkTensorProductFactors(Dune::GeometryType type, int order, Dune::QuadratureType::Enum qt)
+{
+  using std::abs;
+  const Dune::TensorProductQuadratureRule<ctype, dim> rule(type, order, qt);
+  checkQuadrature(rule);
+  if (rule.size() != rule.baseRule().size() * rule.lineRule().size())
+  {
+    std::cerr << "Error: TensorProductQuadratureRule for " << type << " and order=" << order
+              << " is not the product of its factors" << std::endl;
+    success = false;
+  }
+  for (std::size_t q = 0; q < rule.size(); ++q)
+  {
+    const auto& basePoint = rule.baseRule()[q / rule.lineRule().size()];
+    const auto& linePoint = rule.lineRule()[q % rule.lineRule().size()];
+    const ctype z = linePoint.position()[0];
+    const ctype weight = basePoint.weight() * linePoint.weight() * rule.conicalWeight(z);
+    if (abs(rule[q].weight() - weight) > 4 * eps<ctype>() * weight || rule[q].position()[dim-1] != z)
+    {
+      std::cerr << "Error: Point " << q << " of TensorProductQuadratureRule for " << type << " and order=" << order
+                << " does not match its factors" << std::endl;
+      success = false;
+    }
+  }
+
+  const Dune::TensorProductQuadratureFactors<ctype, dim> factors(type, order, qt);
+  checkQuadrature(factors);
+  checkWeights(factors);
+  std::size_t size = 0;
+  for (auto it = factors.begin(); it != factors.end(); ++it)
+    ++size;
+  if (size != factors.size())
+  {
+    std::cerr << "Error: TensorProductQuadratureFactors for " << type << " and order=" << order
+              << " iterate over " << size << " instead of " << factors.size() << " points" << std::endl;
+    success = false;
+  }
+}
+
+// the factors generate the same points as QuadratureRules where its rule is a product of 1d rules
+template<class ctype, int dim>
+void checkTensorProductFactorsMatch(Dune::GeometryType type, int order, Dune::QuadratureType::Enum qt)
+{
+  const Dune::QuadratureRule<ctype, dim>& rule = Dune::QuadratureRules<ctype, dim>::rule(type, order, qt);
+  const Dune::TensorProductQuadratureFactors<ctype, dim> factors(type, order, qt);
+  bool match = (rule.size() == factors.size());
+  std::size_t q = 0;
+  for (auto it = factors.begin(); match && it != factors.end(); ++it, ++q)
+    match = (it->position() == rule[q].position() && it->weight() == rule[q].weight());
+  if (!match)
+  {
+    std::cerr << "Error: TensorProductQuadratureFactors for " << type << " and order=" << order
+              << " differ from the rule of QuadratureRules" << std::endl;
+    success = false;
+  }
+
+  // the cached rule keeps its factors
+  typedef Dune::QuadratureRules<ctype, dim> Rules;
+  const auto* cached = Rules::factors(type, order, qt);
+  if (!cached || cached != Rules::factors(rule) || cached->size() != rule.size() || cached->order() != order)
+  {
+    std::cerr << "Error: Cached rule for " << type << " and order=" << order
+              << " does not provide its TensorProductQuadratureFactors" << std::endl;
+    success = false;
+  }
+}
+
+// compare the geometric factors at the collocation points to the ones of the geometry
+template<int dim, int cdim>
+void checkGaussLobattoCollocation(int order, const std::vector<Dune::FieldVector<double, cdim>>& corners)
+{
+  using std::abs;
+  const Dune::GaussLobattoCollocationRule<double, dim>& rule = Dune::GaussLobattoCollocationRule<double, dim>::rule(order);
+  checkQuadrature(rule);
+  checkWeights(rule);
+  std::size_t size = 1;
+  for (int e = 0; e < dim; ++e)
+    size *= Dune::QuadratureRules<double, 1>::rule(Dune::GeometryTypes::line, order, Dune::QuadratureType::GaussLobatto).size();
+  if (rule.size() != size)
+  {
+    std::cerr << "Error: Gauss-Lobatto collocation rule of order " << order << " has " << rule.size()
+              << " points, the product of the 1d GaussLobatto rules has a different number" << std::endl;
+    success = false;
+  }
+  for (std::size_t q = 0; q < rule.size(); ++q)
+    for (std::size_t e = 0, index = q; e < std::size_t(dim); ++e, index /= rule.size1d())
+      if (rule[q].position()[e] != rule.points1d()[index % rule.size1d()]
+          || (index % rule.size1d() > 0 && rule.points1d()[index % rule.size1d() - 1] >= rule.points1d()[index % rule.size1d()]))
+      {
+        std::cerr << "Error: Gauss-Lobatto collocation point " << q << " of order " << order
+                  << " is not in lexicographic order" << std::endl;
+        success = false;
+      }
+
+  const Dune::MultiLinearGeometry<double, dim, cdim> geometry(Dune::GeometryTypes::cube(dim), corners);
+  Dune::GaussLobattoGeometricFactors<double, dim, cdim> factors(order);
+  factors.bind(geometry);
+  const double tolerance = 100 * eps<double>();
+  double volume = 0;
+  for (std::size_t q = 0; q < factors.size(); ++q)
+  {
+    const auto& x = rule[q].position();
+    volume += factors.massWeights()[q];
+    const double massWeight = rule[q].weight() * geometry.integrationElement(x);
+    const auto jit = geometry.jacobianInverseTransposed(x);
+    double jitError = 0;
+    for (int i = 0; i < cdim; ++i)
+      for (int j = 0; j < dim; ++j)
+        jitError = std::max(jitError, abs(factors.jacobianInverseTransposed()[q][i][j] - jit[i][j]) / (1 + abs(jit[i][j])));
+    if (abs(factors.massWeights()[q] - massWeight) > tolerance * massWeight || jitError > tolerance
+        || (factors.globalPoints()[q] - geometry.global(x)).infinity_norm() > tolerance)
+    {
+      std::cerr << "Error: Geometric factors at Gauss-Lobatto collocation point " << q << " of order " << order
+                << " in dimension " << dim << " differ from the geometry" << std::endl;
+      success = false;
+    }
+  }
+
+  // the integration element is a polynomial of degree dim-1 in every direction unless cdim > dim
+  double exactVolume = 0;
+  for (const auto& qp : Dune::QuadratureRules<double, dim>::rule(geometry.type(), 2*dim))
+    exactVolume += qp.weight() * geometry.integrationElement(qp.position());
+  if (dim == cdim && abs(volume - exactVolume) > tolerance * exactVolume)
+  {
+    std::cerr << "Error: Gauss-Lobatto mass weights of order " << order << " in dimension " << dim
+              << " sum up to " << volume << " instead of " << exactVolume << std::endl;
+    success = false;
+  }
+}
+
+template<class ctype, int dim, Dune::GeometryType::Id geometryId>
+void checkStaticRuleAccess(unsigned int maxOrder,
+                           Dune::QuadratureType::Enum qt = Dune::QuadratureType::GaussLegendre)
+{
+  typedef Dune::QuadratureRules<ctype, dim> Rules;
+  const Dune::GeometryType type = geometryId;
+  maxOrder = std::min(maxOrder, Rules::maxOrder(type, qt));
+  for (unsigned int p=0; p<=maxOrder; ++p)
+  {
+    // both accessors have to hand out the same cached rule
+    if (&Rules::rule(type, p, qt) != &Rules::template rule<geometryId>(p, qt))
+    {
+      std::cerr << "Error: Compile-time access to the quadrature rule for " << type
+                << " and order=" << p << " returns a different rule" << std::endl;
+      success = false;
+    }
+  }
+
+  // requesting an order that is not available has to throw
+  const unsigned int invalidOrder = Rules::maxOrder(type, qt) + 1;
+  try {
+    Rules::rule(type, invalidOrder, qt);
+    std::cerr << "Error: Quadrature for " << type << " and order=" << invalidOrder
+              << " should not be available" << std::endl;
+    success = false;
+  }
+  catch (const Dune::QuadratureOrderOutOfRange&) {}
+}
+
+// check that a rule integrates all monomials x^alpha with |alpha| <= p exactly,
+// exact(alpha) returns the integral of x^alpha over the reference element
+template<class ctype, int dim, class Exact>
+void checkMonomials(const Dune::QuadratureRule<ctype,dim>& quad, unsigned int p, Exact&& exact)
+{
+  using std::abs;
+  std::array<unsigned int, dim> alpha{};
+  while (true)
+  {
+    unsigned int degree = 0;
+    for (int i=0; i<dim; ++i)
+      degree += alpha[i];
+
+    ctype integral = 0;
+    for (const auto& qp : quad)
+    {
+      ctype value = qp.weight();
+      for (int i=0; i<dim; ++i)
+        value *= Dune::power(qp.position()[i], int(alpha[i]));
+      integral += value;
+    }
+    const ctype exactIntegral = exact(alpha);
+    if (abs(integral - exactIntegral) > 32*eps<ctype>()*exactIntegral*quad.size())
+    {
+      std::cerr << "Error: Quadrature for " << quad.type() << " and order=" << p
+                << " does not integrate the monomial of degree " << degree << " exactly" << std::endl;
+      success = false;
+      return;
+    }
+
+    // next exponent
+    int i = 0;
+    for (; i<dim; ++i)
+    {
+      if (degree < p)
+      {
+        ++alpha[i];
+        break;
+      }
+      degree -= alpha[i];
+      alpha[i] = 0;
+    }
+    if (i == dim)
+      return;
+  }
+}
+
+// check that all points are in the interior of the reference element and all weights are positive
+template<class ctype, int dim>
+void checkInterior(const Dune::QuadratureRule<ctype,dim>& quad, unsigned int p)
+{
+  for (const auto& qp : quad)
+  {
+    bool inside = (qp.weight() > 0);
+    ctype lambda0 = 1;
+    for (int i=0; i<dim; ++i)
+    {
+      inside = inside && (qp.position()[i] > 0) && (qp.position()[i] < 1);
+      lambda0 -= qp.position()[i];
+    }
+    if (quad.type().isSimplex())
+      inside = inside && (lambda0 > 0);
+    if (quad.type().isPrism())
+      inside = inside && (qp.position()[0] + qp.position()[1] < 1);
+    if (quad.type().isPyramid())
+      inside = inside && (qp.position()[0] + qp.position()[2] < 1) && (qp.position()[1] + qp.position()[2] < 1);
+    if (!inside)
+    {
+      std::cerr << "Error: Quadrature for " << quad.type() << " and order=" << p
+                << " has a point outside or a non-positive weight" << std::endl;
+      success = false;
+      return;
+    }
+  }
+}
+
+// the simplex rules integrate all monomials of degree <= order, the symmetric
+// rules starting at symmetricOrder have positive weights and interior points
+template<class ctype, int dim>
+void checkSimplexRules(unsigned int symmetricOrder, unsigned int maxOrder)
+{
+  const auto factorial = [](unsigned int n) {
+    ctype f = 1;
+    for (unsigned int k=2; k<=n; ++k)
+      f *= k;
+    return f;
+  };
+
+  maxOrder = std::min<unsigned int>(maxOrder, Dune::SimplexQuadratureRule<ctype,dim>::highest_order);
+  for (unsigned int p=0; p<=maxOrder; ++p)
+  {
+    const auto& quad = Dune::QuadratureRules<ctype,dim>::rule(Dune::GeometryTypes::simplex(dim), p);
+    if (p >= symmetricOrder)
+      checkInterior(quad, p);
+    checkMonomials(quad, p, [&](const std::array<unsigned int, dim>& alpha) {
+      unsigned int degree = 0;
+      ctype exact = 1;
+      for (int i=0; i<dim; ++i)
+      {
+        degree += alpha[i];
+        exact *= factorial(alpha[i]);
+      }
+      return exact / factorial(degree + dim);
+    });
+  }
+}
+
+// the symmetric cube rules have positive weights, interior points, integrate all
+// monomials of degree <= order and need fewer points than the Gauss tensor product rules,
+// the default Gauss-Legendre rules integrate all monomials of degree <= order in each variable
+template<class ctype, int dim>
+void checkCubeRules(unsigned int maxOrder)
+{
+  using std::abs;
+  for (unsigned int p=0; p<=maxOrder; ++p)
+  {
+    const auto& gauss = Dune::QuadratureRules<ctype,dim>::rule(Dune::GeometryTypes::cube(dim), p);
+    ctype integral = 0;
+    for (const auto& qp : gauss)
+    {
+      ctype value = qp.weight();
+      for (int i=0; i<dim; ++i)
+        value *= Dune::power(qp.position()[i], int(p));
+      integral += value;
+    }
+    const ctype exact = ctype(1) / Dune::power(ctype(p+1), dim);
+    if (abs(integral - exact) > 32*eps<ctype>()*exact*gauss.size())
+    {
+      std::cerr << "Error: Quadrature for " << gauss.type() << " and order=" << p
+                << " does not integrate the product of monomials of degree " << p << " exactly" << std::endl;
+      success = false;
+    }
+  }
+
+  maxOrder = std::min<unsigned int>(maxOrder, Dune::CubeQuadratureRule<ctype,dim>::highest_order);
+  for (unsigned int p=0; p<=maxOrder; ++p)
+  {
+    const auto& quad = Dune::QuadratureRules<ctype,dim>::rule(Dune::GeometryTypes::cube(dim), p,
+                                                              Dune::QuadratureType::FullySymmetric);
+    checkInterior(quad, p);
+    checkMonomials(quad, p, [](const std::array<unsigned int, dim>& alpha) {
+      ctype exact = 1;
+      for (int i=0; i<dim; ++i)
+        exact /= alpha[i] + 1;
+      return exact;
+    });
+
+    const std::size_t gaussSize = Dune::power(p/2 + 1, dim);
+    if (quad.size() > gaussSize || (p >= 4 && quad.size() == gaussSize))
+    {
+      std::cerr << "Error: Quadrature for " << quad.type() << " and order=" << p
+                << " has " << quad.size() << " points, the Gauss tensor product rule has "
+                << gaussSize << std::endl;
+      success = false;
+    }
+
+    // points close to the boundary spoil the conditioning of the rule
+    bool nearBoundary = false;
+    for (const auto& qp : quad)
+      for (int i=0; i<dim; ++i)
+        nearBoundary = nearBoundary || qp.position()[i] < 1e-3 || qp.position()[i] > 1 - 1e-3;
+    if (nearBoundary)
+    {
+      std::cerr << "Error: Quadrature for " << quad.type() << " and order=" << p
+                << " has a point close to the boundary" << std::endl;
+      success = false;
+    }
+  }
+}
+
+// the symmetric prism rules have positive weights, interior points, integrate all monomials of
+// degree <= order and need at most as many points as the triangle rule times the Gauss rule,
+// the default Gauss-Legendre rules integrate all x^a y^b z^c with a+b <= order and c <= order
+template<class ctype>
+void checkPrismRules(unsigned int maxOrder)
+{
+  using std::abs;
+  const auto factorial = [](unsigned int n) {
+    ctype f = 1;
+    for (unsigned int k=2; k<=n; ++k)
+      f *= k;
+    return f;
+  };
+
+  for (unsigned int p=0; p<=maxOrder; ++p)
+  {
+    const auto& gauss = Dune::QuadratureRules<ctype,3>::rule(Dune::GeometryTypes::prism, p);
+    for (unsigned int a=0; a<=p; ++a)
+      for (unsigned int b=0; a+b<=p; ++b)
+        for (unsigned int c=0; c<=p; ++c)
+        {
+          ctype integral = 0;
+          for (const auto& qp : gauss)
+            integral += qp.weight() * Dune::power(qp.position()[0], int(a))
+                        * Dune::power(qp.position()[1], int(b)) * Dune::power(qp.position()[2], int(c));
+          const ctype exact = factorial(a) * factorial(b) / factorial(a + b + 2) / (c + 1);
+          if (abs(integral - exact) > 32*eps<ctype>()*exact*gauss.size())
+          {
+            std::cerr << "Error: Quadrature for " << gauss.type() << " and order=" << p
+                      << " does not integrate x^" << a << " y^" << b << " z^" << c << " exactly" << std::endl;
+            success = false;
+          }
+        }
+
+    const auto& quad = Dune::QuadratureRules<ctype,3>::rule(Dune::GeometryTypes::prism, p,
+                                                            Dune::QuadratureType::FullySymmetric);
+    checkInterior(quad, p);
+    checkMonomials(quad, p, [&](const std::array<unsigned int, 3>& alpha) {
+      return factorial(alpha[0]) * factorial(alpha[1]) / factorial(alpha[0] + alpha[1] + 2) / (alpha[2] + 1);
+    });
+
+    const std::size_t productSize = Dune::QuadratureRules<ctype,2>::rule(Dune::GeometryTypes::triangle, p).size()
+                                    * Dune::QuadratureRules<ctype,1>::rule(Dune::GeometryTypes::line, p).size();
+    if (quad.size() > productSize)
+    {
+      std::cerr << "Error: Quadrature for " << quad.type() << " and order=" << p
+                << " has " << quad.size() << " points, the product rule has " << productSize << std::endl;
+      success = false;
+    }
+  }
+}
+
+// the symmetric pyramid rules have positive weights, interior points and integrate all
+// monomials of degree <= order
+template<class ctype>
+void checkPyramidRules(unsigned int maxOrder)
+{
+  maxOrder = std::min<unsigned int>(maxOrder, Dune::PyramidQuadratureRule<ctype,3>::highest_order);
+  for (unsigned int p=0; p<=maxOrder; ++p)
+  {
+    const auto& quad = Dune::QuadratureRules<ctype,3>::rule(Dune::GeometryTypes::pyramid, p);
+    checkInterior(quad, p);
+    checkMonomials(quad, p, [](const std::array<unsigned int, 3>& alpha) {
+      // int_0^1 z^c (1-z)^(a+b+2) dz / ((a+1)(b+1))
+      const unsigned int n = alpha[0] + alpha[1] + 2;
+      ctype exact = ctype(1) / ((alpha[0] + 1) * (alpha[1] + 1) * (n + 1));
+      for (unsigned int k=1; k<=alpha[2]; ++k)
+        exact *= ctype(k) / (n + 1 + k);
+      return exact;
+    });
+  }
+}
+
+template<class ctype, Dune::GeometryType::Id geometryId, int p, Dune::QuadratureType::Enum qt>
+void checkStaticRule()
+{
+  typedef Dune::StaticQuadratureRule<ctype, geometryId, p, qt> StaticRule;
+  constexpr int dim = StaticRule::d;
+  const Dune::GeometryType type = geometryId;
+  const auto& quad = Dune::QuadratureRules<ctype, dim>::rule(type, p, qt);
+
+  if (StaticRule::size() != quad.size() || StaticRule::order() != quad.order() || StaticRule::type() != quad.type())
+  {
+    std::cerr << "Error: Static quadrature for " << type << " and order=" << p
+              << " does not match the size, order or type of the dynamic rule" << std::endl;
+    success = false;
+    return;
+  }
+
+  using std::abs;
+  const ctype tol = 4*eps<ctype>();
+  for (std::size_t q=0; q<quad.size(); ++q)
+  {
+    bool match = abs(StaticRule::weight(q) - quad[q].weight()) <= tol;
+    for (int i=0; i<dim; ++i)
+      match = match && abs(StaticRule::position(q)[i] - quad[q].position()[i]) <= tol;
+    if (!match)
+    {
+      std::cerr << "Error: Static quadrature for " << type << " and order=" << p
+                << " differs from the dynamic rule at point " << q << std::endl;
+      success = false;
+      return;
+    }
+  }
+}
+
+template<class ctype, Dune::GeometryType::Id geometryId,
+         Dune::QuadratureType::Enum qt = Dune::QuadratureType::GaussLegendre, int... p>
+void checkStaticRules(std::integer_sequence<int, p...>)
+{
+  (checkStaticRule<ctype, geometryId, p, qt>(), ...);
+}
+
+template<class ctype, int dim>
+void checkArrays(Dune::GeometryType type,
+                 unsigned int maxOrder,
+                 Dune::QuadratureType::Enum qt = Dune::QuadratureType::GaussLegendre)
+{
+  typedef Dune::QuadratureRules<ctype, dim> Rules;
+  typedef Dune::QuadratureRuleSoA<ctype, dim> Arrays;
+  maxOrder = std::min(maxOrder, Rules::maxOrder(type, qt));
+  for (unsigned int p=0; p<=maxOrder; ++p)
+  {
+    const auto& quad = Rules::rule(type, p, qt);
+    const Arrays& arrays = Rules::soa(type, p, qt);
+    if (Rules::soa(quad) != &arrays || arrays.size() != quad.size() || arrays.paddedSize() < quad.size())
+    {
+      std::cerr << "Error: Arrays of the quadrature for " << type << " and order=" << p
+                << " do not belong to the rule" << std::endl;
+      success = false;
+      continue;
+    }
+
+    bool aligned = (reinterpret_cast<std::uintptr_t>(arrays.weights()) % Arrays::alignment == 0);
+    for (int i=0; i<dim; ++i)
+      aligned = aligned && (reinterpret_cast<std::uintptr_t>(arrays.positions(i)) % Arrays::alignment == 0);
+    if (!aligned)
+    {
+      std::cerr << "Error: Arrays of the quadrature for " << type << " and order=" << p
+                << " are not aligned" << std::endl;
+      success = false;
+    }
+
+    for (std::size_t q=0; q<arrays.paddedSize(); ++q)
+    {
+      bool match = (q < quad.size()) ? (arrays.weights()[q] == quad[q].weight()) : (arrays.weights()[q] == ctype(0));
+      for (int i=0; i<dim && q<quad.size(); ++i)
+        match = match && (arrays.positions(i)[q] == quad[q].position()[i]);
+      if (!match)
+      {
+        std::cerr << "Error: Arrays of the quadrature for " << type << " and order=" << p
+                  << " differ from the rule at point " << q << std::endl;
+        success = false;
+        break;
+      }
+    }
+  }
+
+  // rules that are not cached have no arrays
+  Dune::QuadratureRule<ctype, dim> copy = Rules::rule(type, 0, qt);
+  if (Rules::soa(copy) != nullptr)
+  {
+    std::cerr << "Error: Copy of a quadrature rule for " << type << " reports cached arrays" << std::endl;
+    success = false;
+  }
+}
+
+// the identities of the cached rules are unique and do not depend on the address of the rule
+void checkRuleIds()
+{
+  std::set<std::uint64_t> ids;
+  std::size_t numRules = 0;
+  auto collect = [&](std::uint64_t id, std::uint64_t expected) {
+    ++numRules;
+    ids.insert(id);
+    if (id == 0 || id != expected)
+    {
+      std::cerr << "Error: Identity " << id << " of a cached rule differs from " << expected << std::endl;
+      success = false;
+    }
+  };
+  for (int p : {0, 1, 5, 20})
+    for (auto qt : { Dune::QuadratureType::GaussLegendre, Dune::QuadratureType::GaussLobatto })
+    {
+      collect(Dune::QuadratureRules<double,1>::id(Dune::QuadratureRules<double,1>::rule(Dune::GeometryTypes::line, p, qt)),
+              Dune::quadratureRuleId<double>(Dune::GeometryTypes::line, p, qt));
+      collect(Dune::QuadratureRules<float,1>::id(Dune::QuadratureRules<float,1>::rule(Dune::GeometryTypes::line, p, qt)),
+              Dune::quadratureRuleId<float>(Dune::GeometryTypes::line, p, qt));
+      for (auto type : { Dune::GeometryTypes::triangle, Dune::GeometryTypes::quadrilateral })
+        collect(Dune::QuadratureRules<double,2>::id(Dune::QuadratureRules<double,2>::rule(type, p, qt)),
+                Dune::quadratureRuleId<double>(type, p, qt));
+    }
+  if (ids.size() != numRules)
+  {
+    std::cerr << "Error: Different cached rules have the same identity" << std::endl;
+    success = false;
+  }
+
+  // both topology ids of a line, as used by the tensor-product rules, give the same identity
+  const Dune::GeometryType line(0, 1);
+  if (Dune::QuadratureRules<double,1>::id(Dune::QuadratureRules<double,1>::rule(line, 7))
+      != Dune::quadratureRuleId<double>(Dune::GeometryTypes::line, 7, Dune::QuadratureType::GaussLegendre))
+  {
+    std::cerr << "Error: Identity of a cached rule depends on the topology id of the line" << std::endl;
+    success = false;
+  }
+
+  // rules that are not cached have no identity
+  Dune::QuadratureRule<double,2> copy = Dune::QuadratureRules<double,2>::rule(Dune::GeometryTypes::triangle, 3);
+  if (Dune::QuadratureRules<double,2>::id(copy) != 0)
+  {
+    std::cerr << "Error: Copy of a quadrature rule reports an identity" << std::endl;
+    success = false;
+  }
+}
+
+// values of the tabulation cache are computed once per key, also by concurrent requests
+void checkRuleTabulationCache()
+{
+  typedef Dune::QuadratureRules<double,2> Rules;
+  Dune::RuleTabulationCache<std::uint64_t, std::vector<double> > cache;
+  std::atomic<int> numComputed(0);
+  auto tabulate = [&](int p) -> const std::vector<double>& {
+    const auto& quad = Rules::rule(Dune::GeometryTypes::triangle, p);
+    return cache(Rules::id(quad), [&]{
+      ++numComputed;
+      std::vector<double> values;
+      for (const auto& qp : quad)
+        values.push_back(qp.position()[0] * qp.position()[1]);
+      return values;
+    });
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&]{
+      for (int p = 0; p < 10; ++p)
+        tabulate(p);
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  const auto& values = tabulate(4);
+  if (numComputed != 10 || cache.size() != 10 || &values != &tabulate(4)
+      || cache.find(Rules::id(Rules::rule(Dune::GeometryTypes::triangle, 4))) != &values
+      || values.size() != Rules::rule(Dune::GeometryTypes::triangle, 4).size()
+      || cache.find(Dune::quadratureRuleId<double>(Dune::GeometryTypes::triangle, 11, Dune::QuadratureType::GaussLegendre)) != nullptr)
+  {
+    std::cerr << "Error: Tabulation cache computed " << numComputed << " values for " << cache.size() << " keys" << std::endl;
+    success = false;
+  }
+}
+
+// the points and weights mapped in one pass agree with the evaluation of the geometry point by point
+template<class Geometry>
+void checkMapQuadrature(const Geometry& geometry, int order, const std::string& name)
+{
+  typedef typename Geometry::ctype ctype;
+  constexpr int mydim = Geometry::mydimension;
+  constexpr int cdim = Geometry::coorddimension;
+  using std::abs;
+
+  const auto& quad = Dune::QuadratureRules<ctype, mydim>::rule(geometry.type(), order);
+  std::vector<Dune::FieldVector<ctype, cdim> > points(quad.size()), points2(quad.size());
+  std::vector<ctype> weights(quad.size()), weights2(quad.size());
+  std::vector<Dune::FieldMatrix<ctype, cdim, mydim> > jacobianInverseTransposeds(quad.size());
+  Dune::mapQuadrature(geometry, quad, points, weights);
+  Dune::mapQuadrature(geometry, quad, points2, weights2, jacobianInverseTransposeds);
+
+  const ctype tolerance = 100 * eps<ctype>();
+  for (std::size_t q = 0; q < quad.size(); ++q)
+  {
+    const auto& x = quad[q].position();
+    const ctype weight = quad[q].weight() * geometry.integrationElement(x);
+    Dune::FieldMatrix<ctype, cdim, mydim> jacobianInverseTransposed;
+    jacobianInverseTransposed = geometry.jacobianInverseTransposed(x);
+    jacobianInverseTransposed -= jacobianInverseTransposeds[q];
+    if ((points[q] - geometry.global(x)).infinity_norm() > tolerance || points2[q] != points[q]
+        || abs(weights[q] - weight) > tolerance || abs(weights2[q] - weight) > tolerance
+        || jacobianInverseTransposed.infinity_norm() > tolerance)
+    {
+      std::cerr << "Error: Mapped quadrature on " << name << " differs from the geometry at point " << q << std::endl;
+      success = false;
+      return;
+    }
+  }
+}
+
+// a non-affine mapping with its derivative
+struct BendMapping
+{
+  Dune::FieldVector<double, 2> operator() (const Dune::FieldVector<double, 2>& x) const
+  {
+    return {x[0] + 0.1*x[1]*x[1], x[1] + 0.2*x[0]*x[1]};
+  }
+
+  friend auto derivative (const BendMapping&)
+  {
+    return [](const Dune::FieldVector<double, 2>& x) {
+      return Dune::FieldMatrix<double, 2, 2>{{1.0, 0.2*x[1]}, {0.2*x[1], 1.0 + 0.2*x[0]}};
+    };
+  }
+};
+
+void checkMapQuadratures()
+{
+  typedef Dune::FieldVector<double, 2> Vector2;
+  typedef Dune::FieldVector<double, 3> Vector3;
+  const std::vector<Vector2> triangle = { {0.0, 0.0}, {2.0, 0.5}, {0.3, 1.0} };
+  const std::vector<Vector2> quadrilateral = { {0.0, 0.0}, {2.0, 0.0}, {0.0, 1.0}, {3.0, 2.0} };
+  const std::vector<Vector3> surface = { {0.0, 0.0, 0.0}, {1.0, 0.0, 0.5}, {0.0, 1.0, 0.0}, {1.0, 1.0, 2.0} };
+
+  checkMapQuadrature(Dune::AffineGeometry<double, 2, 2>(Dune::GeometryTypes::triangle, triangle), 6, "AffineGeometry");
+  checkMapQuadrature(Dune::MultiLinearGeometry<double, 2, 2>(Dune::GeometryTypes::quadrilateral, quadrilateral), 5, "MultiLinearGeometry");
+  checkMapQuadrature(Dune::MultiLinearGeometry<double, 2, 3>(Dune::GeometryTypes::quadrilateral, surface), 5, "MultiLinearGeometry surface");
+  checkMapQuadrature(Dune::CachedMultiLinearGeometry<double, 2, 2>(Dune::GeometryTypes::triangle, triangle), 4, "affine CachedMultiLinearGeometry");
+  checkMapQuadrature(Dune::CachedMultiLinearGeometry<double, 2, 2>(Dune::GeometryTypes::quadrilateral, quadrilateral), 4, "CachedMultiLinearGeometry");
+  checkMapQuadrature(Dune::AxisAlignedCubeGeometry<double, 3, 3>(Vector3{-1.0, 0.0, 2.0}, Vector3{1.0, 0.5, 3.0}), 3, "AxisAlignedCubeGeometry");
+  checkMapQuadrature(Dune::AxisAlignedCubeGeometry<double, 2, 3>(Vector3{-1.0, 0.0, 2.0}, Vector3{1.0, 0.0, 3.0}, std::bitset<3>("101")), 3,
+                     "AxisAlignedCubeGeometry surface");
+  const Dune::MultiLinearGeometry<double, 2, 2> square(Dune::GeometryTypes::quadrilateral, std::vector<Vector2>{ {0.0, 0.0}, {1.0, 0.0}, {0.0, 1.0}, {1.0, 1.0} });
+  checkMapQuadrature(Dune::MappedGeometry{BendMapping{}, square}, 5, "MappedGeometry");
+  const Dune::MultiLinearGeometry<double, 2, 2> bilinear(Dune::GeometryTypes::quadrilateral, quadrilateral);
+  checkMapQuadrature(Dune::MappedGeometry{BendMapping{}, bilinear}, 5, "MappedGeometry of a bilinear geometry");
+
+  const std::vector<Vector3> prism = { {0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0},
+                                       {0.1, 0.0, 1.0}, {1.3, 0.2, 1.1}, {0.0, 1.2, 0.9} };
+  const std::vector<Vector3> pyramid = { {0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {1.4, 1.2, 0.3}, {0.2, 0.3, 1.0} };
+  const std::vector<Vector3> hexahedron = { {0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {1.1, 0.9, 0.2},
+                                            {0.1, 0.0, 1.0}, {1.0, 0.2, 1.3}, {0.0, 1.0, 0.9}, {1.2, 1.1, 1.1} };
+  checkMapQuadrature(Dune::MultiLinearGeometry<double, 3, 3>(Dune::GeometryTypes::prism, prism), 4, "MultiLinearGeometry prism");
+  checkMapQuadrature(Dune::MultiLinearGeometry<double, 3, 3>(Dune::GeometryTypes::pyramid, pyramid), 4, "MultiLinearGeometry pyramid");
+  checkMapQuadrature(Dune::CachedMultiLinearGeometry<double, 3, 3>(Dune::GeometryTypes::hexahedron, hexahedron), 4, "CachedMultiLinearGeometry hexahedron");
+
+  typedef Dune::Impl::Q1LocalFiniteElement<double, double, 2> Q1;
+  checkMapQuadrature(Dune::LocalFiniteElementGeometry<Q1, 3>(Dune::GeometryTypes::quadrilateral, Q1{}, surface), 5, "LocalFiniteElementGeometry");
+}
+
+template<int dim, class F>
+void checkCutCellIntegral(const Dune::QuadratureRule<double, dim>& quad, F&& f, double exact, double tolerance, const std::string& name)
+{
+  double integral = 0;
+  for (const auto& qp : quad)
+    integral += f(qp.position()) * qp.weight();
+  if (std::abs(integral - exact) > tolerance)
+  {
+    std::cerr << "Error: Cut-cell rule " << name << " integrates to " << integral << " instead of " << exact
+              << ", the error is " << std::abs(integral - exact) << std::endl;
+    success = false;
+  }
+}
+
+// the level sets given by vertex values are integrated exactly, general level sets with an error decreasing exponentially in the order
+void checkCutCellRules()
+{
+  typedef Dune::CutCellQuadratureRule<double, 2> Rule2;
+  typedef Dune::CutCellQuadratureRule<double, 3> Rule3;
+  const double tolerance = 1e-14;
+  const double pi = Dune::StandardMathematicalConstants<double>::pi();
+
+  // the triangle scaled by 0.5 and its complement, monomials x^a y^b integrate to a!b!/(a+b+2)! on the triangle
+  const Rule2 corner(Dune::GeometryTypes::triangle, std::vector<double>{-0.5, 0.5, 0.5}, 4);
+  const Rule2 complement(Dune::GeometryTypes::triangle, std::vector<double>{0.5, -0.5, -0.5}, 4);
+  for (int a = 0; a <= 4; ++a)
+    for (int b = 0; a + b <= 4; ++b)
+    {
+      auto monomial = [a, b](const auto& x) { return std::pow(x[0], a) * std::pow(x[1], b); };
+      const double exact = Dune::factorial(a) * Dune::factorial(b) / double(Dune::factorial(a + b + 2));
+      checkCutCellIntegral(corner, monomial, std::pow(0.5, a + b + 2) * exact, tolerance, "triangle corner");
+      checkCutCellIntegral(complement, monomial, (1 - std::pow(0.5, a + b + 2)) * exact, tolerance, "triangle complement");
+    }
+
+  // the decomposition only depends on the signs
+  const auto& decomposition = Rule2::decomposition(Dune::GeometryTypes::triangle, {0.5, -0.5, -0.5});
+  if (&decomposition != &Rule2::decomposition(Dune::GeometryTypes::triangle, {2.0, -0.1, -3.0}) || decomposition.size() != 2)
+  {
+    std::cerr << "Error: Decomposition of a cut triangle is not cached by its sign pattern" << std::endl;
+    success = false;
+  }
+
+  auto x0 = [](const auto& x) { return x[0]; };
+  auto one = [](const auto&) { return 1.0; };
+  checkCutCellIntegral(Rule3(Dune::GeometryTypes::tetrahedron, std::vector<double>{-0.6, 0.4, 0.4, 0.4}, 1), x0,
+                       std::pow(0.6, 4) / 24, tolerance, "tetrahedron corner");
+  checkCutCellIntegral(Rule3(Dune::GeometryTypes::tetrahedron, std::vector<double>{0.6, -0.4, -0.4, -0.4}, 1), x0,
+                       (1 - std::pow(0.6, 4)) / 24, tolerance, "tetrahedron complement");
+
+  // x+y+z < 1.2 in the unit cube
+  std::vector<double> hexahedronValues(8);
+  for (int i = 0; i < 8; ++i)
+    hexahedronValues[i] = (i & 1) + ((i >> 1) & 1) + ((i >> 2) & 1) - 1.2;
+  checkCutCellIntegral(Rule3(Dune::GeometryTypes::hexahedron, hexahedronValues, 2), one,
+                       (std::pow(1.2, 3) - 3 * std::pow(0.2, 3)) / 6, tolerance, "hexahedron");
+
+  // uncut elements
+  const Rule2 full(Dune::GeometryTypes::quadrilateral, std::vector<double>{-1.0, -2.0, 0.0, -1.0}, 5);
+  const Rule2 empty(Dune::GeometryTypes::quadrilateral, std::vector<double>{1.0, 2.0, 0.0, 1.0}, 5);
+  if (full.size() != Dune::QuadratureRules<double, 2>::rule(Dune::GeometryTypes::quadrilateral, 5).size() || !empty.empty())
+  {
+    std::cerr << "Error: Cut-cell rules of uncut elements differ from the standard rules" << std::endl;
+    success = false;
+  }
+
+  // interfaces that are graphs, and interfaces that need bisection of the cube
+  auto arc = [](const auto& x) { return (x[0] - 0.5) * (x[0] - 0.5) + (x[1] + 0.5) * (x[1] + 0.5) - 1; };
+  checkCutCellIntegral(Rule2(Dune::GeometryTypes::quadrilateral, arc, 15), one,
+                       0.5 * std::sqrt(0.75) + std::asin(0.5) - 0.5, 1e-10, "arc");
+  auto disc = [](const auto& x) { return (x[0] - 0.5) * (x[0] - 0.5) + (x[1] - 0.5) * (x[1] - 0.5) - 0.16; };
+  checkCutCellIntegral(Rule2(Dune::GeometryTypes::quadrilateral, disc, 10), one, pi * 0.16, 1e-8, "disc");
+  auto quarterDisc = [](const auto& x) { return x[0] * x[0] + x[1] * x[1] - 0.25; };
+  checkCutCellIntegral(Rule2(Dune::GeometryTypes::triangle, quarterDisc, 12), one, pi / 16, 1e-8, "quarter disc");
+  auto ball = [](const auto& x) { return (x - Dune::FieldVector<double, 3>(0.5)).two_norm2() - 0.16; };
+  // the faces of the sub-cubes need bisection as well
+  checkCutCellIntegral(Rule3(Dune::GeometryTypes::hexahedron, ball, 6), one, 4 * pi * 0.064 / 3, 1e-7, "ball");
+}
+
+// the rules singular at any sub-entity of the codimension integrate polynomials exactly
+template<int dim>
+void checkSingularRules(Dune::GeometryType type, int codim, unsigned int p)
+{
+  const auto& regular = Dune::QuadratureRules<double, dim>::rule(type, p);
+  auto exact = [&](const std::array<unsigned int, dim>& alpha) {
+    double integral = 0;
+    for (const auto& qp : regular)
+    {
+      double value = qp.weight();
+      for (int i = 0; i < dim; ++i)
+        value *= Dune::power(qp.position()[i], int(alpha[i]));
+      integral += value;
+    }
+    return integral;
+  };
+
+  const auto refElement = Dune::referenceElement<double, dim>(type);
+  for (int i = 0; i < refElement.size(codim); ++i)
+  {
+    const auto& quad = Dune::SingularQuadratureRule<double, dim>::rule(type, codim, i, p);
+    checkMonomials(quad, p, exact);
+    checkInterior(quad, p);
+    if (&quad != &Dune::SingularQuadratureRule<double, dim>::rule(type, codim, i, p) || quad.subEntity() != i)
+    {
+      std::cerr << "Error: Cached singular quadrature for " << type << " and sub-entity " << i
+                << " of codim " << codim << " is not unique" << std::endl;
+      success = false;
+    }
+  }
+}
+
+template<int dim, class F>
+void checkSingularIntegral(Dune::GeometryType type, int codim, int subEntity, unsigned int p, F&& f, double exact, double tolerance)
+{
+  const auto& quad = Dune::SingularQuadratureRule<double, dim>::rule(type, codim, subEntity, p);
+  double integral = 0;
+  for (const auto& qp : quad)
+    integral += f(qp.position()) * qp.weight();
+  if (std::abs(integral - exact) > tolerance)
+  {
+    std::cerr << "Error: Rule for " << type << " singular at sub-entity " << subEntity << " of codim " << codim
+              << " integrates to " << integral << " instead of " << exact << std::endl;
+    success = false;
+  }
+}
+
+// 1/r singularities at vertices and edges are integrated to high accuracy
+void checkSingularIntegrals()
+{
+  const double pi = Dune::StandardMathematicalConstants<double>::pi();
+  const double log1PlusSqrt2 = std::log(1 + std::sqrt(2.0));
+  auto inverseDistance = [](const auto& x) { return 1 / x.two_norm(); };
+
+  checkSingularIntegral<2>(Dune::GeometryTypes::triangle, 2, 0, 20, inverseDistance, std::sqrt(2.0) * log1PlusSqrt2, 1e-8);
+  checkSingularIntegral<2>(Dune::GeometryTypes::quadrilateral, 2, 0, 16, inverseDistance, 2 * log1PlusSqrt2, 1e-12);
+  checkSingularIntegral<3>(Dune::GeometryTypes::hexahedron, 3, 0, 16, inverseDistance,
+                           1.5 * std::log((std::sqrt(3.0) + 1) / (std::sqrt(3.0) - 1)) - pi / 4, 1e-12);
+
+  // 1/r to the edge from vertex 0 to vertex 1 of the hexahedron, on the x-axis
+  const auto hexahedron = Dune::referenceElement<double, 3>(Dune::GeometryTypes::hexahedron);
+  for (int e = 0; e < hexahedron.size(2); ++e)
+    if (hexahedron.subEntity(e, 2, 0, 3) == 0 && hexahedron.subEntity(e, 2, 1, 3) == 1)
+      checkSingularIntegral<3>(Dune::GeometryTypes::hexahedron, 2, e, 16,
+                               [](const auto& x) { return 1 / std::hypot(x[1], x[2]); }, 2 * log1PlusSqrt2, 1e-12);
+
+  // 1/r^2 at vertex 0 of the tetrahedron, compared to a rule of higher order
+  auto inverseDistance2 = [](const auto& x) { return 1 / x.two_norm2(); };
+  double reference = 0;
+  for (const auto& qp : Dune::SingularQuadratureRule<double, 3>::rule(Dune::GeometryTypes::tetrahedron, 3, 0, 30))
+    reference += inverseDistance2(qp.position()) * qp.weight();
+  checkSingularIntegral<3>(Dune::GeometryTypes::tetrahedron, 3, 0, 16, inverseDistance2, reference, 1e-6);
+}
+
+// the sparse-grid rule of every level integrates all monomials of the degree it guarantees,
+// in 4 and more dimensions with fewer points than the Gauss tensor product rule
+template<class ctype, int dim>
+void checkSparseGridRules(Dune::QuadratureType::Enum qt, int maxLevel)
+{
+  typedef Dune::SparseGridQuadratureRule<ctype, dim> SparseGrid;
+  const Dune::GeometryType cube = Dune::GeometryTypes::cube(dim);
+  for (int level = 0; level <= maxLevel; ++level)
+  {
+    const int p = SparseGrid::exactness(level, qt);
+    const auto& quad = Dune::QuadratureRules<ctype, dim>::rule(cube, p, qt);
+    if (quad.order() != p || SparseGrid(cube, p, qt).level() != level || p < 2*level + 1)
+    {
+      std::cerr << "Error: Sparse-grid rule of level " << level << " for " << cube << " has order "
+                << quad.order() << " instead of " << p << std::endl;
+      success = false;
+    }
+    // the constant monomial checks the sum of the weights, checkWeights() would
+    // create the reference elements of all geometry types of the dimension
+    checkMonomials(quad, p, [](const std::array<unsigned int, dim>& alpha) {
+      ctype exact = 1;
+      for (int i=0; i<dim; ++i)
+        exact /= alpha[i] + 1;
+      return exact;
+    });
+
+    const std::size_t gaussSize = Dune::power(p/2 + 1, dim);
+    if (dim >= 4 && p >= 3 && quad.size() >= gaussSize)
+    {
+      std::cerr << "Error: Sparse-grid rule of order " << p << " for " << cube << " has " << quad.size()
+                << " points, the Gauss tensor product rule has " << gaussSize << std::endl;
+      success = false;
+    }
+  }
+}
+
+template<class ctype, int dim>
+void checkPreload(Dune::GeometryType type,
+                  Dune::QuadratureType::Enum qt)
+{
+  typedef Dune::QuadratureRules<ctype, dim> Rules;
+  const int lastOrder = Rules::maxOrder(type, qt);
+
+  // build the rules on two threads, asking for more orders than available
+  const auto stats = Rules::preload({type}, {0, lastOrder + 5}, {qt}, Dune::QuadraturePreloadExecutor(2));
+  std::size_t points = 0;
+  for (int p=0; p<=lastOrder; ++p)
+    points += Rules::rule(type, p, qt).size();
+  if (stats.rules != std::size_t(lastOrder+1) || stats.points != points || stats.memory < points*sizeof(ctype) || stats.time < 0)
+  {
+    std::cerr << "Error: Preloading the quadratures for " << type << " reports " << stats.rules
+              << " rules with " << stats.points << " points" << std::endl;
+    success = false;
+  }
+
+  // rules that are cached already are not built again
+  std::size_t numTasks = 0;
+  const auto serial = [&](std::size_t n, const auto& task) {
+    numTasks += n;
+    for (std::size_t i=0; i<n; ++i)
+      task(i);
+  };
+  if (Rules::preload({type}, {0, lastOrder}, {qt}, serial).rules != 0 || numTasks != 0)
+  {
+    std::cerr << "Error: Preloading cached quadratures for " << type << " builds them again" << std::endl;
+    success = false;
+  }
+}
+
+// the number of points computed without creating the rule equals the size of the rule
+template<class ctype, int dim>
+void checkSize(Dune::GeometryType type, unsigned int maxOrder,
+               Dune::QuadratureType::Enum qt = Dune::QuadratureType::GaussLegendre)
+{
+  typedef Dune::QuadratureRules<ctype, dim> Rules;
+  maxOrder = std::min(maxOrder, Rules::maxOrder(type, qt));
+  for (unsigned int p=0; p<=maxOrder; ++p)
+  {
+    const std::size_t size = Rules::size(type, p, qt);
+    if (size != Rules::rule(type, p, qt).size())
+    {
+      std::cerr << "Error: Quadrature for " << type << " and order=" << p << " of type " << qt
+                << " has " << Rules::rule(type, p, qt).size() << " points, not " << size << std::endl;
+      success = false;
+    }
+  }
+}
+
+// the cheapest rule meets the constraints and has no more points than any other admissible rule
+template<class ctype, int dim>
+void checkCheapest(Dune::GeometryType type, int order, const Dune::QuadratureConstraints& constraints)
+{
+  using std::abs;
+  typedef Dune::QuadratureRules<ctype, dim> Rules;
+  const auto& quad = Rules::cheapest(type, order, constraints);
+  if (quad.order() < order || &quad != &Rules::cheapest(type, order, constraints))
+  {
+    std::cerr << "Error: Cheapest rule of order " << order << " for " << type << " has order " << quad.order()
+              << " or is not cached" << std::endl;
+    success = false;
+  }
+
+  const auto refElement = Dune::ReferenceElements<ctype, dim>::general(type);
+  int numCorners = 0;
+  for (const auto& qp : quad)
+  {
+    if (constraints.positiveWeights && qp.weight() <= 0)
+    {
+      std::cerr << "Error: Cheapest rule for " << type << " has a non-positive weight" << std::endl;
+      success = false;
+    }
+    bool onBoundary = false;
+    for (int f = 0; f < refElement.size(1); ++f)
+      onBoundary = onBoundary || abs(refElement.integrationOuterNormal(f) * (qp.position() - refElement.position(f, 1))) < 10 * eps<ctype>();
+    if (constraints.interiorPoints && onBoundary)
+    {
+      std::cerr << "Error: Cheapest rule for " << type << " has a point on the boundary" << std::endl;
+      success = false;
+    }
+    for (int c = 0; c < refElement.size(dim); ++c)
+      if ((qp.position() - refElement.position(c, dim)).infinity_norm() < 10 * eps<ctype>())
+        ++numCorners;
+  }
+  if (constraints.includeVertices && numCorners != refElement.size(dim))
+  {
+    std::cerr << "Error: Cheapest rule for " << type << " misses a corner" << std::endl;
+    success = false;
+  }
+
+  for (auto qt : { Dune::QuadratureType::GaussLegendre, Dune::QuadratureType::GaussLobatto,
+                   Dune::QuadratureType::GaussRadauLeft, Dune::QuadratureType::ClenshawCurtis,
+                   Dune::QuadratureType::SmolyakClenshawCurtis, Dune::QuadratureType::FullySymmetric })
+  {
+    const bool totalDegreeOnly = (qt == Dune::QuadratureType::SmolyakClenshawCurtis || qt == Dune::QuadratureType::FullySymmetric);
+    if (totalDegreeOnly && !constraints.totalDegree && !type.isSimplex())
+      continue;
+    if (!constraints.positiveWeights && !constraints.interiorPoints && !constraints.includeVertices
+        && Rules::rule(type, order, qt).size() < quad.size())
+    {
+      std::cerr << "Error: Rule of type " << qt << " for " << type << " is cheaper than the cheapest rule" << std::endl;
+      success = false;
+    }
+  }
+}
+
 int main (int argc, char** argv)
 {
   unsigned int maxOrder = 45;
@@ -253,6 +1531,23 @@ int main (int argc, char** argv)
     std::cout << "maxOrder = " << maxOrder << std::endl;
   }
   try {
+    // before the rules are cached by the other checks
+    for (auto qt : { Dune::QuadratureType::GaussLegendre, Dune::QuadratureType::GaussJacobi_1_0,
+                     Dune::QuadratureType::GaussLobatto, Dune::QuadratureType::GaussRadauRight,
+                     Dune::QuadratureType::GaussKronrod, Dune::QuadratureType::GaussPatterson,
+                     Dune::QuadratureType::ClenshawCurtis })
+      checkSize<double,1>(Dune::GeometryTypes::line, 140, qt);
+    checkSize<double,1>(Dune::GeometryTypes::line, 60, Dune::QuadratureType::GaussJacobi_n_0);
+    checkSize<double,2>(Dune::GeometryTypes::triangle, maxOrder);
+    checkSize<double,2>(Dune::GeometryTypes::quadrilateral, maxOrder, Dune::QuadratureType::FullySymmetric);
+    checkSize<double,3>(Dune::GeometryTypes::tetrahedron, 12, Dune::QuadratureType::GaussJacobi_n_0);
+    checkSize<double,3>(Dune::GeometryTypes::prism, 12);
+    checkSize<double,3>(Dune::GeometryTypes::prism, 12, Dune::QuadratureType::FullySymmetric);
+    checkSize<double,3>(Dune::GeometryTypes::pyramid, 12, Dune::QuadratureType::GaussLobatto);
+    checkSize<double,3>(Dune::GeometryTypes::hexahedron, 12, Dune::QuadratureType::SmolyakClenshawCurtis);
+    checkSize<double,4>(Dune::GeometryTypes::cube(4), 8, Dune::QuadratureType::ClenshawCurtis);
+    checkSize<double,4>(Dune::GeometryTypes::cube(4), 15, Dune::QuadratureType::SmolyakGaussPatterson);
+
     check<double,4>(Dune::GeometryTypes::cube(4), maxOrder);
     check<double,4>(Dune::GeometryTypes::cube(4), std::min(maxOrder, 31u),
                     Dune::QuadratureType::GaussLobatto);
@@ -270,10 +1565,186 @@ int main (int argc, char** argv)
 
     check<double,3>(Dune::GeometryTypes::prism, maxOrder);
     check<double,3>(Dune::GeometryTypes::pyramid, maxOrder);
+    check<double,2>(Dune::GeometryTypes::quadrilateral, maxOrder, Dune::QuadratureType::FullySymmetric);
+    check<double,3>(Dune::GeometryTypes::hexahedron, maxOrder, Dune::QuadratureType::FullySymmetric);
+
+    checkSimplexRules<double,2>(13, maxOrder);
+    checkSimplexRules<double,3>(6, maxOrder);
+    checkCubeRules<double,2>(maxOrder);
+    checkCubeRules<double,3>(maxOrder);
+    checkPrismRules<double>(maxOrder);
+    checkPyramidRules<double>(maxOrder);
 
     unsigned int maxRefinement = 4;
 
     checkCompositeRule<double,2>(Dune::GeometryTypes::triangle, maxOrder, maxRefinement);
+    checkCompositeRule<double,2>(Dune::GeometryTypes::quadrilateral, std::min(maxOrder, 20u), maxRefinement);
+    checkCompositeRule<double,3>(Dune::GeometryTypes::tetrahedron, std::min(maxOrder, 8u), 2);
+    checkCompositeRule<double,3>(Dune::GeometryTypes::hexahedron, std::min(maxOrder, 8u), 1);
+    // the volumes of the simplices of a refined prism are not representable, keep the rounding errors small
+    checkCompositeRule<double,3>(Dune::GeometryTypes::prism, std::min(maxOrder, 8u), 0);
+    checkCompositeRule<double,3>(Dune::GeometryTypes::pyramid, std::min(maxOrder, 8u), 2);
+    checkCompositeRule<double,3>(Dune::GeometryTypes::prism, std::min(maxOrder, 6u), 0, Dune::QuadratureType::GaussLobatto);
+
+    for (auto qt : { Dune::QuadratureType::GaussLegendre, Dune::QuadratureType::GaussLobatto,
+                     Dune::QuadratureType::GaussRadauLeft, Dune::QuadratureType::GaussRadauRight })
+    {
+      for (unsigned int p : { 0u, 1u, 2u, 5u, 30u, 31u, 32u, 61u, 62u, 63u, 100u, 501u, 1000u, 2047u })
+        checkHighOrderRule<double>(p, qt);
+
+      // the products keep the orders of the tabulated rules
+      const unsigned int lineOrder = qt == Dune::QuadratureType::GaussLegendre ? 61 : qt == Dune::QuadratureType::GaussLobatto ? 31 : 30;
+      if (Dune::QuadratureRules<double,2>::maxOrder(Dune::GeometryTypes::quadrilateral, qt) != lineOrder
+          || Dune::QuadratureRules<double,3>::maxOrder(Dune::GeometryTypes::hexahedron, qt) != lineOrder
+          || Dune::QuadratureRules<double,3>::maxOrder(Dune::GeometryTypes::prism, qt) > lineOrder
+          || Dune::QuadratureRules<double,3>::maxOrder(Dune::GeometryTypes::pyramid, qt) > lineOrder)
+      {
+        std::cerr << "Error: Products of the quadratures of type " << qt << " exceed order " << lineOrder << std::endl;
+        success = false;
+      }
+    }
+
+    check<double,1>(Dune::GeometryTypes::line, std::min(maxOrder, 191u), Dune::QuadratureType::GaussKronrod);
+    check<double,1>(Dune::GeometryTypes::line, std::min(maxOrder, 47u), Dune::QuadratureType::GaussPatterson);
+    check<double,1>(Dune::GeometryTypes::line, std::min(maxOrder, 129u), Dune::QuadratureType::ClenshawCurtis);
+    check<double,3>(Dune::GeometryTypes::prism, std::min(maxOrder, 20u), Dune::QuadratureType::GaussKronrod);
+    checkEmbeddedRules<double,1>(Dune::GeometryTypes::line, std::min(maxOrder, 191u), Dune::QuadratureType::GaussKronrod);
+    checkEmbeddedRules<double,1>(Dune::GeometryTypes::line, std::min(maxOrder, 47u), Dune::QuadratureType::GaussPatterson);
+    checkEmbeddedRules<double,1>(Dune::GeometryTypes::line, std::min(maxOrder, 129u), Dune::QuadratureType::ClenshawCurtis);
+    checkEmbeddedRules<double,2>(Dune::GeometryTypes::triangle, std::min(maxOrder, 20u), Dune::QuadratureType::GaussKronrod);
+    checkEmbeddedRules<double,2>(Dune::GeometryTypes::quadrilateral, std::min(maxOrder, 20u), Dune::QuadratureType::ClenshawCurtis);
+    checkEmbeddedRules<double,3>(Dune::GeometryTypes::pyramid, std::min(maxOrder, 12u), Dune::QuadratureType::GaussPatterson);
+
+    checkAdaptiveQuadrature<1>(Dune::GeometryTypes::line, Dune::QuadratureType::GaussKronrod, 23, 1e-12);
+    checkAdaptiveQuadrature<1>(Dune::GeometryTypes::line, Dune::QuadratureType::GaussPatterson, 23, 1e-12);
+    checkAdaptiveQuadrature<1>(Dune::GeometryTypes::line, Dune::QuadratureType::ClenshawCurtis, 17, 1e-12);
+    checkAdaptiveQuadrature<2>(Dune::GeometryTypes::triangle, Dune::QuadratureType::GaussKronrod, 11, 1e-10);
+    checkAdaptiveQuadrature<2>(Dune::GeometryTypes::quadrilateral, Dune::QuadratureType::GaussPatterson, 11, 1e-10);
+    checkAdaptiveQuadrature<3>(Dune::GeometryTypes::tetrahedron, Dune::QuadratureType::GaussKronrod, 7, 1e-8);
+    checkAdaptiveQuadrature<3>(Dune::GeometryTypes::hexahedron, Dune::QuadratureType::GaussKronrod, 7, 1e-8);
+    checkAdaptiveQuadrature<3>(Dune::GeometryTypes::prism, Dune::QuadratureType::ClenshawCurtis, 9, 1e-8);
+    checkAdaptiveQuadrature<3>(Dune::GeometryTypes::pyramid, Dune::QuadratureType::GaussKronrod, 7, 1e-8);
+    checkAdaptiveVolume();
+
+    checkSubEntityRules<1>(Dune::GeometryTypes::line, 3);
+    checkSubEntityRules<2>(Dune::GeometryTypes::triangle, 5);
+    checkSubEntityRules<2>(Dune::GeometryTypes::quadrilateral, 6);
+    checkSubEntityRules<3>(Dune::GeometryTypes::tetrahedron, 4);
+    checkSubEntityRules<3>(Dune::GeometryTypes::hexahedron, 7);
+    checkSubEntityRules<3>(Dune::GeometryTypes::prism, 3);
+    checkSubEntityRules<3>(Dune::GeometryTypes::pyramid, 8);
+
+    checkPermutedRules<1>(Dune::GeometryTypes::line, 7, 2);
+    for (int order : {2, 5, 12, 20})
+    {
+      checkPermutedRules<2>(Dune::GeometryTypes::triangle, order, 6);
+      checkPermutedRules<2>(Dune::GeometryTypes::quadrilateral, order, 8);
+    }
+
+    checkTensorProductFactors<double, 2>(Dune::GeometryTypes::triangle, 17, Dune::QuadratureType::GaussLegendre);
+    checkTensorProductFactors<double, 3>(Dune::GeometryTypes::prism, 12, Dune::QuadratureType::GaussLegendre);
+    checkTensorProductFactors<double, 3>(Dune::GeometryTypes::pyramid, 9, Dune::QuadratureType::GaussJacobi_n_0);
+    checkTensorProductFactors<double, 3>(Dune::GeometryTypes::hexahedron, 61, Dune::QuadratureType::GaussLegendre);
+    // the factors are not restricted to the orders of the stored products
+    checkWeights(Dune::TensorProductQuadratureFactors<double, 3>(Dune::GeometryTypes::hexahedron, 201, Dune::QuadratureType::GaussLegendre));
+    checkTensorProductFactorsMatch<double, 3>(Dune::GeometryTypes::hexahedron, 7, Dune::QuadratureType::GaussLobatto);
+    checkTensorProductFactorsMatch<double, 3>(Dune::GeometryTypes::tetrahedron, 10, Dune::QuadratureType::GaussRadauLeft);
+    checkTensorProductFactorsMatch<double, 3>(Dune::GeometryTypes::pyramid, 5, Dune::QuadratureType::GaussJacobi_n_0);
+    // the symmetric rules of triangles are no products
+    if (Dune::QuadratureRules<double, 2>::factors(Dune::GeometryTypes::triangle, 12) != nullptr)
+    {
+      std::cerr << "Error: Symmetric triangle rule reports TensorProductQuadratureFactors" << std::endl;
+      success = false;
+    }
+
+    checkGaussLobattoCollocation<1, 1>(5, { {0.5}, {2.0} });
+    checkGaussLobattoCollocation<2, 2>(9, { {0.0, 0.0}, {2.0, 0.0}, {0.0, 1.0}, {3.0, 3.0} });
+    checkGaussLobattoCollocation<2, 3>(3, { {0.0, 0.0, 0.0}, {1.0, 0.0, 0.5}, {0.0, 1.0, 0.0}, {1.0, 1.0, 2.0} });
+    checkGaussLobattoCollocation<3, 3>(7, { {0.0, 0.0, 0.0}, {1.0, 0.0, 0.1}, {0.0, 1.2, 0.0}, {1.1, 0.9, 0.2},
+                                            {0.1, 0.0, 1.0}, {1.0, 0.2, 1.3}, {0.0, 1.0, 0.9}, {1.2, 1.1, 1.1} });
+    checkGaussLobattoCollocation<3, 3>(100, { {0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {1.0, 1.0, 0.0},
+                                              {0.0, 0.0, 1.0}, {1.0, 0.0, 1.0}, {0.0, 1.0, 1.0}, {2.0, 2.0, 2.0} });
+
+    checkStaticRuleAccess<double,2,Dune::GeometryTypes::triangle>(maxOrder);
+    checkStaticRuleAccess<double,3,Dune::GeometryTypes::hexahedron>(maxOrder);
+    checkStaticRuleAccess<double,3,Dune::GeometryTypes::prism>(maxOrder, Dune::QuadratureType::GaussLobatto);
+
+    // the static rules are evaluated at compile time
+    static_assert(Dune::StaticQuadratureRule<double, Dune::GeometryTypes::triangle, 4>::size() == 6);
+    static_assert(Dune::StaticQuadratureRule<double, Dune::GeometryTypes::line, 3>::weight(0) == 0.5);
+    // the cache takes the created rules over without copying their points
+    static_assert(std::is_nothrow_move_constructible_v<Dune::QuadratureRule<double,3>>);
+    checkStaticRules<double, Dune::GeometryTypes::vertex>(std::make_integer_sequence<int, 2>{});
+    checkStaticRules<double, Dune::GeometryTypes::line>(std::make_integer_sequence<int, 12>{});
+    checkStaticRules<double, Dune::GeometryTypes::line, Dune::QuadratureType::GaussLobatto>(std::make_integer_sequence<int, 12>{});
+    checkStaticRules<double, Dune::GeometryTypes::line, Dune::QuadratureType::GaussJacobi_2_0>(std::make_integer_sequence<int, 6>{});
+    checkStaticRules<double, Dune::GeometryTypes::triangle>(std::make_integer_sequence<int, 16>{});
+    checkStaticRules<double, Dune::GeometryTypes::quadrilateral, Dune::QuadratureType::GaussRadauLeft>(std::make_integer_sequence<int, 6>{});
+    checkStaticRules<double, Dune::GeometryTypes::quadrilateral, Dune::QuadratureType::FullySymmetric>(std::make_integer_sequence<int, 12>{});
+    checkStaticRules<double, Dune::GeometryTypes::hexahedron, Dune::QuadratureType::FullySymmetric>(std::make_integer_sequence<int, 10>{});
+    checkStaticRules<double, Dune::GeometryTypes::tetrahedron>(std::make_integer_sequence<int, 10>{});
+    checkStaticRules<double, Dune::GeometryTypes::tetrahedron, Dune::QuadratureType::GaussJacobi_n_0>(std::make_integer_sequence<int, 10>{});
+    checkStaticRules<double, Dune::GeometryTypes::pyramid>(std::make_integer_sequence<int, 6>{});
+    checkStaticRules<double, Dune::GeometryTypes::prism>(std::make_integer_sequence<int, 6>{});
+    checkStaticRules<double, Dune::GeometryTypes::prism, Dune::QuadratureType::FullySymmetric>(std::make_integer_sequence<int, 10>{});
+    checkStaticRules<double, Dune::GeometryTypes::hexahedron, Dune::QuadratureType::GaussLobatto>(std::make_integer_sequence<int, 6>{});
+
+    Dune::QuadratureConstraints positive, interior, vertices;
+    positive.positiveWeights = true;
+    interior.interiorPoints = true;
+    interior.positiveWeights = true;
+    vertices.includeVertices = true;
+    Dune::QuadratureConstraints totalDegree;
+    totalDegree.totalDegree = true;
+    for (int order : {0, 3, 8})
+    {
+      checkCheapest<double,2>(Dune::GeometryTypes::quadrilateral, order, totalDegree);
+      checkCheapest<double,1>(Dune::GeometryTypes::line, order, {});
+      checkCheapest<double,1>(Dune::GeometryTypes::line, order, vertices);
+      checkCheapest<double,2>(Dune::GeometryTypes::triangle, order, positive);
+      checkCheapest<double,2>(Dune::GeometryTypes::quadrilateral, order, vertices);
+      checkCheapest<double,3>(Dune::GeometryTypes::tetrahedron, order, interior);
+      checkCheapest<double,3>(Dune::GeometryTypes::hexahedron, order, {});
+      checkCheapest<double,3>(Dune::GeometryTypes::prism, order, interior);
+    }
+    // the Gauss-Lobatto rule with two points is the cheapest rule containing the end points
+    if (Dune::QuadratureRules<double,1>::cheapest(Dune::GeometryTypes::line, 1, vertices).size() != 2)
+    {
+      std::cerr << "Error: Cheapest rule containing the end points of a line is not the trapezoidal rule" << std::endl;
+      success = false;
+    }
+
+    checkPreload<double,3>(Dune::GeometryTypes::pyramid, Dune::QuadratureType::GaussRadauRight);
+
+    checkArrays<double,1>(Dune::GeometryTypes::line, maxOrder);
+    checkArrays<double,2>(Dune::GeometryTypes::triangle, maxOrder);
+    checkArrays<double,3>(Dune::GeometryTypes::pyramid, maxOrder);
+    checkRuleIds();
+    checkRuleTabulationCache();
+    checkMapQuadratures();
+    checkCutCellRules();
+
+    checkSingularRules<1>(Dune::GeometryTypes::line, 1, 7);
+    checkSingularRules<2>(Dune::GeometryTypes::triangle, 2, 6);
+    checkSingularRules<2>(Dune::GeometryTypes::quadrilateral, 2, 6);
+    checkSingularRules<3>(Dune::GeometryTypes::tetrahedron, 3, 5);
+    checkSingularRules<3>(Dune::GeometryTypes::tetrahedron, 2, 5);
+    checkSingularRules<3>(Dune::GeometryTypes::hexahedron, 3, 4);
+    checkSingularRules<3>(Dune::GeometryTypes::hexahedron, 2, 4);
+    checkSingularRules<3>(Dune::GeometryTypes::prism, 3, 4);
+    checkSingularRules<3>(Dune::GeometryTypes::pyramid, 3, 4);
+    checkSingularIntegrals();
+
+    check<double,4>(Dune::GeometryTypes::cube(4), std::min(maxOrder, 9u), Dune::QuadratureType::SmolyakClenshawCurtis);
+    check<double,4>(Dune::GeometryTypes::cube(4), std::min(maxOrder, 11u), Dune::QuadratureType::SmolyakGaussPatterson);
+    check<double,3>(Dune::GeometryTypes::prism, std::min(maxOrder, 9u), Dune::QuadratureType::SmolyakClenshawCurtis);
+    checkSparseGridRules<double,2>(Dune::QuadratureType::SmolyakClenshawCurtis, 5);
+    checkSparseGridRules<double,4>(Dune::QuadratureType::SmolyakClenshawCurtis, 4);
+    checkSparseGridRules<double,6>(Dune::QuadratureType::SmolyakClenshawCurtis, 3);
+    checkSparseGridRules<double,10>(Dune::QuadratureType::SmolyakClenshawCurtis, 2);
+    checkSparseGridRules<double,2>(Dune::QuadratureType::SmolyakGaussPatterson, 4);
+    checkSparseGridRules<double,4>(Dune::QuadratureType::SmolyakGaussPatterson, 3);
+    checkSparseGridRules<double,6>(Dune::QuadratureType::SmolyakGaussPatterson, 2);
 
 #if HAVE_QUADMATH
     check<Dune::Float128,4>(Dune::GeometryTypes::cube(4), maxOrder);
@@ -283,6 +1754,10 @@ int main (int argc, char** argv)
                     Dune::QuadratureType::GaussRadauLeft);
     check<Dune::Float128,4>(Dune::GeometryTypes::cube(4), std::min(maxOrder, 30u),
                     Dune::QuadratureType::GaussRadauRight);
+    for (auto qt : { Dune::QuadratureType::GaussLegendre, Dune::QuadratureType::GaussLobatto,
+                     Dune::QuadratureType::GaussRadauLeft, Dune::QuadratureType::GaussRadauRight })
+      for (unsigned int p : { 62u, 201u })
+        checkHighOrderRule<Dune::Float128>(p, qt);
 #else
     std::cout << "Skip Float128 tests as Quadmath is not supported" << std::endl;
 #endif
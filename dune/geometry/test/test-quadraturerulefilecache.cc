@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/quadraturerules/quadraturerulefilecache.hh>
+
+bool success = true;
+
+const char* filename = "test-quadraturerulefilecache.dat";
+
+template<class ctype, int dim>
+Dune::QuadratureRuleFileCache::Key key(Dune::GeometryType type, int order, Dune::QuadratureType::Enum qt)
+{
+  return { sizeof(ctype), std::numeric_limits<ctype>::digits, dim, type.id() & ~1u, order, static_cast<std::int32_t>(qt) };
+}
+
+// rules created by QuadratureRules are appended to the file and can be read by other processes
+template<class ctype, int dim>
+void checkStoredRule(Dune::GeometryType type, int order, Dune::QuadratureType::Enum qt)
+{
+  const auto& quad = Dune::QuadratureRules<ctype,dim>::rule(type, order, qt);
+
+  // a second mapping of the file behaves like another process
+  Dune::QuadratureRuleFileCache other(filename);
+  int storedOrder;
+  std::vector<unsigned char> data;
+  if (!other.load(key<ctype,dim>(type, order, qt), storedOrder, data))
+  {
+    std::cerr << "Error: Quadrature for " << type << " and order=" << order << " has not been stored" << std::endl;
+    success = false;
+    return;
+  }
+
+  bool match = (storedOrder == quad.order() && data.size() == quad.size()*(dim+1)*sizeof(ctype));
+  for (std::size_t q=0; match && q<quad.size(); ++q)
+  {
+    const unsigned char* point = data.data() + q*(dim+1)*sizeof(ctype);
+    for (int i=0; i<dim; ++i)
+      match = match && std::memcmp(point + i*sizeof(ctype), &quad[q].position()[i], sizeof(ctype)) == 0;
+    match = match && std::memcmp(point + dim*sizeof(ctype), &quad[q].weight(), sizeof(ctype)) == 0;
+  }
+  if (!match)
+  {
+    std::cerr << "Error: Stored quadrature for " << type << " and order=" << order << " differs from the rule" << std::endl;
+    success = false;
+  }
+}
+
+int main ()
+{
+  try {
+    // a file that is no cache file does not make QuadratureRules fail
+    {
+      std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+      file << "no quadrature cache file";
+    }
+    ::setenv("DUNE_QUADRATURE_CACHE", filename, 1);
+    if (Dune::QuadratureRules<double,2>::rule(Dune::GeometryTypes::quadrilateral, 5).order() < 5
+        || Dune::QuadratureRuleFileCache::global())
+    {
+      std::cerr << "Error: Invalid quadrature cache file given by DUNE_QUADRATURE_CACHE is used" << std::endl;
+      success = false;
+    }
+
+    std::remove(filename);
+    Dune::QuadratureRuleFileCache::enable(filename);
+    const auto cache = Dune::QuadratureRuleFileCache::global();
+
+    checkStoredRule<double,3>(Dune::GeometryTypes::prism, 8, Dune::QuadratureType::GaussLobatto);
+    checkStoredRule<double,2>(Dune::GeometryTypes::triangle, 17, Dune::QuadratureType::GaussLegendre);
+    checkStoredRule<float,1>(Dune::GeometryTypes::line, 5, Dune::QuadratureType::GaussRadauLeft);
+
+    // the 1d and 2d rules the product rules are built from are stored as well
+    const std::size_t numRules = cache->size();
+    if (numRules < 3)
+    {
+      std::cerr << "Error: Quadrature cache contains only " << numRules << " rules" << std::endl;
+      success = false;
+    }
+
+    // a rule appended by another process is found, duplicates are not appended
+    const auto otherKey = key<double,2>(Dune::GeometryTypes::quadrilateral, 3, Dune::QuadratureType::GaussLegendre);
+    const std::vector<unsigned char> otherData(4*3*sizeof(double), 1);
+    {
+      Dune::QuadratureRuleFileCache other(filename);
+      other.store(otherKey, 3, otherData);
+      other.store(otherKey, 3, otherData);
+    }
+    int order;
+    std::vector<unsigned char> data;
+    if (!cache->load(otherKey, order, data) || order != 3 || data != otherData || cache->size() != numRules+1)
+    {
+      std::cerr << "Error: Rule appended by another process is not found" << std::endl;
+      success = false;
+    }
+
+    // the incomplete record of a crashed process is replaced by the next rule
+    {
+      std::ofstream file(filename, std::ios::binary | std::ios::app);
+      file << "incomplete record";
+    }
+    checkStoredRule<double,1>(Dune::GeometryTypes::line, 4, Dune::QuadratureType::GaussLobatto);
+    if (Dune::QuadratureRuleFileCache(filename).size() != cache->size() || cache->size() != numRules+2)
+    {
+      std::cerr << "Error: Incomplete record in the quadrature cache is not replaced" << std::endl;
+      success = false;
+    }
+
+    Dune::QuadratureRuleFileCache::disable();
+    if (Dune::QuadratureRuleFileCache::global())
+    {
+      std::cerr << "Error: Quadrature cache is not disabled" << std::endl;
+      success = false;
+    }
+
+    // files in another format are refused
+    {
+      std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+      file << "no quadrature cache file";
+    }
+    try {
+      Dune::QuadratureRuleFileCache invalid(filename);
+      std::cerr << "Error: Invalid quadrature cache file has been opened" << std::endl;
+      success = false;
+    }
+    catch (const Dune::IOError&) {}
+
+    // files of an older format version are replaced by an empty cache
+    {
+      Dune::QuadratureRuleFileCache current(filename + std::string(".current"));
+      std::ifstream in(filename + std::string(".current"), std::ios::binary);
+      std::vector<char> header(32);
+      in.read(header.data(), header.size());
+      std::uint32_t version = Dune::QuadratureRuleFileCache::formatVersion - 1;
+      std::memcpy(header.data() + 8, &version, sizeof(version));
+      std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+      file.write(header.data(), header.size());
+      file << "record of the old format";
+    }
+    std::remove((filename + std::string(".current")).c_str());
+    {
+      Dune::QuadratureRuleFileCache replaced(filename);
+      replaced.store(otherKey, 3, otherData);
+      if (replaced.size() != 1 || Dune::QuadratureRuleFileCache(filename).size() != 1)
+      {
+        std::cerr << "Error: Quadrature cache file of an older format version is not replaced" << std::endl;
+        success = false;
+      }
+    }
+    std::remove(filename);
+  }
+  catch (const Dune::Exception& e) {
+    std::cerr << e << std::endl;
+    return 1;
+  }
+
+  return success ? 0 : 1;
+}
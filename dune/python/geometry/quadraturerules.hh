@@ -48,6 +48,28 @@ namespace Dune
     auto quadratureToNumpy(pybind11::object self)
     {
       const Rule &rule = pybind11::cast< const Rule & >( self );
+
+      // cached rules have a structure-of-arrays side copy which is handed out directly
+      typedef Dune::QuadratureRules< typename Rule::CoordType, Rule::d > Rules;
+      if( const auto *arrays = Rules::soa( rule ) )
+      {
+        // the coordinate arrays precede the weights, all with the same stride
+        const auto stride = static_cast< ssize_t >( arrays->paddedSize() * sizeof( double ) );
+        pybind11::array_t< double > p(
+            { static_cast< ssize_t >( Rule::d ), static_cast< ssize_t >( rule.size() ) },
+            { stride, static_cast< ssize_t >( sizeof( double ) ) },
+            arrays->weights() - Rule::d * arrays->paddedSize(),
+            self
+          );
+        pybind11::array_t< double > w(
+            { static_cast< ssize_t >( rule.size() ) },
+            { static_cast< ssize_t >( sizeof( double ) ) },
+            arrays->weights(),
+            self
+          );
+        return std::make_pair( p, w );
+      }
+
       pybind11::array_t< double > p(
           { static_cast< ssize_t >( Rule::d ), static_cast< ssize_t >( rule.size() ) },
           {
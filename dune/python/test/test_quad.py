@@ -40,6 +40,8 @@ for order in [3,4]:
         for q in rules(t):
             value1 += p(q.position)*q.weight
         hatxs, hatws = rules(t).get()
+        # cached rules hand out their contiguous structure-of-arrays copy
+        assert hatws.flags['C_CONTIGUOUS'] and hatxs.strides[-1] == hatxs.itemsize
         value2 = numpy.sum(p(hatxs) * hatws, axis=-1)
         # print(order,t,value2)
         assert abs(value1-value2)<1e-14